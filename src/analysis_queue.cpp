@@ -0,0 +1,485 @@
+// ============================================================================
+// analysis_queue.cpp - Background analysis worker implementation
+// ============================================================================
+#include "analysis_queue.h"
+#include "perceptual_hash.h"
+
+AnalysisQueue::AnalysisQueue(CameraModule* cam, WiFiModule* wf, BackendClient* client)
+  : camera(cam), wifi(wf), backend(client), motion(cam), jobQueue(nullptr), jobsLock(nullptr),
+    workerHandle(nullptr), nextJobId(1), latestStartedAt(0), latestCompletedAt(0), latestSequence(0), drainedDetections(0),
+    flights(0), sharedResults(0), attachedJobs(0) {
+  runLock = xSemaphoreCreateMutex();
+  flightLock = xSemaphoreCreateMutex();
+  latestLock = xSemaphoreCreateMutex();
+}
+
+bool AnalysisQueue::begin() {
+  // A profile set through /api/camera/config stays put across reboots
+  syncQualityController();
+  
+  const char* help = "Analysis requests by how they were satisfied";
+  analyzedCount = metrics.counter("honeybadger_analysis_requests_total", help, "outcome=\"analyzed\"");
+  sharedCount = metrics.counter("honeybadger_analysis_requests_total", help, "outcome=\"shared\"");
+  attachedCount = metrics.counter("honeybadger_analysis_requests_total", help, "outcome=\"attached\"");
+  
+  // Frames survive a backend outage on flash; the worker drains them later
+  if (!spool.begin()) {
+    Serial.println("WARNING: Frame spool unavailable - frames are dropped while offline");
+  }
+  
+  jobQueue = xQueueCreate(SystemConfig::ANALYSIS_QUEUE_DEPTH, sizeof(uint32_t));
+  jobsLock = xSemaphoreCreateMutex();
+  if (!jobQueue || !jobsLock) {
+    Serial.println("Analysis queue allocation failed");
+    return false;
+  }
+  
+  // Core 0 alongside the WiFi stack; loop() keeps core 1 to itself
+  BaseType_t created = xTaskCreatePinnedToCore(workerTask, "analysis", SystemConfig::ANALYSIS_TASK_STACK,
+                                               this, SystemConfig::ANALYSIS_TASK_PRIORITY, &workerHandle, 0);
+  if (created != pdPASS) {
+    workerHandle = nullptr;
+    Serial.println("Analysis worker task creation failed");
+    return false;
+  }
+  
+  Serial.printf("Analysis worker started (queue depth %d)\n", SystemConfig::ANALYSIS_QUEUE_DEPTH);
+  
+  if (MotionConfig::ENABLED && !motion.begin(onMotion, this)) {
+    Serial.println("WARNING: Motion monitor unavailable - every analysis uploads");
+  }
+  return true;
+}
+
+void AnalysisQueue::onMotion(void* context) {
+  bool attached = false;
+  if (static_cast<AnalysisQueue*>(context)->submit(attached, TRIGGER_MOTION) == 0) {
+    Serial.println("Motion analysis dropped: queue full");
+  }
+}
+
+uint32_t AnalysisQueue::submit(bool& attached, CaptureTrigger trigger) {
+  attached = false;
+  if (!isRunning()) return 0;
+  
+  xSemaphoreTake(jobsLock, portMAX_DELAY);
+  
+  // Join a job that hasn't started yet: its capture will still be newer
+  // than this request. A running one may already have its frame.
+  AnalysisJob* waiting = nullptr;
+  for (int i = 0; i < SystemConfig::ANALYSIS_RESULT_SLOTS && !waiting; i++) {
+    if (jobs[i].state == JOB_QUEUED) {
+      waiting = &jobs[i];
+    }
+  }
+  if (waiting) {
+    // The job may share a GET /api/analyze flight that is already running;
+    // only one that started after this request will do now
+    waiting->lastAttachedAt = millis();
+    uint32_t id = waiting->id;
+    xSemaphoreGive(jobsLock);
+    attached = true;
+    attachedJobs++;
+    attachedCount.inc();
+    return id;
+  }
+  
+  uint32_t id = nextJobId;
+  AnalysisJob& job = jobs[id % SystemConfig::ANALYSIS_RESULT_SLOTS];
+  
+  // Never overwrite a slot whose job hasn't finished yet
+  if (job.state == JOB_QUEUED || job.state == JOB_RUNNING ||
+      xQueueSend(jobQueue, &id, 0) != pdTRUE) {
+    xSemaphoreGive(jobsLock);
+    return 0;
+  }
+  
+  job = AnalysisJob();
+  job.id = id;
+  job.state = JOB_QUEUED;
+  job.trigger = trigger;
+  job.submittedAt = millis();
+  job.lastAttachedAt = job.submittedAt;
+  
+  nextJobId++;
+  if (nextJobId == 0) nextJobId = 1;  // 0 is reserved for "queue full"
+  
+  xSemaphoreGive(jobsLock);
+  return id;
+}
+
+bool AnalysisQueue::getJob(uint32_t id, AnalysisJob& out) {
+  if (id == 0 || !jobsLock) return false;
+  
+  xSemaphoreTake(jobsLock, portMAX_DELAY);
+  const AnalysisJob& job = jobs[id % SystemConfig::ANALYSIS_RESULT_SLOTS];
+  bool found = (job.id == id && job.state != JOB_EMPTY);
+  if (found) {
+    out = job;
+  }
+  xSemaphoreGive(jobsLock);
+  
+  return found;
+}
+
+int AnalysisQueue::getPendingCount() {
+  return jobQueue ? (int)uxQueueMessagesWaiting(jobQueue) : 0;
+}
+
+AnalysisResult AnalysisQueue::runAnalysis(CaptureTrigger trigger, unsigned long arrivedAt) {
+  // Waits out any analysis already running - whose result is then ours
+  xSemaphoreTake(flightLock, portMAX_DELAY);
+  
+  AnalysisResult result;
+  bool shared = takeRecentResult(arrivedAt, result);
+  if (!shared) {
+    unsigned long startedAt = millis();
+    result = analyze(trigger);
+    
+    // A motion-gated result repeats the latest verdict; it isn't a new one
+    if (!result.motionGated) {
+      xSemaphoreTake(latestLock, portMAX_DELAY);
+      latestResult = result;
+      latestStartedAt = startedAt;
+      latestCompletedAt = millis();
+      latestSequence++;
+      xSemaphoreGive(latestLock);
+    }
+  }
+  
+  xSemaphoreGive(flightLock);
+  
+  if (shared) {
+    result.shared = true;
+    sharedResults++;
+    sharedCount.inc();
+  } else {
+    flights++;
+    analyzedCount.inc();
+  }
+  return result;
+}
+
+bool AnalysisQueue::takeRecentResult(unsigned long arrivedAt, AnalysisResult& out) {
+  xSemaphoreTake(latestLock, portMAX_DELAY);
+  
+  // A drained verdict describes a frame from the outage, not the scene now
+  bool usable = false;
+  if (latestSequence != 0 && latestResult.spoolSequence == 0) {
+    // Started after the caller arrived: the follow-up flight another waiter
+    // ran. One already running when the caller arrived may predate it.
+    bool startedSince = (long)(latestStartedAt - arrivedAt) >= 0;
+    // Finished just before: reuse only a good verdict, so failures retry
+    bool recent = arrivedAt - latestCompletedAt <= (unsigned long)SystemConfig::ANALYSIS_MIN_INTERVAL_MS &&
+                  latestResult.success;
+    usable = startedSince || recent;
+  }
+  if (usable) {
+    out = latestResult;
+  }
+  
+  xSemaphoreGive(latestLock);
+  return usable;
+}
+
+bool AnalysisQueue::takeStandingVerdict(AnalysisResult& out) {
+  xSemaphoreTake(latestLock, portMAX_DELAY);
+  
+  // Only a live backend verdict whose capture began after the last motion
+  // still describes the scene; with none, the caller uploads as usual
+  unsigned long now = millis();
+  bool standing = latestSequence != 0 && latestResult.success && latestResult.spoolSequence == 0 &&
+                  (!motion.hasSeenMotion() || now - latestStartedAt < motion.getLastMotionAge());
+  if (standing) {
+    out = latestResult;
+    out.motionGated = true;
+    out.verdictAgeMs = now - latestCompletedAt;
+    out.cached = false;
+    out.shared = false;
+    out.processingTime = 0;
+    out.httpDuration = 0;
+    out.uploadBytes = 0;
+  }
+  
+  xSemaphoreGive(latestLock);
+  return standing;
+}
+
+bool AnalysisQueue::getLatestResult(uint32_t& sequence, AnalysisResult& out) {
+  xSemaphoreTake(latestLock, portMAX_DELAY);
+  bool newer = latestSequence != sequence;
+  if (newer) {
+    out = latestResult;
+    sequence = latestSequence;
+  }
+  xSemaphoreGive(latestLock);
+  
+  return newer;
+}
+
+AnalysisResult AnalysisQueue::analyze(CaptureTrigger trigger) {
+  AnalysisResult result;
+  
+  if (!camera->isInitialized()) {
+    result.error = "Camera not initialized";
+    result.debug = "Camera initialization failed during startup";
+    return result;
+  }
+  
+  bool online = wifi->isConnected() && backend->isAvailable();
+  if (!online && !spool.isReady()) {
+    result.error = "WiFi not connected";
+    result.debug = "WiFi connection lost or never established";
+    if (wifi->isConnected()) {
+      result.error = "Backend unavailable (circuit open)";
+      result.debug = "Backend failing - waiting for the circuit breaker to close";
+    }
+    return result;
+  }
+  
+  // Nothing has moved: the scene the backend last judged hasn't changed,
+  // so hand back that verdict (marked as such) rather than upload again
+  if (MotionConfig::GATE_UPLOADS && motion.isRunning() && trigger != TRIGGER_MOTION &&
+      !motion.motionWithin(MotionConfig::HOLD_MS) && takeStandingVerdict(result)) {
+    motion.recordUpload(false);
+    result.debug = "No motion in the last " + String(MotionConfig::HOLD_MS) + "ms - repeating the verdict from " +
+                   String(result.verdictAgeMs) + "ms ago";
+    return result;
+  }
+  if (motion.isRunning()) {
+    motion.recordUpload(true);
+  }
+  
+  // Serialize the legacy blocking path with the worker
+  xSemaphoreTake(runLock, portMAX_DELAY);
+  
+  camera_fb_t* fb = camera->captureImage();
+  if (!fb) {
+    xSemaphoreGive(runLock);
+    result.error = "Camera capture failed";
+    result.debug = "Frame buffer allocation failed - possible memory issue";
+    return result;
+  }
+  
+  // A near-identical recent frame already has a verdict
+  unsigned long hashStart = millis();
+  uint64_t hash = 0;
+  bool hashed = cache.isEnabled() && PerceptualHash::compute(fb, hash);
+  if (cache.isEnabled() && !hashed) {
+    cache.recordHashFailure();
+  }
+  
+  int distance = 0;
+  if (hashed && cache.lookup(hash, millis(), fb->len, result, distance)) {
+    camera->releaseFrameBuffer(fb);
+    xSemaphoreGive(runLock);
+    
+    result.cached = true;
+    result.processingTime = millis() - hashStart;
+    result.httpDuration = 0;
+    result.uploadBytes = 0;
+    result.debug = "Cache hit: dHash distance " + String(distance) + " from a verdict " +
+                   "reused within " + String(CacheConfig::TTL_MS) + "ms";
+    return result;
+  }
+  
+  if (online) {
+    result = backend->analyzeImage(fb);
+    if (hashed) {
+      cache.store(hash, result, millis());
+    }
+  } else {
+    result.error = "Backend unreachable";
+    result.debug = wifi->isConnected() ? "Circuit breaker open" : "WiFi not connected";
+  }
+  
+  // Keep the frame for the drainer rather than losing it
+  if (!result.success && (!online || isLinkFailure(result)) &&
+      spool.append(fb, trigger, wifi->isConnected() ? WiFi.RSSI() : 0)) {
+    result.spooled = true;
+    result.error = "Backend unreachable - frame spooled for later upload";
+    result.debug += "; Spooled (" + String(spool.getPendingFrames()) + " pending)";
+  }
+  camera->releaseFrameBuffer(fb);
+  
+  if (online) {
+    adaptQuality(result);
+  }
+  xSemaphoreGive(runLock);
+  return result;
+}
+
+void AnalysisQueue::syncQualityController() {
+  // The worker reads and steps the controller under runLock
+  xSemaphoreTake(runLock, portMAX_DELAY);
+  
+  bool on = AdaptiveConfig::ENABLED && camera->isAdaptiveQuality();
+  bool enabling = on && !quality.isEnabled();
+  quality.setEnabled(on);
+  
+  const QualityProfile* profile = &quality.getProfile();
+  bool mismatch = profile->frameSize != camera->getFrameSize() || profile->jpegQuality != camera->getJpegQuality();
+  if (on && (enabling || mismatch)) {
+    quality.reset(camera->getFrameSize(), camera->getJpegQuality());
+    profile = &quality.getProfile();
+    if (profile->frameSize != camera->getFrameSize() || profile->jpegQuality != camera->getJpegQuality()) {
+      camera->applyProfile(profile->frameSize, profile->jpegQuality);
+    }
+    Serial.printf("Adaptive quality: starting at %s\n", profile->name);
+  }
+  
+  xSemaphoreGive(runLock);
+}
+
+void AnalysisQueue::adaptQuality(const AnalysisResult& result) {
+  // Timeouts and mid-transfer drops mean the link can't carry this profile
+  bool linkFailed = (result.httpCode == HTTPC_ERROR_READ_TIMEOUT ||
+                     result.httpCode == HTTPC_ERROR_SEND_PAYLOAD_FAILED ||
+                     result.httpCode == HTTPC_ERROR_CONNECTION_LOST);
+  if (!result.success && !linkFailed) return;
+  
+  if (quality.update(result.httpDuration, result.uploadBytes, WiFi.RSSI(), linkFailed, millis())) {
+    const QualityProfile& profile = quality.getProfile();
+    Serial.printf("Adaptive quality: %s -> %s\n", quality.getLastDecision(), profile.name);
+    camera->applyProfile(profile.frameSize, profile.jpegQuality);
+  }
+}
+
+bool AnalysisQueue::isLinkFailure(const AnalysisResult& result) const {
+  // Transport errors, fast-fails (httpCode 0) and 5xx never reached a
+  // working backend; a 4xx did and won't improve on retry
+  return result.httpCode <= 0 || result.httpCode >= 500;
+}
+
+void AnalysisQueue::drainSpool() {
+  if (!spool.hasPending() || !wifi->isConnected() || !backend->isAvailable()) return;
+  
+  xSemaphoreTake(runLock, portMAX_DELAY);
+  
+  int uploaded = 0;
+  SpoolFrame frame;
+  while (uploaded < SpoolConfig::DRAIN_BATCH && spool.peek(frame)) {
+    AnalysisResult result = backend->analyzeImage(&frame.fb);
+    spool.release(frame);
+    
+    // Still down: leave the frame at the head and wait for the next tick
+    if (isLinkFailure(result)) {
+      Serial.printf("Spool drain stopped: %s\n", result.error.c_str());
+      break;
+    }
+    
+    // Delivered (or rejected for good)
+    spool.consume(frame);
+    uploaded++;
+    Serial.printf("Spooled frame #%u uploaded: %s\n", frame.header.sequence,
+                  result.success ? (result.isHoneyBadger ? "HONEY BADGER" : "clear") : result.error.c_str());
+    
+    if (result.success) {
+      result.spoolSequence = frame.header.sequence;
+      result.captureUnix = frame.header.unixTime;
+      result.captureUptimeMs = frame.header.uptimeMs;
+      publishDrained(result);
+      
+      // /events samples the latest verdict; let a detection be seen before
+      // the rest of the batch overwrites it
+      if (result.isHoneyBadger) break;
+    }
+    
+    // Live requests take priority over the backlog
+    if (uxQueueMessagesWaiting(jobQueue) > 0) break;
+  }
+  
+  xSemaphoreGive(runLock);
+  
+  if (uploaded > 0) {
+    Serial.printf("Spool drain: %d uploaded, %u remaining\n", uploaded, spool.getPendingFrames());
+  }
+}
+
+void AnalysisQueue::publishDrained(const AnalysisResult& result) {
+  xSemaphoreTake(latestLock, portMAX_DELAY);
+  latestResult = result;
+  latestStartedAt = millis();
+  latestCompletedAt = latestStartedAt;
+  latestSequence++;
+  if (result.isHoneyBadger) {
+    lastDrainedDetection = result;
+    drainedDetections++;
+  }
+  xSemaphoreGive(latestLock);
+}
+
+bool AnalysisQueue::getLastDrainedDetection(AnalysisResult& out, uint32_t& count) {
+  xSemaphoreTake(latestLock, portMAX_DELAY);
+  count = drainedDetections;
+  if (count > 0) {
+    out = lastDrainedDetection;
+  }
+  xSemaphoreGive(latestLock);
+  
+  return count > 0;
+}
+
+const char* AnalysisQueue::stateName(AnalysisJobState state) {
+  switch (state) {
+    case JOB_QUEUED:  return "queued";
+    case JOB_RUNNING: return "running";
+    case JOB_DONE:    return "done";
+    default:          return "unknown";
+  }
+}
+
+void AnalysisQueue::workerTask(void* param) {
+  static_cast<AnalysisQueue*>(param)->workerLoop();
+}
+
+void AnalysisQueue::workerLoop() {
+  uint32_t jobId;
+  
+  while (true) {
+    if (xQueueReceive(jobQueue, &jobId, pdMS_TO_TICKS(BreakerConfig::PROBE_POLL_MS)) != pdTRUE) {
+      // Idle: use the time to probe a tripped backend off the request path,
+      // then work through any frames spooled while it was down
+      if (wifi->isConnected() && !backend->probeIfDue()) {
+        drainSpool();
+      }
+      continue;
+    }
+    
+    AnalysisJob job;
+    bool known = startJob(jobId, job);
+    unsigned long arrivedAt = known ? job.lastAttachedAt : millis();
+    CaptureTrigger trigger = known ? job.trigger : TRIGGER_HTTP_JOB;
+    Serial.printf("Analysis job %u started\n", jobId);
+    
+    AnalysisResult result = runAnalysis(trigger, arrivedAt);
+    completeJob(jobId, result);
+    
+    Serial.printf("Analysis job %u finished: %s\n", jobId, result.success ? "success" : result.error.c_str());
+  }
+}
+
+// Marks the job running and copies it in one step, so no submit can
+// attach between reading its arrival time and the job leaving the queue
+bool AnalysisQueue::startJob(uint32_t id, AnalysisJob& out) {
+  xSemaphoreTake(jobsLock, portMAX_DELAY);
+  AnalysisJob& job = jobs[id % SystemConfig::ANALYSIS_RESULT_SLOTS];
+  bool found = job.id == id && job.state != JOB_EMPTY;
+  if (found) {
+    job.state = JOB_RUNNING;
+    out = job;
+  }
+  xSemaphoreGive(jobsLock);
+  return found;
+}
+
+void AnalysisQueue::completeJob(uint32_t id, const AnalysisResult& result) {
+  xSemaphoreTake(jobsLock, portMAX_DELAY);
+  AnalysisJob& job = jobs[id % SystemConfig::ANALYSIS_RESULT_SLOTS];
+  if (job.id == id) {
+    job.result = result;
+    job.state = JOB_DONE;
+    job.completedAt = millis();
+  }
+  xSemaphoreGive(jobsLock);
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+// ============================================================================
+// analysis_queue.h - Background analysis worker and job queue
+// ============================================================================
+#ifndef ANALYSIS_QUEUE_H
+#define ANALYSIS_QUEUE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "camera_module.h"
+#include "wifi_module.h"
+#include "backend_client.h"
+#include "quality_controller.h"
+#include "frame_spool.h"
+#include "result_cache.h"
+#include "motion_monitor.h"
+#include "metrics.h"
+#include "config.h"
+
+enum AnalysisJobState {
+  JOB_EMPTY,
+  JOB_QUEUED,
+  JOB_RUNNING,
+  JOB_DONE
+};
+
+struct AnalysisJob {
+  uint32_t id;
+  AnalysisJobState state;
+  CaptureTrigger trigger;
+  unsigned long submittedAt;
+  unsigned long lastAttachedAt;   // Newest submit sharing the job; its capture starts after this
+  unsigned long completedAt;
+  AnalysisResult result;
+  
+  AnalysisJob() : id(0), state(JOB_EMPTY), trigger(TRIGGER_HTTP_JOB), submittedAt(0), lastAttachedAt(0),
+                  completedAt(0) {}
+};
+
+// Runs capture + backend upload on a dedicated FreeRTOS task so the web
+// server loop never waits on the network. Finished jobs are kept in a
+// small ring of result slots until newer jobs overwrite them.
+class AnalysisQueue {
+private:
+  CameraModule* camera;
+  WiFiModule* wifi;
+  BackendClient* backend;
+  QualityController quality;
+  FrameSpool spool;
+  ResultCache cache;
+  MotionMonitor motion;
+  
+  QueueHandle_t jobQueue;
+  SemaphoreHandle_t runLock;     // One capture + upload at a time
+  SemaphoreHandle_t jobsLock;
+  TaskHandle_t workerHandle;
+  AnalysisJob jobs[SystemConfig::ANALYSIS_RESULT_SLOTS];
+  uint32_t nextJobId;
+  
+  // Single flight: one analysis at a time. Callers that arrive while one
+  // runs wait for it, then share a single follow-up flight, so every
+  // verdict handed out is for a frame captured after the caller asked.
+  SemaphoreHandle_t flightLock;
+  
+  // Most recent verdict from either path, shared with waiting callers and
+  // read by the /events push channel. Verdicts for drained spool frames
+  // go here too (with spoolSequence set) but are never shared.
+  SemaphoreHandle_t latestLock;
+  AnalysisResult latestResult;
+  unsigned long latestStartedAt;
+  unsigned long latestCompletedAt;
+  uint32_t latestSequence;
+  AnalysisResult lastDrainedDetection;
+  uint32_t drainedDetections;
+  
+  uint32_t flights;
+  uint32_t sharedResults;
+  uint32_t attachedJobs;
+  Counter analyzedCount;
+  Counter sharedCount;
+  Counter attachedCount;
+  
+  static void workerTask(void* param);
+  void workerLoop();
+  bool startJob(uint32_t id, AnalysisJob& out);
+  void completeJob(uint32_t id, const AnalysisResult& result);
+  AnalysisResult analyze(CaptureTrigger trigger);
+  bool takeRecentResult(unsigned long arrivedAt, AnalysisResult& out);
+  bool takeStandingVerdict(AnalysisResult& out);
+  void adaptQuality(const AnalysisResult& result);
+  bool isLinkFailure(const AnalysisResult& result) const;
+  void drainSpool();
+  void publishDrained(const AnalysisResult& result);
+  static void onMotion(void* context);
+  
+public:
+  AnalysisQueue(CameraModule* cam, WiFiModule* wf, BackendClient* client);
+  
+  bool begin();
+  bool isRunning() const { return workerHandle != nullptr; }
+  
+  // Returns the new job id, or 0 if the queue is full. While a job is
+  // queued and not yet started, that job's id is returned and attached is
+  // set. A job already running captured before this call, so a new one is
+  // queued behind it instead; later calls then attach to that one.
+  uint32_t submit(bool& attached, CaptureTrigger trigger = TRIGGER_HTTP_JOB);
+  
+  // Copies the job into out. Returns false if the id is unknown or expired.
+  bool getJob(uint32_t id, AnalysisJob& out);
+  
+  // Capture and analyze on the calling task. While the backend is
+  // unreachable the frame is spooled instead and result.spooled is set.
+  // If another analysis started after arrivedAt, or a successful one
+  // finished less than ANALYSIS_MIN_INTERVAL_MS before it, that result is
+  // returned with result.shared set and nothing is captured.
+  AnalysisResult runAnalysis(CaptureTrigger trigger, unsigned long arrivedAt);
+  
+  // Copies the most recent result if it is newer than sequence, which is
+  // then advanced. Returns false when there is nothing new.
+  bool getLatestResult(uint32_t& sequence, AnalysisResult& out);
+  
+  // Honey badgers found in frames drained from the spool; out gets the
+  // most recent one. Returns false if there hasn't been one.
+  bool getLastDrainedDetection(AnalysisResult& out, uint32_t& count);
+  
+  // Follows the camera's adaptive flag and, while adaptive, starts the
+  // controller from the profile the sensor actually has (then applies the
+  // controller's step, so the two agree). Call after boot-time settings
+  // load and after /api/camera/config changes them. Waits out a running
+  // analysis, so never call it from the HTTP server task.
+  void syncQualityController();
+  
+  int getPendingCount();
+  uint32_t getFlights() const { return flights; }
+  uint32_t getSharedResults() const { return sharedResults; }
+  uint32_t getAttachedJobs() const { return attachedJobs; }
+  QualityController& getQualityController() { return quality; }
+  FrameSpool& getSpool() { return spool; }
+  ResultCache& getResultCache() { return cache; }
+  MotionMonitor& getMotionMonitor() { return motion; }
+  static const char* stateName(AnalysisJobState state);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,35 @@
+// ============================================================================
+// analysis_result.h - Outcome of one backend analysis
+// ============================================================================
+#ifndef ANALYSIS_RESULT_H
+#define ANALYSIS_RESULT_H
+
+#include <Arduino.h>
+
+struct AnalysisResult {
+  bool success;
+  bool isHoneyBadger;
+  float confidence;
+  String error;
+  String debug;
+  String serverResponse;
+  unsigned long processingTime;
+  unsigned long httpDuration;
+  int httpCode;
+  size_t uploadBytes;
+  bool spooled;             // Frame kept in the spool for a later upload
+  bool cached;              // Verdict reused from a near-identical recent frame
+  bool shared;              // Result of an analysis another request started (single flight)
+  bool motionGated;         // Nothing moved since the last verdict, which is repeated here
+  unsigned long verdictAgeMs; // motionGated: how long ago that verdict was made
+  uint32_t spoolSequence;   // Non-zero: verdict for a frame drained from the spool
+  uint32_t captureUnix;     // That frame's capture time, 0 if the clock wasn't set
+  uint32_t captureUptimeMs; // millis() at capture, in the boot that spooled it
+  
+  // Constructor for easy initialization
+  AnalysisResult() : success(false), isHoneyBadger(false), confidence(0.0), 
+                    processingTime(0), httpDuration(0), httpCode(0), uploadBytes(0), spooled(false), cached(false),
+                    shared(false), motionGated(false), verdictAgeMs(0), spoolSequence(0), captureUnix(0), captureUptimeMs(0) {}
+};
+
+#endif
\ No newline at end of file
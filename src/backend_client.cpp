@@ -3,16 +3,92 @@
 // ============================================================================
 #include "backend_client.h"
 #include <WiFi.h>
+#include "multipart_stream.h"
+#include "chunked_jpeg_stream.h"
+#include "verdict_parser.h"
+#include "compact_protocol.h"
 
-BackendClient::BackendClient() {
-  // Constructor - initialization happens per request
+BackendClient::BackendClient()
+  : protocol(ProtocolConfig::USE_COMPACT ? PROTOCOL_COMPACT : PROTOCOL_MULTIPART), compactSequence(0) {
+  // The TLS connection is opened lazily on first request
+  requestLock = xSemaphoreCreateMutex();
+  
+  uploadSize = metrics.histogram("honeybadger_upload_bytes", "Request body bytes per analysis upload",
+                                 MetricBuckets::UPLOAD_BYTES, MetricBuckets::UPLOAD_BYTES_COUNT, 1.0f);
+  requestLatency = metrics.histogram("honeybadger_backend_request_duration_seconds",
+                                     "Backend round trip per analysis (httpDuration)",
+                                     MetricBuckets::LATENCY_MS, MetricBuckets::LATENCY_MS_COUNT, 0.001f);
 }
 
 BackendClient::~BackendClient() {
-  // Destructor - cleanup happens per request
+  connection.reset();
 }
 
 AnalysisResult BackendClient::analyzeImage(camera_fb_t* fb) {
+  // Web handlers and the analysis worker share one connection
+  xSemaphoreTake(requestLock, portMAX_DELAY);
+  
+  AnalysisResult result;
+  if (admitRequest(result.error)) {
+    result = analyzeImageLocked(fb);
+    recordOutcome(result.httpCode);
+    if (result.uploadBytes > 0) {
+      uploadSize.observe(result.uploadBytes);
+    }
+    if (result.httpCode > 0) {
+      requestLatency.observe(result.httpDuration);
+    }
+  } else {
+    result.debug = "Fast-fail: backend marked down after repeated failures; retry in " + 
+                   String(breaker.getRetryIn(millis())) + "ms";
+  }
+  
+  xSemaphoreGive(requestLock);
+  return result;
+}
+
+ConnectionTestResult BackendClient::testConnection() {
+  xSemaphoreTake(requestLock, portMAX_DELAY);
+  
+  ConnectionTestResult result;
+  if (breaker.allowRequest(millis())) {
+    result = testConnectionLocked(10000);
+    breaker.recordProbe(result.success, millis());
+  } else {
+    result.testURL = "https://" + String(NetworkConfig::BACKEND_HOST) + ":" + String(NetworkConfig::BACKEND_PORT) + "/";
+    result.wifiSignal = WiFi.RSSI();
+    result.freeHeap = ESP.getFreeHeap();
+    result.error = "Circuit open - retry in " + String(breaker.getRetryIn(millis())) + "ms";
+  }
+  
+  xSemaphoreGive(requestLock);
+  return result;
+}
+
+bool BackendClient::probeIfDue() {
+  if (!breaker.isProbeDue(millis())) return false;
+  
+  // Never queue behind a real request just to probe
+  if (xSemaphoreTake(requestLock, 0) != pdTRUE) return false;
+  
+  bool probed = false;
+  if (breaker.isProbeDue(millis())) {
+    breaker.allowRequest(millis());  // OPEN -> HALF_OPEN
+    ConnectionTestResult probe = testConnectionLocked(BreakerConfig::PROBE_TIMEOUT);
+    breaker.recordProbe(probe.success, millis());
+    Serial.printf("Backend probe: %s (%lu ms)\n", probe.success ? "ok" : probe.error.c_str(), probe.duration);
+    probed = true;
+  }
+  
+  xSemaphoreGive(requestLock);
+  return probed;
+}
+
+bool BackendClient::isAvailable() {
+  return breaker.getState() != BREAKER_OPEN || breaker.getRetryIn(millis()) == 0;
+}
+
+AnalysisResult BackendClient::analyzeImageLocked(camera_fb_t* fb) {
   AnalysisResult result;
   
   if (!fb) {
@@ -23,87 +99,137 @@ AnalysisResult BackendClient::analyzeImage(camera_fb_t* fb) {
   unsigned long startTime = millis();
   result.debug = buildDebugInfo(fb);
   
-  WiFiClientSecure client;
-  client.setInsecure();
-  client.setTimeout(SystemConfig::HTTP_TIMEOUT);
+  // JPEG frames stream straight from the frame buffer (no payload copy),
+  // as multipart or as the compact binary body; anything else is encoded
+  // on the fly and sent chunked
+  bool chunked = (fb->format != PIXFORMAT_JPEG);
+  bool compact = (protocol == PROTOCOL_COMPACT && !chunked);
+  String backendURL = getBackendURL(compact ? ProtocolConfig::COMPACT_ENDPOINT : NetworkConfig::ANALYZE_ENDPOINT);
   
-  HTTPClient http;
-  String backendURL = getBackendURL();
+  String boundary = "----ESP32CAMBoundary" + String(millis());
+  String contentType = compact ? "application/octet-stream" : "multipart/form-data; boundary=" + boundary;
+  MultipartStream body(fb, boundary);
+  ChunkedJpegStream encodedBody(fb, boundary, UploadConfig::JPEG_QUALITY);
+  CompactFrameStream compactBody(fb, compactSequence + 1);
   
-  bool httpBeginResult = http.begin(client, backendURL);
-  if (!httpBeginResult) {
-    result.error = "HTTP client init failed";
-    result.debug += "; HTTP client initialization failed";
-    return result;
+  Stream* payload = &body;
+  size_t totalLength = body.totalLength();
+  if (chunked) {
+    payload = &encodedBody;
+    totalLength = 0;
+  } else if (compact) {
+    payload = &compactBody;
+    totalLength = compactBody.totalLength();
+    compactSequence++;
   }
+  result.uploadBytes = totalLength;
   
-  // Create multipart payload
-  String boundary = "----ESP32CAMBoundary" + String(millis());
-  size_t totalLength;
-  uint8_t* payload = createMultipartPayload(fb, boundary, totalLength);
-  
-  if (!payload) {
-    result.error = "Memory allocation failed";
-    result.debug += "; Could not allocate " + String(totalLength) + " bytes for payload";
-    http.end();
-    client.stop();
+  // Start encoding now so the pipe is already filling during the handshake
+  if (chunked && !encodedBody.begin()) {
+    result.error = "JPEG encoder start failed";
+    result.debug += "; Could not start the encoder task";
     return result;
   }
   
-  // Set headers
-  String contentType = "multipart/form-data; boundary=" + boundary;
-  http.addHeader("Content-Type", contentType);
-  http.addHeader("User-Agent", "ESP32-CAM-HoneyBadger/2.0");
-  http.addHeader("Content-Length", String(totalLength));
-  http.setTimeout(SystemConfig::HTTP_TIMEOUT);
+  HTTPClient* http = beginAnalyzeRequest(backendURL, contentType, totalLength);
+  if (!http) {
+    result.error = "HTTP client init failed";
+    result.debug += "; HTTP client initialization failed";
+    return result;
+  }
   
-  result.debug += "; Sending " + String(totalLength) + " bytes to " + backendURL;
+  if (chunked) {
+    result.debug += "; Streaming chunked JPEG (q" + String(UploadConfig::JPEG_QUALITY) + ") to " + backendURL;
+  } else {
+    result.debug += "; Sending " + String(totalLength) + (compact ? " compact" : "") + " bytes to " + backendURL;
+  }
+  result.debug += connection.wasReused() ? "; Connection: reused" : "; Connection: new";
   
   // Send request
   unsigned long httpStartTime = millis();
-  result.httpCode = http.POST(payload, totalLength);
+  result.httpCode = http->sendRequest("POST", payload, totalLength);
+  
+  // The server may have closed a kept-alive socket; retry once on a fresh one
+  if (result.httpCode < 0 && connection.wasReused()) {
+    result.debug += "; Stale keep-alive socket, reconnecting";
+    connection.reset();
+    connection.markReconnect();
+    if (chunked) {
+      encodedBody.rewind();
+    } else if (compact) {
+      compactBody.rewind();
+    } else {
+      body.rewind();
+    }
+    
+    http = beginAnalyzeRequest(backendURL, contentType, totalLength);
+    if (http) {
+      result.httpCode = http->sendRequest("POST", payload, totalLength);
+    }
+  }
   result.httpDuration = millis() - httpStartTime;
   
-  // Free payload memory
-  free(payload);
+  if (chunked) {
+    encodedBody.end();
+    result.uploadBytes = encodedBody.getJpegBytes();
+    result.debug += "; Encoded " + String(encodedBody.getJpegBytes()) + " JPEG bytes";
+  }
+  
+  if (!http) {
+    result.error = "HTTP client init failed";
+    result.debug += "; HTTP client initialization failed on reconnect";
+    connection.reset();
+    return result;
+  }
   
   result.debug += "; HTTP code: " + String(result.httpCode) + 
                  "; Duration: " + String(result.httpDuration) + "ms";
   
   if (result.httpCode == 200) {
-    String response = http.getString();
-    result.success = true;
-    result.serverResponse = response;
+    // Parse the verdict straight off the socket instead of buffering the body
+    VerdictParser parser(result);
+    CompactVerdictReader reader(result);
+    int bodyResult = http->writeToStream(compact ? (Stream*)&reader : (Stream*)&parser);
+    size_t responseBytes = compact ? reader.getBytesRead() : parser.getBytesParsed();
     
-    // Simple JSON parsing (you might want to use ArduinoJson library for robust parsing)
-    // For now, we'll do basic string parsing
-    if (response.indexOf("\"isHoneyBadger\":true") != -1) {
-      result.isHoneyBadger = true;
-    }
-    
-    // Extract confidence (basic parsing)
-    int confIndex = response.indexOf("\"confidence\":");
-    if (confIndex != -1) {
-      int startIndex = confIndex + 13; // Length of "\"confidence\":"
-      int endIndex = response.indexOf(",", startIndex);
-      if (endIndex == -1) endIndex = response.indexOf("}", startIndex);
-      
-      if (endIndex > startIndex) {
-        String confStr = response.substring(startIndex, endIndex);
-        result.confidence = confStr.toFloat();
+    if (bodyResult < 0) {
+      result.httpCode = bodyResult;
+      result.error = "Response read failed: " + HTTPClient::errorToString(bodyResult);
+      result.debug += "; " + result.error;
+    } else if (chunked && encodedBody.failed()) {
+      result.error = "JPEG encoding failed";
+      result.debug += "; frame2jpg_cb failed - upload was truncated";
+    } else if (compact && !reader.apply()) {
+      result.error = "Malformed compact verdict";
+      result.debug += "; Expected " + String(sizeof(CompactVerdict)) + " byte verdict, got " + String(responseBytes);
+    } else if (!compact && (parser.hasError() || !parser.isComplete() || !parser.hasVerdict())) {
+      // A default isHoneyBadger=false here would be cached and repeated as "clear"
+      result.error = "Malformed verdict";
+      result.debug += String("; ") + (parser.hasError() ? "Invalid JSON" :
+                                      !parser.isComplete() ? "Truncated JSON" : "isHoneyBadger missing") +
+                      " in " + String(responseBytes) + " byte response";
+    } else {
+      result.success = true;
+      if (compact) {
+        result.debug += "; Server time: " + String(reader.getServerTime()) + "ms";
       }
+      result.debug += "; Success! Response length: " + String(responseBytes);
+      
+      ProtocolStats& stat = stats[compact ? PROTOCOL_COMPACT : PROTOCOL_MULTIPART];
+      stat.requests++;
+      stat.uploadBytes += result.uploadBytes;
+      stat.responseBytes += responseBytes;
+      stat.totalLatency += result.httpDuration;
     }
     
-    result.debug += "; Success! Response length: " + String(response.length());
-    
   } else if (result.httpCode > 0) {
-    String errorBody = http.getString();
+    String errorBody = http->getString();
     result.error = "Backend HTTP error";
     result.serverResponse = errorBody;
     result.debug += "; Error body: " + errorBody.substring(0, 100); // First 100 chars
     
   } else {
-    String errorString = http.errorToString(result.httpCode);
+    String errorString = HTTPClient::errorToString(result.httpCode);
     result.error = "Connection failed: " + errorString;
     result.debug += "; " + errorString + "; WiFi status: " + String(WiFi.status()) + 
                    "; Signal: " + String(WiFi.RSSI()) + " dBm";
@@ -112,79 +238,116 @@ AnalysisResult BackendClient::analyzeImage(camera_fb_t* fb) {
   result.processingTime = millis() - startTime;
   result.debug += "; Total time: " + String(result.processingTime) + "ms";
   
-  http.end();
-  client.stop();
+  if (result.httpCode > 0) {
+    connection.release();
+  } else {
+    connection.reset();
+  }
   
   return result;
 }
 
-ConnectionTestResult BackendClient::testConnection() {
+ConnectionTestResult BackendClient::testConnectionLocked(int timeout) {
   ConnectionTestResult result;
   result.testURL = "https://" + String(NetworkConfig::BACKEND_HOST) + ":" + String(NetworkConfig::BACKEND_PORT) + "/";
   result.wifiSignal = WiFi.RSSI();
   result.freeHeap = ESP.getFreeHeap();
   
-  WiFiClientSecure client;
-  client.setInsecure();
-  client.setTimeout(10000);
-  
-  HTTPClient http;
-  bool httpBeginResult = http.begin(client, result.testURL);
-  
-  if (!httpBeginResult) {
+  HTTPClient* http = connection.acquire(result.testURL, timeout);
+  if (!http) {
     result.error = "HTTP client init failed";
     return result;
   }
   
-  http.setTimeout(10000);
   unsigned long startTime = millis();
-  result.responseCode = http.GET();
+  result.responseCode = http->GET();
+  
+  if (result.responseCode < 0 && connection.wasReused()) {
+    connection.reset();
+    connection.markReconnect();
+    http = connection.acquire(result.testURL, timeout);
+    if (http) {
+      result.responseCode = http->GET();
+    }
+  }
   result.duration = millis() - startTime;
   
   if (result.responseCode > 0) {
     result.success = true;
+    // Drain the body so the socket can be reused
+    http->getString();
+    connection.release();
   } else {
-    result.error = http.errorToString(result.responseCode);
+    result.error = HTTPClient::errorToString(result.responseCode);
+    connection.reset();
   }
   
-  http.end();
-  client.stop();
-  
   return result;
 }
 
-String BackendClient::getBackendURL() {
-  return "https://" + String(NetworkConfig::BACKEND_HOST) + NetworkConfig::ANALYZE_ENDPOINT;
+bool BackendClient::admitRequest(String& error) {
+  if (!breaker.allowRequest(millis())) {
+    error = "Backend unavailable (circuit open)";
+    return false;
+  }
+  
+  // Half-open: check with a cheap GET before committing a full upload
+  if (breaker.getState() == BREAKER_HALF_OPEN) {
+    ConnectionTestResult probe = testConnectionLocked(BreakerConfig::PROBE_TIMEOUT);
+    breaker.recordProbe(probe.success, millis());
+    if (!probe.success) {
+      error = "Backend unavailable (probe failed: " + probe.error + ")";
+      return false;
+    }
+  }
+  
+  return true;
 }
 
-String BackendClient::buildDebugInfo(camera_fb_t* fb) {
-  String info = "WiFi Signal: " + String(WiFi.RSSI()) + " dBm";
-  info += "; Free heap before: " + String(ESP.getFreeHeap()) + " bytes";
-  info += "; Image: " + String(fb->width) + "x" + String(fb->height);
-  info += " (" + String(fb->len) + " bytes)";
-  return info;
+void BackendClient::recordOutcome(int httpCode) {
+  // Transport errors and 5xx mean the backend is unhealthy; 4xx is our fault.
+  // Code 0 means we never reached the network.
+  if (httpCode < 0 || httpCode >= 500) {
+    breaker.recordFailure(millis());
+  } else if (httpCode > 0) {
+    breaker.recordSuccess();
+  }
 }
 
-uint8_t* BackendClient::createMultipartPayload(camera_fb_t* fb, const String& boundary, size_t& totalLength) {
-  String bodyStart = "--" + boundary + "\r\n";
-  bodyStart += "Content-Disposition: form-data; name=\"image\"; filename=\"capture.jpg\"\r\n";
-  bodyStart += "Content-Type: image/jpeg\r\n\r\n";
-  
-  String bodyEnd = "\r\n--" + boundary + "--\r\n";
-  
-  totalLength = bodyStart.length() + fb->len + bodyEnd.length();
-  
-  uint8_t* payload = (uint8_t*)malloc(totalLength);
-  if (!payload) {
+String BackendClient::getBackendURL(const char* endpoint) {
+  return "https://" + String(NetworkConfig::BACKEND_HOST) + endpoint;
+}
+
+const char* BackendClient::protocolName(UploadProtocol mode) {
+  switch (mode) {
+    case PROTOCOL_MULTIPART: return "multipart";
+    case PROTOCOL_COMPACT:   return "compact";
+    default:                 return "unknown";
+  }
+}
+
+HTTPClient* BackendClient::beginAnalyzeRequest(const String& url, const String& contentType, size_t totalLength) {
+  HTTPClient* http = connection.acquire(url, SystemConfig::HTTP_TIMEOUT);
+  if (!http) {
     return nullptr;
   }
   
-  size_t offset = 0;
-  memcpy(payload + offset, bodyStart.c_str(), bodyStart.length());
-  offset += bodyStart.length();
-  memcpy(payload + offset, fb->buf, fb->len);
-  offset += fb->len;
-  memcpy(payload + offset, bodyEnd.c_str(), bodyEnd.length());
+  // Set headers
+  http->addHeader("Content-Type", contentType);
+  http->addHeader("User-Agent", "ESP32-CAM-HoneyBadger/2.0");
+  if (totalLength > 0) {
+    http->addHeader("Content-Length", String(totalLength));
+  } else {
+    http->addHeader("Transfer-Encoding", "chunked");
+  }
   
-  return payload;
+  return http;
+}
+
+String BackendClient::buildDebugInfo(camera_fb_t* fb) {
+  String info = "WiFi Signal: " + String(WiFi.RSSI()) + " dBm";
+  info += "; Free heap before: " + String(ESP.getFreeHeap()) + " bytes";
+  info += "; Image: " + String(fb->width) + "x" + String(fb->height);
+  info += " (" + String(fb->len) + " bytes)";
+  return info;
 }
\ No newline at end of file
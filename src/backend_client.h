@@ -7,23 +7,29 @@
 #include <Arduino.h>
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "esp_camera.h"
 #include "config.h"
+#include "analysis_result.h"
+#include "backend_connection.h"
+#include "circuit_breaker.h"
+#include "metrics.h"
 
-struct AnalysisResult {
-  bool success;
-  bool isHoneyBadger;
-  float confidence;
-  String error;
-  String debug;
-  String serverResponse;
-  unsigned long processingTime;
-  unsigned long httpDuration;
-  int httpCode;
-  
-  // Constructor for easy initialization
-  AnalysisResult() : success(false), isHoneyBadger(false), confidence(0.0), 
-                    processingTime(0), httpDuration(0), httpCode(0) {}
+enum UploadProtocol {
+  PROTOCOL_MULTIPART,       // multipart/form-data up, JSON verdict down
+  PROTOCOL_COMPACT,         // Binary header + JPEG up, fixed binary verdict down
+  PROTOCOL_COUNT
+};
+
+// Per-protocol totals for successful analyses, for comparing wire cost
+struct ProtocolStats {
+  unsigned long requests;
+  uint64_t uploadBytes;
+  uint64_t responseBytes;
+  unsigned long totalLatency;
+  
+  ProtocolStats() : requests(0), uploadBytes(0), responseBytes(0), totalLatency(0) {}
 };
 
 struct ConnectionTestResult {
@@ -42,8 +48,22 @@ struct ConnectionTestResult {
 
 class BackendClient {
 private:
+  BackendConnection connection;
+  SemaphoreHandle_t requestLock;   // Serializes callers sharing the connection
+  CircuitBreaker breaker;
+  UploadProtocol protocol;
+  uint32_t compactSequence;
+  ProtocolStats stats[PROTOCOL_COUNT];
+  Histogram uploadSize;
+  Histogram requestLatency;
+  
+  AnalysisResult analyzeImageLocked(camera_fb_t* fb);
+  ConnectionTestResult testConnectionLocked(int timeout);
+  bool admitRequest(String& error);
+  void recordOutcome(int httpCode);
   String buildDebugInfo(camera_fb_t* fb);
-  uint8_t* createMultipartPayload(camera_fb_t* fb, const String& boundary, size_t& totalLength);
+  // totalLength 0 means a chunked body of unknown length
+  HTTPClient* beginAnalyzeRequest(const String& url, const String& contentType, size_t totalLength);
   
 public:
   BackendClient();
@@ -53,8 +73,20 @@ public:
   AnalysisResult analyzeImage(camera_fb_t* fb);
   ConnectionTestResult testConnection();
   
+  // Circuit breaker
+  bool probeIfDue();
+  bool isAvailable();
+  CircuitBreaker& getBreaker() { return breaker; }
+  
+  // Wire format (JPEG frames only; others always go multipart)
+  void setProtocol(UploadProtocol mode) { protocol = mode; }
+  UploadProtocol getProtocol() const { return protocol; }
+  const ProtocolStats& getProtocolStats(UploadProtocol mode) const { return stats[mode]; }
+  static const char* protocolName(UploadProtocol mode);
+  
   // Utility
-  String getBackendURL();
+  String getBackendURL(const char* endpoint = NetworkConfig::ANALYZE_ENDPOINT);
+  BackendConnection& getConnection() { return connection; }
 };
 
 #endif
\ No newline at end of file
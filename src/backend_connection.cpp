@@ -0,0 +1,50 @@
+// ============================================================================
+// backend_connection.cpp - Persistent keep-alive connection implementation
+// ============================================================================
+#include "backend_connection.h"
+
+BackendConnection::BackendConnection()
+  : reused(false), lastUsed(0), handshakeCount(0), reuseCount(0), reconnectCount(0) {
+  client.setInsecure();
+}
+
+BackendConnection::~BackendConnection() {
+  reset();
+}
+
+HTTPClient* BackendConnection::acquire(const String& url, int timeout) {
+  // Servers drop idle keep-alive sockets silently; don't trust an old one
+  if (client.connected() && millis() - lastUsed > (unsigned long)SystemConfig::BACKEND_KEEPALIVE_IDLE) {
+    Serial.println("Backend connection idle too long - closing");
+    client.stop();
+  }
+  
+  reused = client.connected();
+  if (reused) {
+    reuseCount++;
+  } else {
+    handshakeCount++;
+  }
+  
+  client.setTimeout(timeout);
+  http.setReuse(true);
+  
+  if (!http.begin(client, url)) {
+    return nullptr;
+  }
+  
+  http.setTimeout(timeout);
+  return &http;
+}
+
+void BackendConnection::release() {
+  // HTTPClient::end() keeps the socket open when the response allowed reuse
+  http.end();
+  lastUsed = millis();
+}
+
+void BackendConnection::reset() {
+  http.end();
+  client.stop();
+  reused = false;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+// ============================================================================
+// backend_connection.h - Persistent keep-alive connection to the backend
+// ============================================================================
+#ifndef BACKEND_CONNECTION_H
+#define BACKEND_CONNECTION_H
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include "config.h"
+
+// Owns a single TLS socket to BACKEND_HOST and keeps it open between
+// requests (HTTP/1.1 keep-alive), so only the first request after boot or
+// after a drop pays for the TLS handshake.
+class BackendConnection {
+private:
+  WiFiClientSecure client;
+  HTTPClient http;
+  bool reused;
+  unsigned long lastUsed;
+  unsigned long handshakeCount;
+  unsigned long reuseCount;
+  unsigned long reconnectCount;
+  
+public:
+  BackendConnection();
+  ~BackendConnection();
+  
+  // Prepare the shared HTTPClient for a request to url. Reuses the open
+  // socket when possible. Returns nullptr if the client could not be set up.
+  HTTPClient* acquire(const String& url, int timeout);
+  
+  // Finish the request. The socket stays open if the server allowed it.
+  void release();
+  
+  // Drop the socket; the next acquire() performs a fresh handshake.
+  void reset();
+  
+  // Call after a failed request on a reused socket before retrying
+  void markReconnect() { reconnectCount++; }
+  
+  // Status
+  bool isOpen() { return client.connected(); }
+  bool wasReused() const { return reused; }
+  unsigned long getHandshakeCount() const { return handshakeCount; }
+  unsigned long getReuseCount() const { return reuseCount; }
+  unsigned long getReconnectCount() const { return reconnectCount; }
+};
+
+#endif
\ No newline at end of file
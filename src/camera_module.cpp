@@ -3,6 +3,7 @@
 // ============================================================================
 #include "camera_module.h"
 #include "system_utils.h"
+#include "nvs.h"
 
 bool CameraModule::initialize() {
   Serial.println("Initializing camera...");
@@ -26,13 +27,16 @@ bool CameraModule::initialize() {
   config.pin_sccb_scl = CameraPins::SIOC;
   config.pin_pwdn = CameraPins::PWDN;
   config.pin_reset = CameraPins::RESET;
-  config.xclk_freq_hz = CameraConfig::XCLK_FREQ;
+  config.xclk_freq_hz = loadXclkMhz() * 1000000;
   config.pixel_format = CameraConfig::PIXEL_FORMAT;
   
   // Memory-optimized settings for 4MB PSRAM
-  config.frame_size = CameraConfig::FRAME_SIZE;
+  // The JPEG frame buffer is sized from the init frame size, so init at the
+  // largest size we may switch to at runtime and drop down afterwards
+  config.frame_size = CameraConfig::MAX_FRAME_SIZE;
   config.jpeg_quality = CameraConfig::JPEG_QUALITY;
-  config.fb_count = 1;                   // Single frame buffer saves ~40KB RAM
+  // One buffer per request, or a free-running sensor feeding the capture task
+  config.fb_count = CaptureConfig::CONTINUOUS ? CaptureConfig::FB_COUNT : 1;
   config.fb_location = CAMERA_FB_IN_PSRAM;
   config.grab_mode = CAMERA_GRAB_LATEST;
   
@@ -43,7 +47,31 @@ bool CameraModule::initialize() {
     return false;
   }
   
+  mode = ModeConfig::ENABLED ? MODE_WATCH : MODE_CAPTURE;
   optimizeSensorSettings();
+  loadSettings();
+  history.begin();
+  
+  if (CaptureConfig::CONTINUOUS && !pipeline.begin(&history)) {
+    Serial.println("Continuous capture unavailable - capturing per request");
+  }
+  
+  // Same series in both modes, labelled, so the two can be compared
+  const char* label = pipeline.isRunning() ? "mode=\"continuous\"" : "mode=\"on_demand\"";
+  captureLatency = metrics.histogram("honeybadger_capture_duration_seconds",
+                                     "Time a caller waited for a frame",
+                                     MetricBuckets::HANDLER_US, MetricBuckets::HANDLER_US_COUNT, 0.000001f, label);
+  flashOnTime = metrics.histogram("honeybadger_flash_on_seconds", "Flash-on time per lit capture",
+                                  MetricBuckets::HANDLER_US, MetricBuckets::HANDLER_US_COUNT, 0.000001f);
+  captureFailures = metrics.counter("honeybadger_capture_failures_total", "Captures that returned no frame");
+  staleFrames = metrics.counter("honeybadger_capture_stale_frames_total",
+                                "Frames discarded because their exposure began before the flash");
+  framesCaptured = metrics.counter("honeybadger_camera_frames_total", "Frames read out of the sensor", label);
+  switchLatency = metrics.histogram("honeybadger_mode_switch_seconds",
+                                    "Watch-to-capture register change until the first good capture-size frame",
+                                    MetricBuckets::HANDLER_US, MetricBuckets::HANDLER_US_COUNT, 0.000001f);
+  pipeline.countFramesIn(framesCaptured);
+  
   initialized = true;
   Serial.println("Camera initialized successfully");
   SystemUtils::blinkSuccess(1);
@@ -54,7 +82,9 @@ void CameraModule::optimizeSensorSettings() {
   sensor_t* s = esp_camera_sensor_get();
   if (s) {
     // Image quality settings
-    s->set_quality(s, CameraConfig::JPEG_QUALITY);    // JPEG quality (0-63, lower = better)
+    active = profileFor(mode);
+    s->set_framesize(s, active.frameSize);  // Working size (buffer was sized for MAX_FRAME_SIZE)
+    s->set_quality(s, active.quality);      // JPEG quality (0-63, lower = better)
     s->set_brightness(s, 0);         // -2 to 2
     s->set_contrast(s, 0);           // -2 to 2  
     s->set_saturation(s, 0);         // -2 to 2
@@ -87,26 +117,425 @@ camera_fb_t* CameraModule::captureImage() {
     return nullptr;
   }
   
-  flashOn();
-  delay(CameraConfig::FLASH_DURATION);
-  camera_fb_t* fb = esp_camera_fb_get();
-  flashOff();
+  // The lock also keeps two callers from sharing one flash pulse
+  unsigned long start = micros();
+  xSemaphoreTake(captureLock, portMAX_DELAY);
+  camera_fb_t* fb = captureLit();
+  xSemaphoreGive(captureLock);
+  captureLatency.observe(micros() - start);
+  
+  if (fb && !pipeline.isRunning()) {
+    fb = copyOut(fb);
+  }
   
   if (!fb) {
+    captureFailures.inc();
     Serial.println("Camera capture failed");
     return nullptr;
   }
   
   Serial.printf("Image captured: %dx%d (%u bytes)\n", fb->width, fb->height, fb->len);
+  lastFrame.store(fb);
+  return fb;
+}
+
+camera_fb_t* CameraModule::grabFrame() {
+  if (!initialized) return nullptr;
+  if (pipeline.isRunning()) return pipeline.acquire();
+  
+  xSemaphoreTake(captureLock, portMAX_DELAY);
+  camera_fb_t* fb = esp_camera_fb_get();
+  xSemaphoreGive(captureLock);
+  noteOnDemandFrame(fb);
   return fb;
 }
 
+// fb->timestamp is latched by the capture HAL when a frame's readout
+// starts. Row exposure ends at readout and lasts at most a frame period,
+// so a frame starting one period after flash-on was lit from its first
+// row. Earlier frames are discarded, and the flash goes off as soon as a
+// qualifying frame is complete rather than after a fixed delay.
+//
+// The switch to capture mode is written first, so the sensor settling at
+// the new size overlaps the flash lead instead of adding to it: the same
+// wait yields a frame that is both lit and the right size.
+camera_fb_t* CameraModule::captureLit() {
+  int64_t switchedAt = esp_timer_get_time();
+  bool switched = enterMode(MODE_CAPTURE);
+  
+  int64_t flashAt = esp_timer_get_time();
+  flashOn();
+  int64_t notBefore = flashAt + flashLeadUs();
+  int waitMs = switched ? max(FlashConfig::MAX_WAIT_MS, ModeConfig::SWITCH_TIMEOUT_MS) : FlashConfig::MAX_WAIT_MS;
+  int64_t deadline = flashAt + waitMs * 1000LL;
+  uint32_t stale = 0;
+  camera_fb_t* fb = nullptr;
+  
+  if (pipeline.isRunning()) {
+    while (true) {
+      int remainingMs = (deadline - esp_timer_get_time()) / 1000;
+      if (remainingMs <= 0) break;
+      fb = pipeline.acquire(notBefore, remainingMs, &stale);
+      if (!fb || isGoodFrame(fb)) break;
+      
+      // Still the old size, or mangled by the register change mid-frame
+      notBefore = frameStartUs(fb) + 1;
+      pipeline.release(fb);
+      fb = nullptr;
+      switchStats.discarded++;
+    }
+  } else {
+    while (esp_timer_get_time() < deadline) {
+      fb = esp_camera_fb_get();
+      if (!fb) break;
+      noteOnDemandFrame(fb);
+      bool lit = frameStartUs(fb) >= notBefore;
+      if (lit && isGoodFrame(fb)) break;
+      
+      esp_camera_fb_return(fb);
+      fb = nullptr;
+      if (lit) {
+        switchStats.discarded++;
+      } else {
+        stale++;
+      }
+    }
+  }
+  
+  flashOff();
+  flashOnTime.observe(esp_timer_get_time() - flashAt);
+  staleFrames.inc(stale);
+  staleFrameCount += stale;
+  
+  if (switched) {
+    noteSwitch(switchedAt, fb != nullptr);
+  }
+  
+  // Continuous frames are copies and on-demand ones are already read out,
+  // so the sensor can go back to watching while the caller uploads
+  enterMode(MODE_WATCH);
+  return fb;
+}
+
+// The measured period adapts to the current frame size (and to clock or
+// night-mode changes); the per-size table covers the time before that.
+// A period measured at the other mode's size doesn't count: crossing the
+// OV2640's CIF/SVGA/UXGA windows changes its frame timing.
+uint32_t CameraModule::flashLeadUs() const {
+  uint32_t period = pipeline.getFramePeriodUs();
+  if (period > 0 && pipeline.getFramePeriodWidth() == resolution[active.frameSize].width) {
+    return max(period, (uint32_t)FlashConfig::MIN_LEAD_MS * 1000);
+  }
+  if (active.frameSize <= FRAMESIZE_CIF) return FlashConfig::LEAD_MS_CIF * 1000;
+  if (active.frameSize <= FRAMESIZE_SVGA) return FlashConfig::LEAD_MS_SVGA * 1000;
+  return FlashConfig::LEAD_MS_LARGE * 1000;
+}
+
+SensorProfile CameraModule::profileFor(CameraMode m) const {
+  if (m == MODE_WATCH && ModeConfig::ENABLED) {
+    // Never larger than what the buffer was sized for, nor than the capture profile
+    framesize_t size = min(ModeConfig::WATCH_FRAME_SIZE, min(frameSize, CameraConfig::MAX_FRAME_SIZE));
+    return {size, ModeConfig::WATCH_QUALITY};
+  }
+  return {frameSize, jpegQuality};
+}
+
+// Both profiles are known ahead of time, so a switch writes only the
+// settings that differ: nothing when the watch and capture sizes match,
+// a single quantiser register when only quality differs. The pixel format
+// stays JPEG in both modes - set_pixformat resets the DSP, and the stream,
+// history and motion consumers all expect JPEG.
+bool CameraModule::program(const SensorProfile& profile) {
+  sensor_t* s = esp_camera_sensor_get();
+  if (!s) return false;
+  
+  if (profile.frameSize != active.frameSize) {
+    if (s->set_framesize(s, profile.frameSize) != 0) {
+      Serial.printf("set_framesize(%d) failed\n", profile.frameSize);
+      return false;
+    }
+    active.frameSize = profile.frameSize;
+  }
+  if (profile.quality != active.quality) {
+    if (s->set_quality(s, profile.quality) != 0) {
+      Serial.printf("set_quality(%d) failed\n", profile.quality);
+      return false;
+    }
+    active.quality = profile.quality;
+  }
+  return true;
+}
+
+// Returns true if the frame size changed, i.e. there are frames to wait out
+bool CameraModule::enterMode(CameraMode m) {
+  SensorProfile target = profileFor(m);
+  bool resized = target.frameSize != active.frameSize;
+  if (!program(target)) return false;
+  mode = m;
+  return resized;
+}
+
+// The right size and a JPEG start marker; the driver already drops frames
+// without an end marker
+bool CameraModule::isGoodFrame(const camera_fb_t* fb) const {
+  if (fb->width != resolution[active.frameSize].width || fb->height != resolution[active.frameSize].height) {
+    return false;
+  }
+  if (fb->format == PIXFORMAT_JPEG) {
+    return fb->len > 2 && fb->buf[0] == 0xFF && fb->buf[1] == 0xD8;
+  }
+  return true;
+}
+
+void CameraModule::noteSwitch(int64_t switchedAt, bool gotFrame) {
+  switchStats.switches++;
+  if (!gotFrame) {
+    switchStats.timeouts++;
+    return;
+  }
+  
+  uint32_t elapsed = esp_timer_get_time() - switchedAt;
+  switchStats.lastUs = elapsed;
+  switchStats.averageUs = switchStats.averageUs == 0 ? elapsed : (switchStats.averageUs * 7 + elapsed) / 8;
+  switchStats.maxUs = max(switchStats.maxUs, elapsed);
+  switchLatency.observe(elapsed);
+}
+
+// In continuous mode the capture task records history and counts frames
+void CameraModule::noteOnDemandFrame(const camera_fb_t* fb) {
+  if (!fb) return;
+  history.record(fb);
+  onDemandMeter.tick();
+  onDemandFrames++;
+  framesCaptured.inc();
+}
+
 void CameraModule::releaseFrameBuffer(camera_fb_t* fb) {
-  if (fb) {
+  if (fb && !pipeline.release(fb) && !releaseCopy(fb)) {
     esp_camera_fb_return(fb);
   }
 }
 
+// With one driver buffer, a caller holding it through a multi-second
+// upload leaves the stream and motion tasks blocked in esp_camera_fb_get
+// (with captureLock held) until the driver times out. Copy the frame into
+// a PSRAM slot and return the buffer at once; with no free slot or no
+// memory the caller keeps the driver buffer as before.
+camera_fb_t* CameraModule::copyOut(camera_fb_t* fb) {
+  xSemaphoreTake(capturedLock, portMAX_DELAY);
+  CapturedFrame* slot = nullptr;
+  for (int i = 0; i < CaptureConfig::CAPTURE_COPIES && !slot; i++) {
+    if (!captured[i].inUse) slot = &captured[i];
+  }
+  if (slot && slot->capacity < fb->len) {
+    uint8_t* grown = (uint8_t*)ps_malloc(fb->len);
+    if (grown) {
+      free(slot->data);
+      slot->data = grown;
+      slot->capacity = fb->len;
+    } else {
+      slot = nullptr;
+    }
+  }
+  if (slot) {
+    slot->inUse = true;
+  }
+  xSemaphoreGive(capturedLock);
+  if (!slot) return fb;
+  
+  memcpy(slot->data, fb->buf, fb->len);
+  slot->fb = *fb;
+  slot->fb.buf = slot->data;
+  esp_camera_fb_return(fb);
+  return &slot->fb;
+}
+
+bool CameraModule::releaseCopy(camera_fb_t* fb) {
+  bool ours = false;
+  xSemaphoreTake(capturedLock, portMAX_DELAY);
+  for (int i = 0; i < CaptureConfig::CAPTURE_COPIES && !ours; i++) {
+    if (fb == &captured[i].fb) {
+      captured[i].inUse = false;
+      ours = true;
+    }
+  }
+  xSemaphoreGive(capturedLock);
+  return ours;
+}
+
+bool CameraModule::applyProfile(framesize_t size, int quality) {
+  if (!initialized) return false;
+  
+  // Larger frames would overflow the buffer allocated at init
+  if (size > CameraConfig::MAX_FRAME_SIZE || quality < CameraLimits::minQuality(size) || quality > 63) {
+    Serial.printf("Rejected camera profile: framesize %d, quality %d\n", size, quality);
+    return false;
+  }
+  
+  // In watch mode only the staged profile changes; the next capture applies it
+  xSemaphoreTake(captureLock, portMAX_DELAY);
+  framesize_t previousSize = frameSize;
+  int previousQuality = jpegQuality;
+  frameSize = size;
+  jpegQuality = quality;
+  bool ok = program(profileFor(mode));
+  if (!ok) {
+    frameSize = previousSize;
+    jpegQuality = previousQuality;
+  }
+  xSemaphoreGive(captureLock);
+  if (!ok) return false;
+  
+  Serial.printf("Camera profile: %ux%u, quality %d\n", 
+                resolution[frameSize].width, resolution[frameSize].height, jpegQuality);
+  return true;
+}
+
+CameraSettings CameraModule::getSettings() const {
+  CameraSettings settings = {};
+  settings.frameSize = frameSize;
+  settings.quality = jpegQuality;
+  settings.xclkMhz = CameraConfig::XCLK_FREQ / 1000000;
+  settings.adaptive = adaptiveQuality;
+  
+  sensor_t* s = esp_camera_sensor_get();
+  if (s) {
+    settings.xclkMhz = s->xclk_freq_hz / 1000000;
+    settings.gainCeiling = s->status.gainceiling;
+    settings.aec = s->status.aec;
+    settings.aec2 = s->status.aec2;
+    settings.aeLevel = s->status.ae_level;
+    settings.aecValue = s->status.aec_value;
+    settings.agc = s->status.agc;
+    settings.agcGain = s->status.agc_gain;
+    settings.awb = s->status.awb;
+    settings.awbGain = s->status.awb_gain;
+    settings.wbMode = s->status.wb_mode;
+  }
+  return settings;
+}
+
+// Only settings that differ are written; each setter is an SCCB
+// transaction and some (XCLK, frame size) disturb the frames in flight
+bool CameraModule::applySettings(const CameraSettings& next) {
+  if (!initialized) return false;
+  sensor_t* s = esp_camera_sensor_get();
+  if (!s) return false;
+  
+  CameraSettings current = getSettings();
+  bool ok = true;
+  
+  xSemaphoreTake(captureLock, portMAX_DELAY);
+  if (next.xclkMhz != current.xclkMhz) {
+    ok = s->set_xclk(s, LEDC_TIMER_0, next.xclkMhz) == 0 && ok;
+    pipeline.resetFramePeriod();
+  }
+  if (next.gainCeiling != current.gainCeiling) ok = s->set_gainceiling(s, (gainceiling_t)next.gainCeiling) == 0 && ok;
+  if (next.aec != current.aec) ok = s->set_exposure_ctrl(s, next.aec) == 0 && ok;
+  if (next.aec2 != current.aec2) ok = s->set_aec2(s, next.aec2) == 0 && ok;
+  if (next.aeLevel != current.aeLevel) ok = s->set_ae_level(s, next.aeLevel) == 0 && ok;
+  if (next.aecValue != current.aecValue) ok = s->set_aec_value(s, next.aecValue) == 0 && ok;
+  if (next.agc != current.agc) ok = s->set_gain_ctrl(s, next.agc) == 0 && ok;
+  if (next.agcGain != current.agcGain) ok = s->set_agc_gain(s, next.agcGain) == 0 && ok;
+  if (next.awb != current.awb) ok = s->set_whitebal(s, next.awb) == 0 && ok;
+  if (next.awbGain != current.awbGain) ok = s->set_awb_gain(s, next.awbGain) == 0 && ok;
+  if (next.wbMode != current.wbMode) ok = s->set_wb_mode(s, next.wbMode) == 0 && ok;
+  adaptiveQuality = next.adaptive;
+  xSemaphoreGive(captureLock);
+  
+  if (next.frameSize != frameSize || next.quality != jpegQuality) {
+    ok = applyProfile(next.frameSize, next.quality) && ok;
+  }
+  if (!ok) {
+    Serial.println("Some camera settings were not accepted by the sensor");
+  }
+  return ok;
+}
+
+// The sensor's own registers go through esp_camera_save_to_nvs. That blob
+// holds the active (watch) frame size and no XCLK, so the capture profile,
+// XCLK and the adaptive flag are stored beside it in the same namespace.
+bool CameraModule::saveSettings() {
+  if (!initialized) return false;
+  
+  xSemaphoreTake(captureLock, portMAX_DELAY);
+  esp_err_t err = esp_camera_save_to_nvs(CameraConfig::NVS_NAMESPACE);
+  xSemaphoreGive(captureLock);
+  if (err != ESP_OK) {
+    Serial.printf("Saving sensor settings failed: 0x%x\n", err);
+    return false;
+  }
+  
+  nvs_handle_t handle;
+  err = nvs_open(CameraConfig::NVS_NAMESPACE, NVS_READWRITE, &handle);
+  if (err != ESP_OK) {
+    Serial.printf("Saving camera profile failed: 0x%x\n", err);
+    return false;
+  }
+  
+  CameraSettings settings = getSettings();
+  bool ok = nvs_set_u8(handle, "frame_size", settings.frameSize) == ESP_OK &&
+            nvs_set_u8(handle, "quality", settings.quality) == ESP_OK &&
+            nvs_set_u8(handle, "xclk_mhz", settings.xclkMhz) == ESP_OK &&
+            nvs_set_u8(handle, "adaptive", settings.adaptive) == ESP_OK &&
+            nvs_commit(handle) == ESP_OK;
+  nvs_close(handle);
+  
+  Serial.printf("Camera settings %s\n", ok ? "saved" : "not saved");
+  return ok;
+}
+
+// Read before esp_camera_init, which starts the clock
+int CameraModule::loadXclkMhz() {
+  int mhz = CameraConfig::XCLK_FREQ / 1000000;
+  
+  nvs_handle_t handle;
+  if (nvs_open(CameraConfig::NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) return mhz;
+  uint8_t saved = 0;
+  if (nvs_get_u8(handle, "xclk_mhz", &saved) == ESP_OK &&
+      saved >= CameraConfig::MIN_XCLK_MHZ && saved <= CameraConfig::MAX_XCLK_MHZ) {
+    mhz = saved;
+  }
+  nvs_close(handle);
+  return mhz;
+}
+
+// Saved values are checked against this build's limits: a MAX_FRAME_SIZE
+// lowered since they were saved must not overflow the new buffer
+void CameraModule::loadSettings() {
+  sensor_t* s = esp_camera_sensor_get();
+  if (!s || esp_camera_load_from_nvs(CameraConfig::NVS_NAMESPACE) != ESP_OK) return;
+  
+  // The blob restored the watch frame size and quality it was saved with
+  active.frameSize = s->status.framesize;
+  active.quality = s->status.quality;
+  
+  nvs_handle_t handle;
+  if (nvs_open(CameraConfig::NVS_NAMESPACE, NVS_READONLY, &handle) == ESP_OK) {
+    uint8_t size = 0, quality = 0, adaptive = 0;
+    if (nvs_get_u8(handle, "frame_size", &size) == ESP_OK && nvs_get_u8(handle, "quality", &quality) == ESP_OK) {
+      CameraSettings saved = getSettings();
+      saved.frameSize = (framesize_t)size;
+      saved.quality = quality;
+      const char* problem = CameraLimits::check(saved);
+      if (problem) {
+        Serial.printf("Ignoring saved camera profile: %s\n", problem);
+      } else {
+        frameSize = saved.frameSize;
+        jpegQuality = saved.quality;
+      }
+    }
+    if (nvs_get_u8(handle, "adaptive", &adaptive) == ESP_OK) {
+      adaptiveQuality = adaptive != 0;
+    }
+    nvs_close(handle);
+  }
+  
+  program(profileFor(mode));
+  Serial.printf("Camera settings loaded from NVS: capture %ux%u q%d, XCLK %d MHz\n",
+                resolution[frameSize].width, resolution[frameSize].height, jpegQuality, s->xclk_freq_hz / 1000000);
+}
+
 void CameraModule::flashOn() {
   digitalWrite(SystemPins::FLASH, HIGH);
 }
@@ -124,8 +553,8 @@ void CameraModule::printCameraInfo() {
   sensor_t* s = esp_camera_sensor_get();
   if (s) {
     Serial.printf("Camera sensor ID: 0x%02X\n", s->id.PID);
-    Serial.printf("Frame size: %s\n", 
-      CameraConfig::FRAME_SIZE == FRAMESIZE_QVGA ? "QVGA (320x240)" : "Other");
-    Serial.printf("JPEG quality: %d\n", CameraConfig::JPEG_QUALITY);
+    Serial.printf("Frame size: %ux%u\n", 
+      resolution[frameSize].width, resolution[frameSize].height);
+    Serial.printf("JPEG quality: %d\n", jpegQuality);
   }
 }
\ No newline at end of file
@@ -5,20 +5,96 @@
 #define CAMERA_MODULE_H
 
 #include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "esp_camera.h"
+#include "last_frame_cache.h"
+#include "frame_history.h"
+#include "capture_pipeline.h"
+#include "camera_settings.h"
+#include "metrics.h"
 #include "config.h"
 
+enum CameraMode : uint8_t {
+  MODE_WATCH = 0,     // ModeConfig::WATCH_FRAME_SIZE, between captures
+  MODE_CAPTURE = 1    // The adaptive quality profile, for the analysed frame
+};
+
+// The register-level settings that differ between the two modes
+struct SensorProfile {
+  framesize_t frameSize;
+  int quality;
+};
+
+// Switch-to-first-good-frame timing
+struct ModeSwitchStats {
+  uint32_t switches;        // Into capture mode with a register change
+  uint32_t timeouts;        // No capture-size frame within SWITCH_TIMEOUT_MS
+  uint32_t discarded;       // Frames of the old size or corrupt while switching
+  uint32_t lastUs;
+  uint32_t averageUs;       // Smoothed over recent switches
+  uint32_t maxUs;
+};
+
 class CameraModule {
 private:
   bool initialized;
+  framesize_t frameSize;           // Capture profile, set by the adaptive controller
+  int jpegQuality;
+  bool adaptiveQuality;             // Persisted; false once a profile is set by hand
+  CameraMode mode;
+  SensorProfile active;            // What the sensor is programmed with
+  ModeSwitchStats switchStats;
+  SemaphoreHandle_t captureLock;   // Analysis and stream tasks share the sensor
+  LastFrameCache lastFrame;
+  FrameHistory history;
+  CapturePipeline pipeline;        // Running only in continuous mode
+  
+  // On-demand captures are copied here so the single driver buffer goes
+  // straight back instead of being held through an upload
+  struct CapturedFrame {
+    camera_fb_t fb;                // Driver metadata; buf points at data
+    uint8_t* data;
+    size_t capacity;               // Grow only
+    bool inUse;
+  };
+  CapturedFrame captured[CaptureConfig::CAPTURE_COPIES];
+  SemaphoreHandle_t capturedLock;
+  RateMeter onDemandMeter;
+  uint32_t onDemandFrames;
+  Histogram captureLatency;
+  Histogram flashOnTime;
+  Counter captureFailures;
+  Counter framesCaptured;
+  Counter staleFrames;
+  Histogram switchLatency;
+  uint32_t staleFrameCount;
   
   void optimizeSensorSettings();
   void flashOn();
   void flashOff();
+  void noteOnDemandFrame(const camera_fb_t* fb);
+  camera_fb_t* captureLit();
+  camera_fb_t* copyOut(camera_fb_t* fb);
+  bool releaseCopy(camera_fb_t* fb);
+  uint32_t flashLeadUs() const;
+  SensorProfile profileFor(CameraMode m) const;
+  bool program(const SensorProfile& profile);
+  bool enterMode(CameraMode m);
+  bool isGoodFrame(const camera_fb_t* fb) const;
+  void noteSwitch(int64_t switchedAt, bool gotFrame);
+  static int loadXclkMhz();
+  void loadSettings();
   
 public:
   // Constructor
-  CameraModule() : initialized(false) {}
+  CameraModule() : initialized(false), frameSize(CameraConfig::FRAME_SIZE), 
+                   jpegQuality(CameraConfig::JPEG_QUALITY), adaptiveQuality(AdaptiveConfig::ENABLED),
+                   mode(MODE_CAPTURE),
+                   active{CameraConfig::MAX_FRAME_SIZE, CameraConfig::JPEG_QUALITY}, switchStats{0, 0, 0, 0, 0, 0},
+                   captureLock(xSemaphoreCreateMutex()), captured(), capturedLock(xSemaphoreCreateMutex()),
+                   onDemandMeter{0, 0, 0}, onDemandFrames(0),
+                   staleFrameCount(0) {}
   
   // Initialization
   bool initialize();
@@ -26,7 +102,38 @@ public:
   
   // Image capture
   camera_fb_t* captureImage();
+  camera_fb_t* grabFrame();        // No flash, no logging - for the live stream
   void releaseFrameBuffer(camera_fb_t* fb);
+  LastFrameCache& getLastFrame() { return lastFrame; }
+  FrameHistory& getHistory() { return history; }
+  
+  // Capture mode and sensor-side frame rate
+  bool isContinuous() const { return pipeline.isRunning(); }
+  float getFps() const { return isContinuous() ? pipeline.getFps() : onDemandMeter.rate; }
+  uint32_t getFramesCaptured() const { return isContinuous() ? pipeline.getPublished() : onDemandFrames; }
+  uint32_t getFramesDropped() const { return pipeline.getDropped(); }
+  uint32_t getStaleFrames() const { return staleFrameCount; }
+  uint32_t getFlashLeadMs() const { return flashLeadUs() / 1000; }
+  
+  // Runtime image settings (the capture profile; applied on the next
+  // capture while in watch mode)
+  bool applyProfile(framesize_t size, int quality);
+  framesize_t getFrameSize() const { return frameSize; }
+  int getJpegQuality() const { return jpegQuality; }
+  
+  // Everything /api/camera/config exposes. applySettings expects settings
+  // that passed CameraLimits::check; saveSettings persists them to NVS.
+  CameraSettings getSettings() const;
+  bool applySettings(const CameraSettings& settings);
+  bool saveSettings();
+  bool isAdaptiveQuality() const { return adaptiveQuality; }
+  
+  // Watch / capture mode switching
+  CameraMode getMode() const { return mode; }
+  const SensorProfile& getActiveProfile() const { return active; }
+  SensorProfile getWatchProfile() const { return profileFor(MODE_WATCH); }
+  const ModeSwitchStats& getSwitchStats() const { return switchStats; }
+  static const char* modeName(CameraMode m) { return m == MODE_WATCH ? "watch" : "capture"; }
   
   // Debugging
   void printCameraInfo();
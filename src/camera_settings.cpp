@@ -0,0 +1,35 @@
+// ============================================================================
+// camera_settings.cpp - Camera settings validation
+// ============================================================================
+#include "camera_settings.h"
+
+namespace CameraLimits {
+  int minQuality(framesize_t size) {
+    uint32_t area = (uint32_t)resolution[size].width * resolution[size].height;
+    uint32_t maxArea = (uint32_t)resolution[CameraConfig::MAX_FRAME_SIZE].width *
+                       resolution[CameraConfig::MAX_FRAME_SIZE].height;
+    int quality = (10 * area + maxArea - 1) / maxArea;
+    return max(quality, 2);
+  }
+  
+  const char* check(const CameraSettings& settings) {
+    if (settings.frameSize < 0 || settings.frameSize > CameraConfig::MAX_FRAME_SIZE) {
+      return "framesize larger than the frame buffer allows";
+    }
+    if (settings.quality > 63) return "quality must be 0-63";
+    if (settings.quality < minQuality(settings.frameSize)) {
+      return "quality too high for this framesize - frames would overflow the buffer";
+    }
+    if (settings.xclkMhz < CameraConfig::MIN_XCLK_MHZ || settings.xclkMhz > CameraConfig::MAX_XCLK_MHZ) {
+      return "xclk out of range";
+    }
+    if (settings.gainCeiling < GAINCEILING_2X || settings.gainCeiling > GAINCEILING_128X) {
+      return "gainceiling must be 0-6";
+    }
+    if (settings.aeLevel < -2 || settings.aeLevel > 2) return "ae_level must be -2..2";
+    if (settings.aecValue < 0 || settings.aecValue > 1200) return "aec_value must be 0-1200";
+    if (settings.agcGain < 0 || settings.agcGain > 30) return "agc_gain must be 0-30";
+    if (settings.wbMode < 0 || settings.wbMode > 4) return "wb_mode must be 0-4";
+    return nullptr;
+  }
+}
\ No newline at end of file
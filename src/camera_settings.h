@@ -0,0 +1,41 @@
+// ============================================================================
+// camera_settings.h - Runtime-adjustable camera settings and their limits
+// ============================================================================
+#ifndef CAMERA_SETTINGS_H
+#define CAMERA_SETTINGS_H
+
+#include <Arduino.h>
+#include "esp_camera.h"
+#include "config.h"
+
+// What GET/POST /api/camera/config expose. frameSize and quality are the
+// capture profile; the watch profile follows from ModeConfig.
+struct CameraSettings {
+  framesize_t frameSize;
+  int quality;              // 0-63, lower = better
+  int xclkMhz;
+  int gainCeiling;          // gainceiling_t: 0 (2x) .. 6 (128x)
+  bool aec;                 // Auto exposure
+  bool aec2;                // AEC DSP algorithm
+  int aeLevel;              // -2 .. 2
+  int aecValue;             // Manual exposure, 0 .. 1200 (aec off)
+  bool agc;                 // Auto gain
+  int agcGain;              // Manual gain, 0 .. 30 (agc off)
+  bool awb;                 // Auto white balance
+  bool awbGain;
+  int wbMode;               // 0 auto, 1 sunny, 2 cloudy, 3 office, 4 home
+  bool adaptive;            // Adaptive quality controller owns frameSize/quality
+};
+
+namespace CameraLimits {
+  // The JPEG frame buffer is sized at init for MAX_FRAME_SIZE at about
+  // 1/5 byte per pixel, which holds a quality-10 frame. Bytes per pixel
+  // grow roughly as 2/quality, so smaller frames may use proportionally
+  // lower (better) quality numbers before a frame stops fitting.
+  int minQuality(framesize_t size);
+  
+  // nullptr if the settings are usable, otherwise what's wrong
+  const char* check(const CameraSettings& settings);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,146 @@
+// ============================================================================
+// capture_pipeline.cpp - Continuous capture implementation
+// ============================================================================
+#include "capture_pipeline.h"
+
+CapturePipeline::CapturePipeline()
+  : lock(nullptr), taskHandle(nullptr), history(nullptr), latest(-1), meter{0, 0, 0},
+    lastStart(0), lastWidth(0), periodUs(0), published(0), dropped(0), failures(0) {
+  for (int i = 0; i < CaptureConfig::READY_FRAMES; i++) {
+    frames[i].data = nullptr;
+    frames[i].capacity = 0;
+    frames[i].readers = 0;
+  }
+}
+
+bool CapturePipeline::begin(FrameHistory* recordTo) {
+  history = recordTo;
+  lock = xSemaphoreCreateMutex();
+  if (!lock) return false;
+  
+  // Core 1: fb_get blocks most of the time, and the copies stay off the WiFi core
+  BaseType_t created = xTaskCreatePinnedToCore(captureTask, "capture", CaptureConfig::TASK_STACK,
+                                               this, CaptureConfig::TASK_PRIORITY, &taskHandle, 1);
+  if (created != pdPASS) {
+    taskHandle = nullptr;
+    Serial.println("Capture task creation failed");
+    return false;
+  }
+  return true;
+}
+
+void CapturePipeline::captureTask(void* param) {
+  static_cast<CapturePipeline*>(param)->captureLoop();
+}
+
+void CapturePipeline::captureLoop() {
+  while (true) {
+    // Paced by the sensor: returns as each DMA frame completes
+    camera_fb_t* fb = esp_camera_fb_get();
+    if (!fb) {
+      failures++;
+      vTaskDelay(pdMS_TO_TICKS(10));
+      continue;
+    }
+    
+    measurePeriod(fb);
+    publish(fb);
+    if (history) history->record(fb);
+    esp_camera_fb_return(fb);
+  }
+}
+
+void CapturePipeline::publish(const camera_fb_t* fb) {
+  // Consumers only ever pin the newest frame, so any other unpinned slot
+  // is unreachable and safe to overwrite without holding the lock
+  int target = -1;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (int i = 0; i < CaptureConfig::READY_FRAMES && target < 0; i++) {
+    if (i != latest && frames[i].readers == 0) target = i;
+  }
+  xSemaphoreGive(lock);
+  
+  if (target < 0) {
+    dropped++;
+    return;
+  }
+  
+  ReadyFrame& frame = frames[target];
+  if (fb->len > frame.capacity) {
+    free(frame.data);
+    frame.data = (uint8_t*)ps_malloc(fb->len);
+    frame.capacity = frame.data ? fb->len : 0;
+    if (!frame.data) {
+      dropped++;
+      return;
+    }
+  }
+  memcpy(frame.data, fb->buf, fb->len);
+  frame.fb = *fb;
+  frame.fb.buf = frame.data;
+  frame.startedAt = frameStartUs(fb);
+  
+  xSemaphoreTake(lock, portMAX_DELAY);
+  frame.publishedAt = millis();
+  latest = target;
+  xSemaphoreGive(lock);
+  
+  published++;
+  meter.tick();
+  frameCounter.inc();
+}
+
+// Smoothed VSYNC-to-VSYNC interval. Frames are only compared at the same
+// width, so a frame size change starts a fresh measurement.
+void CapturePipeline::measurePeriod(const camera_fb_t* fb) {
+  int64_t start = frameStartUs(fb);
+  if (fb->width != lastWidth) {
+    lastWidth = fb->width;
+    periodUs = 0;
+  } else if (lastStart > 0 && start > lastStart && start - lastStart < 1000000) {
+    uint32_t interval = start - lastStart;
+    periodUs = periodUs == 0 ? interval : (periodUs * 7 + interval) / 8;
+  }
+  lastStart = start;
+}
+
+camera_fb_t* CapturePipeline::acquire(int64_t startedAfterUs, int waitMs, uint32_t* staleCount) {
+  if (!isRunning()) return nullptr;
+  
+  unsigned long start = millis();
+  int64_t lastRejected = 0;
+  while (true) {
+    camera_fb_t* fb = nullptr;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (latest >= 0 && millis() - frames[latest].publishedAt <= (unsigned long)CaptureConfig::MAX_FRAME_AGE_MS) {
+      ReadyFrame& frame = frames[latest];
+      if (frame.startedAt >= startedAfterUs) {
+        frame.readers++;
+        fb = &frame.fb;
+      } else if (frame.startedAt != lastRejected) {
+        lastRejected = frame.startedAt;
+        if (staleCount) (*staleCount)++;
+      }
+    }
+    xSemaphoreGive(lock);
+    
+    if (fb) return fb;
+    if (millis() - start >= (unsigned long)waitMs) return nullptr;
+    vTaskDelay(pdMS_TO_TICKS(2));
+  }
+}
+
+bool CapturePipeline::release(camera_fb_t* fb) {
+  if (!lock || !fb) return false;
+  
+  bool ours = false;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (int i = 0; i < CaptureConfig::READY_FRAMES && !ours; i++) {
+    if (fb == &frames[i].fb) {
+      if (frames[i].readers > 0) frames[i].readers--;
+      ours = true;
+    }
+  }
+  xSemaphoreGive(lock);
+  return ours;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+// ============================================================================
+// capture_pipeline.h - Free-running capture task that keeps a frame ready
+// ============================================================================
+#ifndef CAPTURE_PIPELINE_H
+#define CAPTURE_PIPELINE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_camera.h"
+#include "frame_history.h"
+#include "metrics.h"
+#include "config.h"
+
+// Start of a frame's readout (VSYNC), in esp_timer microseconds
+inline int64_t frameStartUs(const camera_fb_t* fb) {
+  return (int64_t)fb->timestamp.tv_sec * 1000000LL + fb->timestamp.tv_usec;
+}
+
+// Frames per second over roughly the last second
+struct RateMeter {
+  unsigned long windowStart;
+  uint32_t windowFrames;
+  float rate;
+  
+  void tick() {
+    unsigned long now = millis();
+    if (windowFrames == 0 && rate == 0) windowStart = now;
+    windowFrames++;
+    if (now - windowStart >= 1000) {
+      rate = windowFrames * 1000.0f / (now - windowStart);
+      windowStart = now;
+      windowFrames = 0;
+    }
+  }
+};
+
+// With fb_count >= 2 the driver DMAs frames continuously. The capture task
+// takes each one, copies it into a ready slot in PSRAM and hands the driver
+// buffer straight back, so the sensor never waits on a consumer. acquire()
+// pins the newest ready slot - a pointer swap, no flash, no readout - and
+// the task only ever writes slots that are neither newest nor pinned.
+class CapturePipeline {
+private:
+  struct ReadyFrame {
+    camera_fb_t fb;          // Driver metadata; buf points at data
+    int64_t startedAt;       // frameStartUs(fb)
+    uint8_t* data;
+    size_t capacity;         // Grow only
+    unsigned long publishedAt;
+    uint8_t readers;
+  };
+  
+  SemaphoreHandle_t lock;
+  TaskHandle_t taskHandle;
+  FrameHistory* history;
+  ReadyFrame frames[CaptureConfig::READY_FRAMES];
+  int latest;                // Index of the newest frame, -1 before the first
+  RateMeter meter;
+  Counter frameCounter;
+  
+  // Sensor frame period, re-learned whenever the frame size changes
+  int64_t lastStart;
+  uint16_t lastWidth;
+  uint32_t periodUs;         // 0 = not measured yet
+  
+  // Counters
+  uint32_t published;
+  uint32_t dropped;          // No free slot, or no memory for one
+  uint32_t failures;         // esp_camera_fb_get returned nothing
+  
+  static void captureTask(void* param);
+  void captureLoop();
+  void publish(const camera_fb_t* fb);
+  void measurePeriod(const camera_fb_t* fb);
+  
+public:
+  CapturePipeline();
+  
+  // Camera must already be initialized with fb_count >= 2
+  bool begin(FrameHistory* recordTo);
+  bool isRunning() const { return taskHandle != nullptr; }
+  void countFramesIn(Counter counter) { frameCounter = counter; }
+  
+  // Newest frame, pinned until release(). Waits up to waitMs when there
+  // is none yet, it is older than MAX_FRAME_AGE_MS, or its readout began
+  // before startedAfterUs. Frames passed over that way are added to
+  // staleCount.
+  camera_fb_t* acquire(int64_t startedAfterUs = 0, int waitMs = CaptureConfig::WAIT_MS,
+                       uint32_t* staleCount = nullptr);
+  
+  // False if fb didn't come from acquire()
+  bool release(camera_fb_t* fb);
+  
+  // Status
+  float getFps() const { return meter.rate; }
+  uint32_t getFramePeriodUs() const { return periodUs; }
+  uint16_t getFramePeriodWidth() const { return lastWidth; }  // Width the period was measured at
+  void resetFramePeriod() { periodUs = 0; }                   // Sensor timing changed (XCLK)
+  uint32_t getPublished() const { return published; }
+  uint32_t getDropped() const { return dropped; }
+  uint32_t getFailures() const { return failures; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,162 @@
+// ============================================================================
+// chunked_jpeg_stream.cpp - On-the-fly JPEG chunked body implementation
+// ============================================================================
+#include "chunked_jpeg_stream.h"
+#include "img_converters.h"
+
+ChunkedJpegStream::ChunkedJpegStream(camera_fb_t* frame, const String& boundary, uint8_t jpegQuality)
+  : fb(frame), quality(jpegQuality), pipe(nullptr), finished(nullptr), encoderHandle(nullptr),
+    aborted(false), encodeDone(false), encodeFailed(false), jpegBytes(0),
+    chunkStart(0), chunkEnd(0), terminated(false) {
+  preamble = "--" + boundary + "\r\n";
+  preamble += "Content-Disposition: form-data; name=\"image\"; filename=\"capture.jpg\"\r\n";
+  preamble += "Content-Type: image/jpeg\r\n\r\n";
+  
+  epilogue = "\r\n--" + boundary + "--\r\n";
+}
+
+ChunkedJpegStream::~ChunkedJpegStream() {
+  end();
+}
+
+bool ChunkedJpegStream::begin() {
+  aborted = false;
+  encodeDone = false;
+  encodeFailed = false;
+  jpegBytes = 0;
+  chunkStart = chunkEnd = 0;
+  terminated = false;
+  
+  pipe = xStreamBufferCreate(UploadConfig::PIPE_SIZE, 1);
+  finished = xSemaphoreCreateBinary();
+  if (!pipe || !finished) {
+    end();
+    return false;
+  }
+  
+  // Core 1, so encoding runs in parallel with TLS on the worker's core 0
+  if (xTaskCreatePinnedToCore(encoderTask, "jpgenc", UploadConfig::ENCODER_TASK_STACK, this,
+                              SystemConfig::ANALYSIS_TASK_PRIORITY, &encoderHandle, 1) != pdPASS) {
+    encoderHandle = nullptr;
+    end();
+    return false;
+  }
+  return true;
+}
+
+void ChunkedJpegStream::end() {
+  if (encoderHandle) {
+    // push() notices within one send timeout and the encoder runs out
+    aborted = true;
+    xSemaphoreTake(finished, portMAX_DELAY);
+    encoderHandle = nullptr;
+  }
+  if (pipe) {
+    vStreamBufferDelete(pipe);
+    pipe = nullptr;
+  }
+  if (finished) {
+    vSemaphoreDelete(finished);
+    finished = nullptr;
+  }
+}
+
+void ChunkedJpegStream::encoderTask(void* param) {
+  ChunkedJpegStream* self = static_cast<ChunkedJpegStream*>(param);
+  
+  bool ok = self->push((const uint8_t*)self->preamble.c_str(), self->preamble.length());
+  ok = ok && frame2jpg_cb(self->fb, self->quality, onJpegData, self);
+  // frame2jpg_cb ignores short writes from the callback; check ourselves
+  ok = ok && !self->aborted && self->jpegBytes > 0;
+  ok = ok && self->push((const uint8_t*)self->epilogue.c_str(), self->epilogue.length());
+  
+  self->encodeFailed = !ok;
+  self->encodeDone = true;
+  xSemaphoreGive(self->finished);
+  vTaskDelete(nullptr);
+}
+
+size_t ChunkedJpegStream::onJpegData(void* arg, size_t index, const void* data, size_t len) {
+  ChunkedJpegStream* self = static_cast<ChunkedJpegStream*>(arg);
+  if (!self->push((const uint8_t*)data, len)) {
+    return 0;
+  }
+  self->jpegBytes += len;
+  return len;
+}
+
+bool ChunkedJpegStream::push(const uint8_t* data, size_t len) {
+  size_t sent = 0;
+  while (sent < len) {
+    if (aborted) return false;
+    // Blocks while the uploader is behind; that backpressure is what keeps
+    // the buffer small
+    sent += xStreamBufferSend(pipe, data + sent, len - sent, pdMS_TO_TICKS(UploadConfig::PIPE_WAIT_MS));
+  }
+  return true;
+}
+
+bool ChunkedJpegStream::stageChunk() {
+  if (terminated || !pipe) return false;
+  
+  // Sample before receiving: if the encoder was already done, an empty
+  // receive means everything has been handed over
+  bool done = encodeDone;
+  uint8_t* payload = chunk + CHUNK_HEADER_SPACE;
+  size_t n = xStreamBufferReceive(pipe, payload, UploadConfig::CHUNK_SIZE,
+                                  done ? 0 : pdMS_TO_TICKS(UploadConfig::PIPE_WAIT_MS));
+                                  
+  if (n > 0) {
+    char header[CHUNK_HEADER_SPACE + 1];
+    int headerLength = snprintf(header, sizeof(header), "%X\r\n", (unsigned)n);
+    chunkStart = CHUNK_HEADER_SPACE - headerLength;
+    memcpy(chunk + chunkStart, header, headerLength);
+    payload[n] = '\r';
+    payload[n + 1] = '\n';
+    chunkEnd = CHUNK_HEADER_SPACE + n + 2;
+    return true;
+  }
+  
+  if (!done) return false;
+  
+  // Terminate even after a failed encode: the backend rejects the
+  // truncated multipart body and the connection stays usable
+  memcpy(chunk, "0\r\n\r\n", 5);
+  chunkStart = 0;
+  chunkEnd = 5;
+  terminated = true;
+  return true;
+}
+
+int ChunkedJpegStream::available() {
+  if (chunkStart < chunkEnd || stageChunk()) {
+    return chunkEnd - chunkStart;
+  }
+  return terminated ? -1 : 0;
+}
+
+int ChunkedJpegStream::peek() {
+  if (chunkStart >= chunkEnd && !stageChunk()) {
+    return -1;
+  }
+  return chunk[chunkStart];
+}
+
+int ChunkedJpegStream::read() {
+  int c = peek();
+  if (c >= 0) {
+    chunkStart++;
+  }
+  return c;
+}
+
+size_t ChunkedJpegStream::readBytes(char* buffer, size_t length) {
+  if (chunkStart >= chunkEnd && !stageChunk()) {
+    return 0;
+  }
+  
+  size_t toCopy = min(length, chunkEnd - chunkStart);
+  memcpy(buffer, chunk + chunkStart, toCopy);
+  chunkStart += toCopy;
+  return toCopy;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+// ============================================================================
+// chunked_jpeg_stream.h - Chunked multipart body encoded to JPEG on the fly
+// ============================================================================
+#ifndef CHUNKED_JPEG_STREAM_H
+#define CHUNKED_JPEG_STREAM_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/task.h"
+#include "esp_camera.h"
+#include "config.h"
+
+// Multipart body for frames that aren't JPEG yet (RGB565, YUV422, ...).
+// An encoder task runs frame2jpg_cb() and pushes the JPEG bytes into a
+// small stream buffer as they are produced, while HTTPClient pulls them out
+// framed as HTTP/1.1 chunks. Encoding overlaps the upload, the first bytes
+// leave before the frame is fully encoded, and no full-size JPEG buffer is
+// ever allocated. The total length isn't known up front, so the request
+// must carry "Transfer-Encoding: chunked" and no Content-Length.
+class ChunkedJpegStream : public Stream {
+private:
+  static const size_t CHUNK_HEADER_SPACE = 8;   // "%X\r\n" for up to 0xFFFFF bytes
+  
+  camera_fb_t* fb;
+  String preamble;
+  String epilogue;
+  uint8_t quality;
+  
+  StreamBufferHandle_t pipe;
+  SemaphoreHandle_t finished;
+  TaskHandle_t encoderHandle;
+  volatile bool aborted;
+  volatile bool encodeDone;
+  volatile bool encodeFailed;
+  size_t jpegBytes;
+  
+  // One framed chunk staged for HTTPClient
+  uint8_t chunk[CHUNK_HEADER_SPACE + UploadConfig::CHUNK_SIZE + 2];
+  size_t chunkStart;
+  size_t chunkEnd;
+  bool terminated;           // Final zero-length chunk has been staged
+  
+  static void encoderTask(void* param);
+  static size_t onJpegData(void* arg, size_t index, const void* data, size_t len);
+  bool push(const uint8_t* data, size_t len);
+  bool stageChunk();
+  
+public:
+  ChunkedJpegStream(camera_fb_t* frame, const String& boundary, uint8_t jpegQuality);
+  ~ChunkedJpegStream();
+  
+  // Start (or restart, for a retry) the encoder task
+  bool begin();
+  void end();
+  bool rewind() { end(); return begin(); }
+  
+  bool failed() const { return encodeFailed; }
+  size_t getJpegBytes() const { return jpegBytes; }
+  
+  // Stream interface (read side). available() returns 0 while the encoder
+  // is still working and -1 once the terminating chunk has been read, which
+  // is how HTTPClient::sendRequest() detects the end of an unsized body.
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char* buffer, size_t length) override;
+  
+  // Print interface (unused - body is read-only)
+  size_t write(uint8_t) override { return 0; }
+};
+
+#endif
\ No newline at end of file
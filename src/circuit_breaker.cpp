@@ -0,0 +1,95 @@
+// ============================================================================
+// circuit_breaker.cpp - Circuit breaker implementation
+// ============================================================================
+#include "circuit_breaker.h"
+
+CircuitBreaker::CircuitBreaker()
+  : state(BREAKER_CLOSED), consecutiveFailures(0), tripCount(0), openedAt(0), backoffMs(0),
+    totalTrips(0), fastFails(0), probes(0), probeFailures(0) {
+}
+
+bool CircuitBreaker::allowRequest(unsigned long now) {
+  if (state == BREAKER_OPEN && now - openedAt >= backoffMs) {
+    state = BREAKER_HALF_OPEN;
+  }
+  
+  if (state == BREAKER_OPEN) {
+    fastFails++;
+    return false;
+  }
+  return true;
+}
+
+void CircuitBreaker::recordSuccess() {
+  if (state != BREAKER_CLOSED) {
+    Serial.println("Circuit breaker closed - backend recovered");
+  }
+  state = BREAKER_CLOSED;
+  consecutiveFailures = 0;
+  tripCount = 0;
+  backoffMs = 0;
+}
+
+void CircuitBreaker::recordFailure(unsigned long now) {
+  consecutiveFailures++;
+  
+  // A failed trial reopens immediately; otherwise wait for the threshold
+  if (state == BREAKER_HALF_OPEN || consecutiveFailures >= BreakerConfig::FAILURE_THRESHOLD) {
+    trip(now);
+  }
+}
+
+void CircuitBreaker::recordProbe(bool success, unsigned long now) {
+  probes++;
+  if (success) {
+    recordSuccess();
+  } else {
+    probeFailures++;
+    recordFailure(now);
+  }
+}
+
+bool CircuitBreaker::isProbeDue(unsigned long now) const {
+  return state != BREAKER_CLOSED && now - openedAt >= backoffMs;
+}
+
+unsigned long CircuitBreaker::getRetryIn(unsigned long now) const {
+  if (state != BREAKER_OPEN) return 0;
+  unsigned long elapsed = now - openedAt;
+  return elapsed >= backoffMs ? 0 : backoffMs - elapsed;
+}
+
+const char* CircuitBreaker::stateName(BreakerState state) {
+  switch (state) {
+    case BREAKER_CLOSED:    return "closed";
+    case BREAKER_OPEN:      return "open";
+    case BREAKER_HALF_OPEN: return "half-open";
+    default:                return "unknown";
+  }
+}
+
+void CircuitBreaker::trip(unsigned long now) {
+  tripCount++;
+  totalTrips++;
+  
+  // Exponential backoff: base * 2^(trips-1), capped
+  unsigned long backoff = BreakerConfig::BASE_BACKOFF_MS;
+  for (int i = 1; i < tripCount && backoff < (unsigned long)BreakerConfig::MAX_BACKOFF_MS; i++) {
+    backoff *= 2;
+  }
+  if (backoff > (unsigned long)BreakerConfig::MAX_BACKOFF_MS) {
+    backoff = BreakerConfig::MAX_BACKOFF_MS;
+  }
+  
+  // +/- JITTER_PERCENT so a fleet doesn't retry in lockstep
+  unsigned long jitterRange = backoff * BreakerConfig::JITTER_PERCENT / 100;
+  if (jitterRange > 0) {
+    backoff = backoff - jitterRange + esp_random() % (2 * jitterRange + 1);
+  }
+  
+  state = BREAKER_OPEN;
+  openedAt = now;
+  backoffMs = backoff;
+  
+  Serial.printf("Circuit breaker OPEN after %d failures - retry in %lu ms\n", consecutiveFailures, backoffMs);
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+// ============================================================================
+// circuit_breaker.h - Circuit breaker with jittered exponential backoff
+// ============================================================================
+#ifndef CIRCUIT_BREAKER_H
+#define CIRCUIT_BREAKER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+enum BreakerState {
+  BREAKER_CLOSED,     // Normal operation
+  BREAKER_OPEN,       // Failing fast until the backoff expires
+  BREAKER_HALF_OPEN   // Backoff expired; next call is a trial
+};
+
+// Tracks backend health for BackendClient. After FAILURE_THRESHOLD
+// consecutive failures the breaker opens and callers fail fast. Each trip
+// doubles the backoff (with jitter) up to MAX_BACKOFF_MS. When the backoff
+// runs out the breaker goes half-open, and one cheap probe decides whether
+// it closes again or reopens.
+class CircuitBreaker {
+private:
+  BreakerState state;
+  int consecutiveFailures;
+  int tripCount;               // Trips since the last close, drives the backoff
+  unsigned long openedAt;
+  unsigned long backoffMs;
+  unsigned long totalTrips;
+  unsigned long fastFails;
+  unsigned long probes;
+  unsigned long probeFailures;
+  
+  void trip(unsigned long now);
+  
+public:
+  CircuitBreaker();
+  
+  // True if a real request may go out now. Moves OPEN -> HALF_OPEN once
+  // the backoff has expired. Counts a fast-fail when it returns false.
+  bool allowRequest(unsigned long now);
+  
+  void recordSuccess();
+  void recordFailure(unsigned long now);
+  void recordProbe(bool success, unsigned long now);
+  
+  // Status
+  BreakerState getState() const { return state; }
+  bool isProbeDue(unsigned long now) const;
+  unsigned long getRetryIn(unsigned long now) const;
+  int getConsecutiveFailures() const { return consecutiveFailures; }
+  unsigned long getBackoff() const { return backoffMs; }
+  unsigned long getTotalTrips() const { return totalTrips; }
+  unsigned long getFastFails() const { return fastFails; }
+  unsigned long getProbes() const { return probes; }
+  unsigned long getProbeFailures() const { return probeFailures; }
+  static const char* stateName(BreakerState state);
+};
+
+#endif
\ No newline at end of file
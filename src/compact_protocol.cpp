@@ -0,0 +1,93 @@
+// ============================================================================
+// compact_protocol.cpp - Binary frame upload and verdict implementation
+// ============================================================================
+#include "compact_protocol.h"
+#include <time.h>
+
+CompactFrameStream::CompactFrameStream(camera_fb_t* fb, uint32_t sequence)
+  : image(fb->buf), imageLength(fb->len), position(0) {
+  memset(&header, 0, sizeof(header));
+  header.magic = ProtocolConfig::FRAME_MAGIC;
+  header.version = ProtocolConfig::VERSION;
+  header.format = fb->format;
+  header.width = fb->width;
+  header.height = fb->height;
+  header.sequence = sequence;
+  header.captureMs = fb->timestamp.tv_sec * 1000UL + fb->timestamp.tv_usec / 1000;
+  time_t now = time(nullptr);
+  header.unixTime = now > 1600000000 ? (uint32_t)now : 0;
+  header.length = fb->len;
+}
+
+int CompactFrameStream::available() {
+  size_t remaining = totalLength() - position;
+  return remaining > INT32_MAX ? INT32_MAX : (int)remaining;
+}
+
+int CompactFrameStream::peek() {
+  if (position < sizeof(header)) {
+    return ((const uint8_t*)&header)[position];
+  }
+  if (position < totalLength()) {
+    return image[position - sizeof(header)];
+  }
+  return -1;
+}
+
+int CompactFrameStream::read() {
+  int c = peek();
+  if (c >= 0) {
+    position++;
+  }
+  return c;
+}
+
+size_t CompactFrameStream::readBytes(char* buffer, size_t length) {
+  size_t copied = 0;
+  
+  if (position < sizeof(header)) {
+    size_t toCopy = min(sizeof(header) - position, length);
+    memcpy(buffer, (const uint8_t*)&header + position, toCopy);
+    position += toCopy;
+    copied += toCopy;
+  }
+  
+  if (copied < length && position < totalLength()) {
+    size_t offset = position - sizeof(header);
+    size_t toCopy = min(imageLength - offset, length - copied);
+    memcpy(buffer + copied, image + offset, toCopy);
+    position += toCopy;
+    copied += toCopy;
+  }
+  
+  return copied;
+}
+
+CompactVerdictReader::CompactVerdictReader(AnalysisResult& target) : result(target), bytesRead(0) {
+  memset(&verdict, 0, sizeof(verdict));
+}
+
+size_t CompactVerdictReader::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t CompactVerdictReader::write(const uint8_t* buffer, size_t size) {
+  // Anything past the fixed layout is ignored but still consumed
+  if (bytesRead < sizeof(verdict)) {
+    size_t toCopy = min(sizeof(verdict) - bytesRead, size);
+    memcpy((uint8_t*)&verdict + bytesRead, buffer, toCopy);
+  }
+  bytesRead += size;
+  return size;
+}
+
+bool CompactVerdictReader::apply() {
+  if (bytesRead < sizeof(verdict) || verdict.magic != ProtocolConfig::VERDICT_MAGIC ||
+      verdict.version != ProtocolConfig::VERSION || verdict.status != 0) {
+    return false;
+  }
+  
+  result.isHoneyBadger = (verdict.flags & 0x01) != 0;
+  result.confidence = verdict.confidence / 10000.0f;
+  return true;
+}
\ No newline at end of file
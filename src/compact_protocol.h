@@ -0,0 +1,89 @@
+// ============================================================================
+// compact_protocol.h - Binary frame upload and verdict wire format
+// ============================================================================
+#ifndef COMPACT_PROTOCOL_H
+#define COMPACT_PROTOCOL_H
+
+#include <Arduino.h>
+#include "esp_camera.h"
+#include "backend_client.h"
+
+// Request body for ProtocolConfig::COMPACT_ENDPOINT
+// (Content-Type: application/octet-stream): this header, then the JPEG.
+// All fields little-endian, matching tools/standin_backend.py.
+struct __attribute__((packed)) CompactFrameHeader {
+  uint32_t magic;           // ProtocolConfig::FRAME_MAGIC
+  uint8_t version;
+  uint8_t format;           // pixformat_t
+  uint16_t width;
+  uint16_t height;
+  uint16_t reserved;
+  uint32_t sequence;        // Per-boot upload counter
+  uint32_t captureMs;       // Uptime at capture
+  uint32_t unixTime;        // 0 if the clock isn't set
+  uint32_t length;          // JPEG bytes after the header
+};
+
+// Fixed-layout response body
+struct __attribute__((packed)) CompactVerdict {
+  uint32_t magic;           // ProtocolConfig::VERDICT_MAGIC
+  uint8_t version;
+  uint8_t status;           // 0 = analysed, anything else = backend error code
+  uint8_t flags;            // Bit 0: honey badger
+  uint8_t reserved;
+  uint16_t confidence;      // Confidence * 10000
+  uint16_t serverMs;        // Inference time on the backend
+};
+
+// Read-only Stream yielding the binary header followed by the JPEG straight
+// from the frame buffer - the compact counterpart of MultipartStream.
+class CompactFrameStream : public Stream {
+private:
+  CompactFrameHeader header;
+  const uint8_t* image;
+  size_t imageLength;
+  size_t position;
+  
+public:
+  CompactFrameStream(camera_fb_t* fb, uint32_t sequence);
+  
+  size_t totalLength() const { return sizeof(header) + imageLength; }
+  void rewind() { position = 0; }
+  
+  // Stream interface (read side)
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char* buffer, size_t length) override;
+  
+  // Print interface (unused - body is read-only)
+  size_t write(uint8_t) override { return 0; }
+};
+
+// Collects the fixed-size verdict from HTTPClient::writeToStream() and
+// fills the AnalysisResult, like VerdictParser does for JSON.
+class CompactVerdictReader : public Stream {
+private:
+  AnalysisResult& result;
+  CompactVerdict verdict;
+  size_t bytesRead;
+  
+public:
+  CompactVerdictReader(AnalysisResult& target);
+  
+  // Print interface - feed response bytes here
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  
+  // Stream read side (unused - the reader is write-only)
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  
+  // Validates the verdict and copies it into the result
+  bool apply();
+  size_t getBytesRead() const { return bytesRead; }
+  uint16_t getServerTime() const { return verdict.serverMs; }
+};
+
+#endif
\ No newline at end of file
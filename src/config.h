@@ -4,7 +4,8 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
-#include "esp_camera.h"
+#include <stdint.h>
+#include "sensor.h"            // framesize_t / pixformat_t only; keeps config.h host-buildable
 
 // Camera pins for AI Thinker ESP32-CAM
 namespace CameraPins {
@@ -55,18 +56,202 @@ namespace SystemConfig {
   const int WEB_SERVER_PORT = 80;
   const int WIFI_CONNECT_TIMEOUT = 30;
   const int HTTP_TIMEOUT = 15000;
+  const int BACKEND_KEEPALIVE_IDLE = 60000;   // Drop kept-alive backend socket after 60s idle
   const int WIFI_RECONNECT_INTERVAL = 120000;
   const int HEARTBEAT_INTERVAL = 5000;
   const int LOW_MEMORY_THRESHOLD = 25000;
   const int CHUNK_SIZE = 1024;
+  
+  // Background analysis worker
+  const int ANALYSIS_QUEUE_DEPTH = 4;         // Jobs waiting for the worker
+  const int ANALYSIS_RESULT_SLOTS = 8;        // Must exceed queue depth + 1 running job
+  const int ANALYSIS_TASK_STACK = 8192;       // Same as Arduino loopTask (TLS needs it)
+  const int ANALYSIS_TASK_PRIORITY = 1;
+  const int ANALYSIS_MIN_INTERVAL_MS = 1000;  // Requests this soon after a successful analysis share its verdict
 }
 
 namespace CameraConfig {
   const pixformat_t PIXEL_FORMAT = PIXFORMAT_JPEG;
   const framesize_t FRAME_SIZE = FRAMESIZE_QVGA;    // 320x240
+  const framesize_t MAX_FRAME_SIZE = FRAMESIZE_SVGA; // Sizes the frame buffer; runtime changes can't exceed it
   const int JPEG_QUALITY = 20;              // 20-25 is optimal for detection
   const int XCLK_FREQ = 20000000;
-  const int FLASH_DURATION = 50;
+  const bool CACHE_LAST_FRAME = true;       // Keep a PSRAM copy of the latest capture for /capture?maxAge
+  
+  // Runtime changes through /api/camera/config
+  const char* const NVS_NAMESPACE = "camera"; // esp_camera_save_to_nvs key, plus our own entries
+  const int MIN_XCLK_MHZ = 8;
+  const int MAX_XCLK_MHZ = 20;              // Higher rates outrun the I2S DMA into PSRAM
+}
+
+// Flash strobe tied to frame timestamps: the flash stays on only until a
+// frame whose whole exposure came after flash-on has been read out
+namespace FlashConfig {
+  // Lead between flash-on and the start of an acceptable frame, used until
+  // the sensor's frame period at the current size has been measured
+  const int LEAD_MS_CIF = 30;               // Up to CIF (400x296)
+  const int LEAD_MS_SVGA = 50;              // Up to SVGA
+  const int LEAD_MS_LARGE = 100;            // XGA and above
+  const int MIN_LEAD_MS = 10;               // Floor under a measured period
+  const int MAX_WAIT_MS = 1000;             // Give up on a lit frame after this
+}
+
+// Dual-mode sensor: small watch frames between captures, the adaptive
+// quality profile's size only for the frame that goes to the backend
+namespace ModeConfig {
+  const bool ENABLED = true;                // false = the sensor always runs at the capture profile
+  const framesize_t WATCH_FRAME_SIZE = FRAMESIZE_QVGA; // Stream, motion and history frames
+  const int WATCH_QUALITY = 25;             // JPEG quality in watch mode (0-63, lower = better)
+  const int SWITCH_TIMEOUT_MS = 1000;       // Give up on a capture-size frame after this
+}
+
+// Continuous capture: a task keeps the newest frame ready in PSRAM
+namespace CaptureConfig {
+  const bool CONTINUOUS = true;             // false = flash + esp_camera_fb_get per request, one frame buffer
+  const int FB_COUNT = 2;                   // Driver frame buffers in continuous mode (PSRAM)
+  const int READY_FRAMES = 3;               // Published copies: the newest plus ones consumers still hold
+  const int CAPTURE_COPIES = 2;             // On-demand captures copied out while held (worker + /capture)
+  const int MAX_FRAME_AGE_MS = 1000;        // acquire() waits for a newer frame beyond this...
+  const int WAIT_MS = 2000;                 // ...for at most this long (covers the first frame after boot)
+  const int TASK_STACK = 4096;
+  const int TASK_PRIORITY = 2;              // Above the analysis and stream tasks
+}
+
+// Backend circuit breaker
+namespace BreakerConfig {
+  const int FAILURE_THRESHOLD = 3;          // Consecutive failures before opening
+  const int BASE_BACKOFF_MS = 5000;         // First open period
+  const int MAX_BACKOFF_MS = 120000;        // Backoff cap
+  const int JITTER_PERCENT = 20;            // +/- randomization of each backoff
+  const int PROBE_TIMEOUT = 5000;           // testConnection timeout when probing
+  const int PROBE_POLL_MS = 1000;           // How often the idle worker checks for a due probe
+}
+
+// Closed-loop JPEG quality / frame size control
+namespace AdaptiveConfig {
+  const bool ENABLED = true;
+  const int TARGET_LATENCY_MS = 4000;       // Desired httpDuration per analysis
+  const int HYSTERESIS_PERCENT = 25;        // Deadband around the target
+  const float EWMA_ALPHA = 0.3f;            // Weight of the newest sample
+  const int DOWN_STREAK = 2;                // Slow samples before stepping down
+  const int UP_STREAK = 4;                  // Fast samples before stepping up
+  const int COOLDOWN_MS = 20000;            // Minimum time between changes
+  const int MIN_RSSI_FOR_UPGRADE = -75;     // Don't grow frames on a weak link
+}
+
+// Event-driven HTTP server (esp_http_server) on WEB_SERVER_PORT
+namespace HttpConfig {
+  const int MAX_OPEN_SOCKETS = 9;           // Every /events listener and deferred slot, plus two for plain requests
+  const int MAX_URI_HANDLERS = 18;
+  const int TASK_STACK = 8192;              // Status JSON is built on the server task
+  const int TASK_PRIORITY = 5;              // esp_http_server default
+  const int MAX_DEFERRED = 4;               // Slow requests (analyze, capture, test, camera config) in flight at once
+  const int WORK_TASK_STACK = 8192;         // Runs TLS uploads for GET /api/analyze and /test
+  const int WORK_TASK_PRIORITY = 1;
+  const int JSON_BUFFER = 512;              // Stack buffer per JSON response; larger bodies go out chunked
+  const int DEFERRED_BODY_SIZE = 1024;      // JSON body held in each deferred slot
+  const int DEFERRED_DETAIL_CHARS = 256;    // Debug text kept when a verdict overflows the slot
+  const int SEND_RETRY_MS = 10;             // Resume a deferred response whose socket was full
+  const int STALL_TIMEOUT_MS = 10000;       // Drop a client whose socket stays full this long
+}
+
+// MJPEG live stream (served on its own port; /stream on port 80 redirects)
+namespace StreamConfig {
+  const int PORT = 81;
+  const int MAX_VIEWERS = 4;                // Bounds memory: at most MAX_VIEWERS + 1 frames held
+  const int MAX_FPS = 10;                   // Capture pacing
+  const int SEND_SLICE = 4096;              // Bytes offered to one viewer's socket per round
+  const int STALL_TIMEOUT_MS = 10000;       // Drop a viewer whose socket stays full this long
+  const int REQUEST_TIMEOUT_MS = 500;       // Time allowed for a viewer's request head
+  const int MAX_PENDING = 2;                // Connections still sending their request head
+  const int IDLE_POLL_MS = 50;              // Accept poll interval with no viewers
+  const int TASK_STACK = 4096;
+  const int TASK_PRIORITY = 1;
+}
+
+// Server-Sent Events push channel (GET /events)
+namespace EventsConfig {
+  const int MAX_CLIENTS = 3;                // Each listener holds one of HttpConfig::MAX_OPEN_SOCKETS
+  const int MAX_EVENT_SIZE = 512;           // Latest JSON payload kept per event type
+  const int CLIENT_BACKLOG = 1024;          // Unsent bytes per listener; newer states coalesce beyond this
+  const int SAMPLE_INTERVAL_MS = 250;       // How often loop() looks for state changes
+  const int KEEPALIVE_MS = 15000;           // Comment line on idle connections
+  const int STALL_TIMEOUT_MS = 10000;       // Drop a listener whose socket stays full this long
+  const int RETRY_MS = 2000;                // Browser reconnect delay sent in the stream head
+  const int RSSI_DELTA = 5;                 // dBm change that counts as a WiFi event
+  const int HEAP_DELTA = 4096;              // Free-heap change reported while below the threshold
+}
+
+// Prometheus-style /metrics registry (fixed slots, registered at startup)
+namespace MetricsConfig {
+  const int MAX_COUNTERS = 16;
+  const int MAX_GAUGES = 12;
+  const int MAX_HISTOGRAMS = 24;            // Includes one per HTTP route
+  const int MAX_BUCKETS = 12;               // Upper bounds per histogram (+Inf is extra)
+  const int WRITE_BUFFER = 1024;            // Exposition text is sent in chunks of this size
+}
+
+// On-device motion gate in front of the backend (thresholds: MotionParams)
+namespace MotionConfig {
+  const bool ENABLED = true;
+  const bool GATE_UPLOADS = true;           // Skip the upload when nothing moved within HOLD_MS
+  const bool AUTO_ANALYZE = true;           // Queue an analysis when motion starts
+  const int SAMPLE_FPS = 5;                 // Frames the detector looks at per second
+  const int HOLD_MS = 10000;                // Motion this recent still opens the gate
+  const int TRIGGER_COOLDOWN_MS = 15000;    // Minimum time between motion-started analyses
+  const int TASK_STACK = 4096;
+  const int TASK_PRIORITY = 1;
+}
+
+// Backend wire format
+namespace ProtocolConfig {
+  const bool USE_COMPACT = false;           // true = binary body + verdict on COMPACT_ENDPOINT
+  const char* const COMPACT_ENDPOINT = "/api/Camera/analyze-compact";
+  const uint32_t FRAME_MAGIC = 0x31464248;  // "HBF1"
+  const uint32_t VERDICT_MAGIC = 0x31564248; // "HBV1"
+  const uint8_t VERSION = 1;
+}
+
+// Chunked uploads of frames that need JPEG encoding (non-JPEG PIXEL_FORMAT)
+namespace UploadConfig {
+  const int JPEG_QUALITY = 80;              // frame2jpg_cb scale: 1-100, higher is better
+  const int CHUNK_SIZE = 1024;              // Max payload per HTTP chunk
+  const int PIPE_SIZE = 4096;               // Encoder -> uploader stream buffer
+  const int PIPE_WAIT_MS = 100;             // Send/receive wait; also the abort latency
+  const int ENCODER_TASK_STACK = 6144;      // jpge::jpeg_encoder lives on this stack
+}
+
+// Reduced-size previews served by /capture?scale=2|4|8
+namespace ThumbnailConfig {
+  const int JPEG_QUALITY = 70;              // fmt2jpg_cb scale: 1-100, higher is better
+  const int INITIAL_BUFFER = 4096;          // First allocation for a cached thumbnail; doubles as needed
+}
+
+// Ring of recent frames served at /history (PSRAM, allocated at camera init)
+namespace HistoryConfig {
+  const bool ENABLED = true;
+  const int SLOTS = 12;                     // Frames kept; pinned slots are skipped, not overwritten
+  const int SLOT_BYTES = 64 * 1024;         // Larger frames aren't recorded (SVGA at quality 20 is ~30-50 KB)
+  const int MIN_INTERVAL_MS = 250;          // At most 4 frames/s, so the ring spans ~3 s or more
+}
+
+// Perceptual-hash cache of recent verdicts
+namespace CacheConfig {
+  const bool ENABLED = true;
+  const int ENTRIES = 8;                    // Distinct scenes remembered
+  const int MAX_DISTANCE = 6;               // dHash bits (of 64) that may differ on a hit
+  const int TTL_MS = 30000;                 // A verdict is reused for at most this long
+}
+
+// Store-and-forward spool for frames captured while the backend is unreachable
+namespace SpoolConfig {
+  const bool ENABLED = true;
+  const bool USE_SD_CARD = false;           // false = LittleFS on the flash partition
+  const char* const DIRECTORY = "/spool";
+  const int MAX_BYTES = 1024 * 1024;        // Oldest segment is evicted beyond this
+  const int SEGMENT_SIZE = 256 * 1024;      // Eviction granularity
+  const uint32_t RECORD_MAGIC = 0x4C4F5053; // "SPOL"
+  const int DRAIN_BATCH = 4;                // Frames uploaded per idle tick
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,305 @@
+// ============================================================================
+// dashboard_page.h - Gzip-compressed dashboard (generated - do not edit)
+// ============================================================================
+// Generated by tools/build_dashboard.py from HTML_MAIN_PAGE in
+// html_templates.h. Edit the template and re-run the script.
+#ifndef DASHBOARD_PAGE_H
+#define DASHBOARD_PAGE_H
+
+#include <Arduino.h>
+
+const char DASHBOARD_ETAG[] = "\"a0c26109\"";
+const size_t DASHBOARD_RAW_LENGTH = 15740;
+const size_t DASHBOARD_GZ_LENGTH = 4589;
+
+const uint8_t DASHBOARD_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x3b, 0xdb, 0x6e, 0x1b, 0x49,
+  0x76, 0xef, 0xfc, 0x8a, 0xf2, 0xd8, 0x3b, 0x4d, 0xae, 0x45, 0xea, 0x6e, 0x69, 0x48, 0x49, 0x81,
+  0x2c, 0xc9, 0x6b, 0x2f, 0x64, 0x8f, 0x21, 0xd1, 0x49, 0x06, 0xd9, 0x00, 0x2a, 0x76, 0x57, 0x93,
+  0x3d, 0x6e, 0x76, 0x75, 0xba, 0xab, 0x45, 0x71, 0x64, 0x3e, 0xe6, 0x6d, 0x92, 0x0d, 0x36, 0x8b,
+  0x04, 0x08, 0xb2, 0x98, 0x0c, 0xb0, 0xd9, 0x3c, 0x06, 0x79, 0x09, 0xf6, 0x69, 0x3f, 0x66, 0x7f,
+  0x20, 0xf3, 0x09, 0x39, 0xa7, 0x2e, 0xdd, 0xd5, 0x17, 0x52, 0xf4, 0x78, 0x91, 0xd0, 0xb0, 0xcd,
+  0xae, 0xae, 0x3a, 0xe7, 0xd4, 0xb9, 0x9f, 0x53, 0xc5, 0xd6, 0xd1, 0xa3, 0xf3, 0x2f, 0xcf, 0x86,
+  0x5f, 0xbd, 0xbd, 0x20, 0x13, 0x31, 0x0d, 0x4f, 0x8e, 0xf4, 0xbf, 0x8c, 0x7a, 0x27, 0x47, 0x22,
+  0x10, 0x21, 0x3b, 0xb9, 0xb8, 0x7e, 0xbb, 0xbb, 0xd3, 0x3d, 0x3b, 0x7d, 0x4d, 0x5e, 0xf2, 0x88,
+  0xcd, 0xc9, 0x73, 0xea, 0x8d, 0x59, 0x42, 0xce, 0x99, 0x60, 0xae, 0xe0, 0xc9, 0xd1, 0xa6, 0x9a,
+  0xd6, 0x3a, 0x9a, 0x32, 0x41, 0x49, 0x44, 0xa7, 0xec, 0xd8, 0xb9, 0x0d, 0xd8, 0x2c, 0xe6, 0x89,
+  0x70, 0x88, 0xcb, 0x23, 0xc1, 0x22, 0x71, 0xec, 0xcc, 0x02, 0x4f, 0x4c, 0x8e, 0x3d, 0x76, 0x1b,
+  0xb8, 0xac, 0x2b, 0x1f, 0x36, 0x82, 0x28, 0x10, 0x01, 0x0d, 0xbb, 0xa9, 0x4b, 0x43, 0x76, 0xbc,
+  0xed, 0x00, 0x8c, 0x54, 0xcc, 0x11, 0xd6, 0x88, 0x7b, 0xf3, 0x7b, 0x1f, 0x96, 0x76, 0x7d, 0x3a,
+  0x0d, 0xc2, 0x79, 0xff, 0x34, 0x81, 0x89, 0x03, 0xc1, 0xee, 0x44, 0x97, 0x86, 0xc1, 0x38, 0xea,
+  0xbb, 0x00, 0x94, 0x25, 0x83, 0x98, 0x7a, 0x5e, 0x10, 0x8d, 0xfb, 0x3b, 0x5b, 0xf1, 0xdd, 0x60,
+  0x44, 0xdd, 0xf7, 0xe3, 0x84, 0x67, 0x91, 0xd7, 0x7f, 0xec, 0xef, 0xe1, 0x9f, 0xc1, 0x94, 0x26,
+  0xe3, 0x20, 0xea, 0x6f, 0x2d, 0x5a, 0x3d, 0xa4, 0x84, 0x06, 0x11, 0x4b, 0xee, 0xa7, 0xf4, 0x4e,
+  0x51, 0xd0, 0x3f, 0xdc, 0xc2, 0x75, 0x66, 0x12, 0xa1, 0x99, 0xe0, 0x36, 0x94, 0xd9, 0x24, 0x10,
+  0xac, 0x82, 0x83, 0x27, 0x1e, 0x4b, 0xba, 0x09, 0xf5, 0x82, 0x2c, 0xed, 0x6f, 0xab, 0xa1, 0xbb,
+  0x6e, 0x3a, 0xa1, 0x1e, 0x9f, 0x01, 0x88, 0xbd, 0xf8, 0x8e, 0x1c, 0xc2, 0xdf, 0x64, 0x3c, 0xa2,
+  0xed, 0xad, 0x0d, 0xf9, 0xa7, 0xb7, 0xdd, 0x59, 0xb4, 0x26, 0xdb, 0xf7, 0x2e, 0x0f, 0x79, 0xd2,
+  0x7f, 0xbc, 0xbb, 0xbb, 0xab, 0x51, 0x76, 0x47, 0x5c, 0x08, 0x3e, 0xed, 0xef, 0x02, 0x98, 0x45,
+  0x6b, 0x94, 0xc1, 0x43, 0x74, 0x6f, 0xef, 0x62, 0xef, 0xec, 0xf4, 0xc5, 0xfe, 0xd6, 0x40, 0x2d,
+  0x2c, 0x53, 0xb3, 0xbd, 0x0f, 0x58, 0x76, 0x0b, 0x92, 0xfa, 0x11, 0x48, 0xa7, 0x42, 0xde, 0x61,
+  0xb1, 0x39, 0x49, 0xa9, 0x9b, 0x25, 0x29, 0x00, 0x8a, 0x79, 0x20, 0x99, 0x27, 0x19, 0x9c, 0x06,
+  0xdf, 0xb0, 0xfe, 0xf6, 0xb3, 0xea, 0x3e, 0x76, 0x00, 0xfa, 0x5e, 0x75, 0x1f, 0x3b, 0x1d, 0x43,
+  0x65, 0x7f, 0xc2, 0x6f, 0x81, 0x93, 0x25, 0x5a, 0xf7, 0xe9, 0xd6, 0xde, 0x17, 0x03, 0x91, 0xd0,
+  0x28, 0xf5, 0x79, 0x32, 0xed, 0xcb, 0x6f, 0x21, 0x15, 0xec, 0xab, 0x76, 0x17, 0xc0, 0x75, 0xd4,
+  0x2b, 0x10, 0x39, 0x2c, 0x07, 0x58, 0x69, 0x0e, 0xcb, 0x0b, 0x52, 0x3a, 0x0a, 0x99, 0x57, 0x02,
+  0xe7, 0xba, 0xae, 0xa1, 0x37, 0xe2, 0x28, 0xf5, 0x90, 0xcf, 0x98, 0x67, 0x81, 0xc7, 0xfd, 0x82,
+  0x58, 0x05, 0x4b, 0x45, 0x77, 0x24, 0xca, 0x7c, 0xdb, 0xd9, 0xfe, 0xe2, 0xd9, 0x8b, 0xdd, 0x81,
+  0xf5, 0xba, 0x81, 0xe0, 0xed, 0x2f, 0x0e, 0x9e, 0x9d, 0xef, 0xe0, 0x24, 0x37, 0x64, 0x34, 0xa9,
+  0x01, 0xf1, 0xfd, 0x2f, 0x40, 0x3f, 0x4a, 0xef, 0x1b, 0xa0, 0xf8, 0xfb, 0x07, 0xae, 0x9a, 0x95,
+  0xd1, 0xa4, 0x4e, 0xc9, 0xb3, 0x83, 0x5d, 0x3a, 0x3a, 0xb0, 0x5f, 0x37, 0xc0, 0xd8, 0xdf, 0xde,
+  0xf1, 0xe8, 0x21, 0x4c, 0x7a, 0x9c, 0x0a, 0x2a, 0xb2, 0xf4, 0x5e, 0x0b, 0x0d, 0x35, 0x8e, 0x6c,
+  0x95, 0x44, 0xde, 0x20, 0x61, 0x4b, 0x8c, 0xf9, 0xe3, 0x8c, 0x05, 0xe3, 0x89, 0xe8, 0x8f, 0x78,
+  0xe8, 0x01, 0xea, 0x04, 0xcc, 0x79, 0x5e, 0xc2, 0xc8, 0x0e, 0xfc, 0x03, 0x76, 0xa0, 0x15, 0xeb,
+  0xf1, 0x0e, 0x3b, 0xf0, 0x76, 0x77, 0x60, 0x62, 0x9c, 0x70, 0x97, 0xa5, 0x29, 0x20, 0xab, 0x70,
+  0xc2, 0xdf, 0x75, 0x3d, 0x33, 0xfb, 0x70, 0xff, 0xd9, 0xde, 0xd6, 0x1e, 0xcc, 0xf6, 0xa4, 0x0b,
+  0xa8, 0xc8, 0xcd, 0xdb, 0x63, 0x9e, 0x47, 0xcd, 0xdc, 0xed, 0xfd, 0xfd, 0x83, 0x1d, 0x9c, 0x8b,
+  0x32, 0x6c, 0x9c, 0xef, 0x1f, 0x7a, 0x07, 0xc5, 0xfc, 0x83, 0x9d, 0x6d, 0x57, 0xce, 0x67, 0x49,
+  0xc2, 0x93, 0x75, 0x26, 0x06, 0x91, 0xcf, 0xcb, 0x5b, 0x3b, 0xc4, 0x3f, 0x03, 0xcb, 0xd8, 0x2c,
+  0x06, 0xed, 0xe5, 0x16, 0xd1, 0x15, 0x3c, 0x56, 0x26, 0x6d, 0x79, 0x95, 0x90, 0xf9, 0xa2, 0x60,
+  0xb7, 0xb4, 0x4a, 0x25, 0xb7, 0x98, 0x46, 0x2c, 0x2c, 0x93, 0xb3, 0xcb, 0xf6, 0xfd, 0x7d, 0x63,
+  0x7c, 0x68, 0x2e, 0x29, 0x0f, 0x03, 0x8f, 0x18, 0x89, 0xd7, 0xe5, 0x54, 0x12, 0x63, 0x49, 0xc2,
+  0x06, 0x8b, 0x96, 0x7e, 0x55, 0x82, 0xb6, 0x0d, 0xdb, 0xea, 0x50, 0xf3, 0x79, 0xbe, 0x5f, 0x41,
+  0xbb, 0x5f, 0xec, 0xc0, 0xe5, 0xd3, 0x29, 0x8d, 0xbc, 0xfb, 0x82, 0x19, 0x3b, 0x7b, 0x0d, 0xda,
+  0x62, 0xf8, 0xa6, 0x76, 0x21, 0x85, 0x3c, 0xca, 0xc6, 0xdd, 0x90, 0x97, 0x35, 0x62, 0x9b, 0xe1,
+  0x1f, 0x33, 0x79, 0x6b, 0xcb, 0xf7, 0xc1, 0x06, 0x6c, 0x87, 0x3d, 0xe5, 0x11, 0x4f, 0x63, 0xea,
+  0x32, 0x9b, 0xfb, 0x3b, 0xab, 0xb8, 0x5d, 0xe3, 0x4a, 0xa3, 0x33, 0xbb, 0xeb, 0x4e, 0x14, 0xb1,
+  0x7b, 0xd2, 0x75, 0xa3, 0x29, 0xf9, 0xe0, 0x19, 0xba, 0xf3, 0xbe, 0x74, 0xde, 0xd2, 0x47, 0x76,
+  0x25, 0xe2, 0x7e, 0x9c, 0x40, 0xa0, 0x49, 0x68, 0x3c, 0x98, 0x01, 0x1c, 0xf9, 0xad, 0x3f, 0x02,
+  0x4b, 0x78, 0xdf, 0xc5, 0x67, 0xd8, 0x19, 0xec, 0xa9, 0x8b, 0x81, 0x0e, 0x8c, 0x51, 0xef, 0x03,
+  0x19, 0xb8, 0x84, 0xf9, 0xc6, 0x55, 0x6b, 0xa5, 0x10, 0xc1, 0x14, 0x1c, 0x0b, 0x9d, 0xc6, 0x66,
+  0xe9, 0xe1, 0xe1, 0xe1, 0xa2, 0x75, 0xb4, 0xa9, 0xe2, 0xd7, 0xd1, 0xa6, 0x0c, 0xa0, 0xad, 0x23,
+  0x8c, 0x63, 0x27, 0x47, 0x5e, 0x70, 0x4b, 0xdc, 0x90, 0xa6, 0xe9, 0xb1, 0x93, 0x07, 0x21, 0x0c,
+  0x76, 0x93, 0xed, 0x93, 0x1f, 0xbe, 0xfb, 0xdd, 0xf7, 0xcb, 0xe2, 0x2a, 0xbc, 0x6e, 0xc9, 0xb5,
+  0x12, 0xe8, 0xb1, 0x53, 0x26, 0x04, 0x79, 0x84, 0x40, 0x94, 0x0f, 0x25, 0x81, 0x77, 0xec, 0x28,
+  0xfb, 0x7a, 0x2e, 0x22, 0x87, 0xf0, 0xc8, 0x0d, 0x03, 0xf7, 0x3d, 0x20, 0xa4, 0xb1, 0xc8, 0x12,
+  0x76, 0x1a, 0x79, 0xa7, 0x11, 0x0d, 0xe7, 0xdf, 0xb0, 0x76, 0xc7, 0x39, 0x51, 0x38, 0x4a, 0x78,
+  0x8f, 0x36, 0x15, 0xa0, 0x02, 0xa2, 0xa6, 0xd8, 0x38, 0x50, 0x0b, 0xe6, 0x2c, 0x88, 0x20, 0x48,
+  0xf4, 0x78, 0xcc, 0xa2, 0xf6, 0x67, 0xb0, 0x65, 0x60, 0xea, 0xf4, 0x33, 0x00, 0x7b, 0x19, 0xdc,
+  0x32, 0x72, 0x2d, 0x1f, 0x3f, 0x06, 0x1c, 0x0e, 0x9d, 0xf1, 0x28, 0x02, 0x92, 0x20, 0x34, 0x20,
+  0x7d, 0x43, 0x18, 0x21, 0xc5, 0xd0, 0x52, 0x60, 0xb9, 0x5f, 0xb6, 0x37, 0x8c, 0x63, 0x97, 0x7c,
+  0x8c, 0x70, 0xce, 0xf0, 0x3b, 0x81, 0x07, 0x0b, 0xc2, 0x26, 0x70, 0x54, 0xf3, 0x15, 0x79, 0xa6,
+  0x4c, 0xce, 0x31, 0x10, 0xa5, 0xa7, 0x74, 0x4e, 0xae, 0xf0, 0x3f, 0x22, 0x38, 0xd1, 0xec, 0x23,
+  0x60, 0x39, 0xf0, 0x57, 0x32, 0x50, 0x43, 0x68, 0xd9, 0x62, 0x2d, 0x7c, 0x84, 0x94, 0xeb, 0x2e,
+  0xc8, 0xf5, 0x1f, 0xbf, 0x27, 0xa7, 0x89, 0x97, 0x05, 0x11, 0x27, 0xef, 0x4e, 0xaf, 0x86, 0xb0,
+  0x9d, 0xe9, 0x34, 0x8b, 0x02, 0x97, 0xaa, 0x1d, 0xc1, 0x9c, 0x3a, 0x04, 0x43, 0x0c, 0x12, 0x86,
+  0x03, 0xd7, 0xea, 0x59, 0xcd, 0x3c, 0x51, 0x4f, 0x7d, 0x72, 0x04, 0xea, 0x1d, 0xe5, 0x73, 0x5e,
+  0x41, 0x12, 0x65, 0xe6, 0x5d, 0x72, 0x8a, 0xb6, 0xd4, 0xeb, 0xf5, 0x40, 0x13, 0x61, 0xd2, 0x89,
+  0xb5, 0xdb, 0x93, 0x4b, 0x2a, 0x99, 0x2a, 0xbd, 0x80, 0x01, 0x62, 0x23, 0xd7, 0x0e, 0xa2, 0xc0,
+  0x8e, 0x0b, 0xf4, 0x7c, 0xe7, 0xa4, 0xdb, 0x00, 0x71, 0x08, 0x46, 0x40, 0xae, 0x83, 0xc8, 0x65,
+  0x04, 0xe7, 0x56, 0x29, 0xc3, 0xd7, 0xf2, 0x6d, 0x7d, 0xb5, 0xfe, 0xaf, 0x2c, 0x4d, 0x13, 0x20,
+  0x2b, 0xaa, 0x81, 0xdc, 0xcb, 0x95, 0x02, 0x1f, 0x2c, 0x61, 0xd6, 0xad, 0x03, 0xbd, 0xba, 0x74,
+  0x8c, 0x15, 0xb7, 0x63, 0xdc, 0xda, 0xb3, 0x67, 0xc0, 0x4e, 0x99, 0xd2, 0x92, 0xe1, 0x5f, 0xf6,
+  0xc9, 0xdb, 0x20, 0xaa, 0x52, 0x7d, 0x57, 0x90, 0x4b, 0x3e, 0x10, 0x35, 0xf5, 0xaa, 0x71, 0xea,
+  0x55, 0x79, 0xea, 0x73, 0x9a, 0x79, 0x55, 0x1e, 0xe0, 0x58, 0x31, 0xa9, 0x55, 0xde, 0x7f, 0x49,
+  0x01, 0x30, 0x8e, 0xa9, 0x0c, 0x38, 0xe1, 0xd1, 0xf8, 0xe4, 0x7a, 0x9e, 0x0a, 0x36, 0x25, 0x5a,
+  0xe6, 0xe8, 0x58, 0xe4, 0xf0, 0xd1, 0x28, 0xd1, 0xe4, 0xcb, 0x8c, 0xfc, 0xd5, 0x5b, 0x1b, 0x21,
+  0x82, 0x78, 0x15, 0x5b, 0xdc, 0xc6, 0xc9, 0xcf, 0xc1, 0x6b, 0xb3, 0xc8, 0xab, 0xce, 0xd3, 0xc3,
+  0x95, 0xc9, 0x7f, 0x11, 0xbc, 0x08, 0x40, 0xa2, 0x63, 0xd0, 0xf4, 0xea, 0x02, 0x35, 0x6a, 0x6d,
+  0xd8, 0x7b, 0x3e, 0x95, 0x6b, 0xde, 0xc5, 0xe8, 0x0c, 0xab, 0xd3, 0xd5, 0xa8, 0x35, 0x3d, 0x65,
+  0xe0, 0xfb, 0xbc, 0x54, 0x2e, 0x79, 0xcd, 0xa6, 0x3c, 0x99, 0x57, 0x97, 0xa8, 0x51, 0x6b, 0xc9,
+  0x68, 0x0e, 0xf2, 0x27, 0x7e, 0xc2, 0x58, 0xc9, 0x6c, 0x35, 0xc3, 0xf2, 0xc0, 0xe4, 0x94, 0xc7,
+  0x0b, 0xb7, 0xee, 0x80, 0x19, 0xfe, 0xfa, 0xef, 0xc0, 0xa3, 0xc2, 0x44, 0xe5, 0x05, 0xca, 0xb6,
+  0x0f, 0x33, 0xcf, 0x54, 0x79, 0xe2, 0x18, 0x7e, 0x4b, 0xfb, 0xef, 0x91, 0x33, 0x54, 0x3f, 0xf2,
+  0x59, 0xc5, 0x0f, 0x7d, 0x86, 0x1e, 0x01, 0x02, 0x4e, 0xe0, 0xcf, 0xc9, 0x48, 0xf1, 0x0f, 0xeb,
+  0x1b, 0xf9, 0xf6, 0x36, 0x10, 0xf3, 0x5e, 0x45, 0xbd, 0xf5, 0x7f, 0xa9, 0x9b, 0x04, 0xb1, 0x38,
+  0x69, 0x85, 0x4c, 0x90, 0x20, 0x7d, 0x9b, 0xa7, 0x58, 0xe4, 0x98, 0xf8, 0x34, 0x4c, 0xd9, 0x40,
+  0xbe, 0xe1, 0xb3, 0x48, 0x7a, 0xe8, 0x34, 0x48, 0x4f, 0x05, 0xbc, 0xda, 0x1a, 0xb4, 0x5a, 0x7e,
+  0x16, 0x49, 0xc4, 0x04, 0x62, 0x24, 0xba, 0x34, 0x88, 0x39, 0x29, 0x1d, 0xb3, 0x0d, 0x00, 0x73,
+  0x81, 0xf9, 0x91, 0x81, 0xd0, 0x21, 0xf7, 0x2d, 0x02, 0x1f, 0x20, 0x06, 0x08, 0x2e, 0xb6, 0x05,
+  0xef, 0x3d, 0xee, 0x66, 0x53, 0xf8, 0xda, 0x1b, 0x33, 0x71, 0x11, 0x32, 0xfc, 0xfa, 0x7c, 0xfe,
+  0xca, 0x6b, 0xdb, 0x9b, 0xef, 0x0c, 0xac, 0xd5, 0x79, 0x64, 0x83, 0xc5, 0x11, 0x9b, 0x91, 0x73,
+  0x48, 0xe0, 0xdb, 0x9d, 0x9e, 0xe0, 0x97, 0x1c, 0xcb, 0x34, 0x69, 0xd4, 0x22, 0x01, 0xf2, 0xdb,
+  0xa5, 0x65, 0xd2, 0xbe, 0x60, 0x89, 0xa1, 0xec, 0xcf, 0x88, 0x03, 0xe1, 0x74, 0x0f, 0x3e, 0x0e,
+  0xe9, 0xc3, 0x77, 0x95, 0x22, 0x38, 0x6a, 0x49, 0x81, 0x1b, 0xd2, 0x37, 0x08, 0x86, 0x2f, 0x87,
+  0xaf, 0x2f, 0xc9, 0xd3, 0x63, 0x72, 0x53, 0xf2, 0x4a, 0x39, 0x25, 0xce, 0xc9, 0x5f, 0x3d, 0xb9,
+  0xcf, 0x9f, 0x16, 0x7f, 0x6d, 0xf4, 0x43, 0xcd, 0xd6, 0xf6, 0xaf, 0x0c, 0xfc, 0x89, 0x8a, 0xc7,
+  0x0b, 0xe7, 0xe4, 0xc9, 0xbd, 0xe6, 0xd6, 0x42, 0x4f, 0xff, 0x45, 0x74, 0x53, 0xc3, 0x0e, 0xa2,
+  0xe1, 0x61, 0x38, 0xe4, 0xb8, 0xd9, 0xda, 0xf0, 0x4b, 0x99, 0x04, 0x0c, 0x5a, 0x0b, 0x4b, 0x10,
+  0x45, 0x74, 0xd1, 0x2c, 0x5f, 0x8b, 0xbf, 0xd6, 0x2e, 0x8f, 0x89, 0x03, 0xcb, 0x15, 0x1c, 0xe6,
+  0xf5, 0x7e, 0x11, 0x39, 0x12, 0x01, 0x6a, 0x00, 0xec, 0x5a, 0x3a, 0x3b, 0x64, 0x7c, 0x16, 0x86,
+  0x83, 0xd2, 0x60, 0x5d, 0x27, 0x12, 0x50, 0x3f, 0x96, 0xe0, 0x3b, 0xe5, 0x24, 0xda, 0x2a, 0x7a,
+  0x18, 0xc2, 0x36, 0x37, 0xc9, 0xf5, 0x84, 0xcf, 0x08, 0x75, 0x45, 0x46, 0x43, 0xa2, 0x0a, 0xef,
+  0x5c, 0x5d, 0x39, 0xf2, 0x0d, 0xa7, 0x6f, 0x10, 0xc8, 0xcc, 0xc9, 0xd7, 0x99, 0xf6, 0xad, 0x44,
+  0xd7, 0xe4, 0xc1, 0x37, 0x32, 0x4e, 0x59, 0x02, 0x0e, 0x52, 0x6d, 0x08, 0xcc, 0x03, 0x4a, 0xd4,
+  0xe2, 0x5e, 0x3e, 0x1b, 0x06, 0x3f, 0xff, 0xdc, 0x8c, 0x2a, 0x5c, 0xf9, 0xf4, 0xc1, 0x6a, 0x46,
+  0x55, 0x82, 0x18, 0xa8, 0x1a, 0x64, 0x88, 0x85, 0x02, 0xcb, 0xc5, 0xf8, 0xb1, 0x09, 0x00, 0xed,
+  0xca, 0x1f, 0x50, 0xbf, 0xda, 0x0d, 0xf4, 0xc0, 0x9c, 0x37, 0xdc, 0xc4, 0x60, 0xa9, 0x84, 0xe7,
+  0x41, 0xea, 0xe6, 0xab, 0x3a, 0x1f, 0x4b, 0x96, 0xd4, 0xb3, 0x9e, 0xd1, 0xf3, 0x65, 0x64, 0x8d,
+  0xc1, 0x5b, 0x45, 0x12, 0x1b, 0x88, 0x57, 0xab, 0x3b, 0x7e, 0x1e, 0x46, 0x66, 0x87, 0xdb, 0xa5,
+  0x4c, 0xd0, 0xfb, 0x0c, 0x8b, 0xb9, 0xe4, 0x04, 0xf4, 0x02, 0x30, 0x37, 0xbc, 0xe9, 0x23, 0x07,
+  0x22, 0xa6, 0xa9, 0x30, 0x5a, 0x81, 0xea, 0x87, 0x86, 0xad, 0xe3, 0x7d, 0x0a, 0xd1, 0x36, 0x9c,
+  0x93, 0xc0, 0x37, 0x2a, 0x12, 0xa4, 0x5a, 0x67, 0x60, 0x34, 0x67, 0x97, 0x5c, 0x0c, 0x73, 0xda,
+  0xf6, 0x76, 0x0b, 0x89, 0xd7, 0xe8, 0x81, 0x57, 0xb9, 0x3a, 0x7f, 0xfe, 0xf9, 0x0a, 0xf2, 0x65,
+  0x0e, 0xf1, 0xe8, 0xf8, 0x38, 0x9f, 0x5e, 0x7d, 0x69, 0xf4, 0x19, 0x3f, 0xda, 0x0d, 0xde, 0x94,
+  0xb2, 0xab, 0x14, 0x59, 0xe4, 0x9a, 0xbc, 0xe6, 0xc9, 0x7d, 0x1d, 0xc7, 0xe2, 0x46, 0x0b, 0x7b,
+  0x51, 0x30, 0xc2, 0x32, 0x36, 0xb5, 0x60, 0x50, 0x1a, 0x96, 0xe6, 0x86, 0xae, 0x0f, 0x0a, 0xd7,
+  0x99, 0xf1, 0x74, 0x85, 0xc5, 0xe5, 0xa9, 0x0d, 0xbe, 0x02, 0xf3, 0x05, 0xb6, 0x0e, 0x21, 0x62,
+  0xa4, 0xe0, 0x44, 0x5c, 0xc9, 0xb8, 0x11, 0x13, 0x33, 0x50, 0x04, 0x12, 0x67, 0xe9, 0x04, 0x62,
+  0x58, 0xca, 0x89, 0x98, 0x40, 0x16, 0x39, 0x66, 0x88, 0x6d, 0x9e, 0x12, 0x37, 0x4b, 0x00, 0x9a,
+  0x68, 0xb2, 0x66, 0x0b, 0xb6, 0xde, 0x3a, 0xf2, 0xfd, 0x91, 0xa1, 0xac, 0x03, 0x53, 0x21, 0x25,
+  0x8d, 0xaa, 0x3e, 0x5b, 0xe5, 0x61, 0xc7, 0xa4, 0x9d, 0x33, 0x32, 0x1f, 0x45, 0xcd, 0xba, 0x62,
+  0x69, 0x0c, 0x73, 0x19, 0xf9, 0xf0, 0x81, 0x34, 0xcf, 0xd0, 0xcc, 0xea, 0x90, 0xa7, 0xa4, 0x5d,
+  0xec, 0x9c, 0x74, 0x2d, 0x9e, 0x68, 0x3e, 0x20, 0x3d, 0x05, 0xca, 0x23, 0xf2, 0x6c, 0x0b, 0x3e,
+  0xb6, 0x9c, 0x56, 0xea, 0x79, 0x91, 0x16, 0x2e, 0xd5, 0x72, 0xfc, 0xbc, 0xa6, 0x62, 0xd2, 0x83,
+  0xd2, 0x8e, 0x27, 0x16, 0xae, 0x4d, 0xb2, 0x2d, 0x51, 0x3d, 0x25, 0x0e, 0x68, 0xe9, 0x98, 0x6b,
+  0xd5, 0x5e, 0x10, 0x06, 0x51, 0xb0, 0x46, 0xd7, 0xae, 0x24, 0xec, 0xff, 0x8a, 0x32, 0xcd, 0x05,
+  0x20, 0x6d, 0x5a, 0x27, 0xed, 0x93, 0x29, 0x80, 0xa8, 0x01, 0x19, 0x03, 0xe2, 0xb3, 0x81, 0xa3,
+  0xee, 0xd1, 0x74, 0x1e, 0xb9, 0x24, 0x57, 0xa4, 0x2c, 0xf6, 0x40, 0x78, 0x56, 0x58, 0x30, 0xdb,
+  0x17, 0xc9, 0xdc, 0x22, 0x43, 0x29, 0x4e, 0x62, 0xb4, 0xe2, 0x98, 0xd0, 0x19, 0x0d, 0x04, 0xf1,
+  0x99, 0x70, 0x27, 0x6d, 0x67, 0x13, 0x89, 0xd9, 0xd4, 0xe5, 0x48, 0xa7, 0xf0, 0x62, 0xb5, 0x98,
+  0xa3, 0x56, 0x19, 0x30, 0xbd, 0xaf, 0x53, 0x2c, 0xe0, 0x8c, 0xb5, 0x41, 0xf5, 0x04, 0xd0, 0x48,
+  0x5b, 0xf6, 0x72, 0xd6, 0x96, 0xc2, 0x8a, 0x58, 0xe0, 0xc8, 0xdc, 0xc2, 0xf2, 0xaa, 0x3f, 0xd6,
+  0x7b, 0x5b, 0xce, 0xb9, 0x89, 0x87, 0x45, 0xd9, 0xa1, 0x89, 0xd6, 0x8e, 0xc7, 0x91, 0x8e, 0x07,
+  0xb3, 0x42, 0x4c, 0xdf, 0xa4, 0xfb, 0xb0, 0x02, 0xaa, 0xc8, 0xa3, 0x0d, 0x14, 0x60, 0x86, 0x6b,
+  0x3f, 0x92, 0xf5, 0x48, 0x81, 0xcd, 0xf8, 0x7c, 0x4d, 0x16, 0x8a, 0x7c, 0x45, 0x85, 0xed, 0x95,
+  0x60, 0x63, 0x2c, 0x55, 0x2d, 0xea, 0xa5, 0x99, 0x8b, 0x79, 0xa7, 0x2d, 0x06, 0xdb, 0xa5, 0xfe,
+  0xf1, 0x5f, 0xff, 0x56, 0x6d, 0x08, 0x31, 0x13, 0x9d, 0x3a, 0x29, 0xdf, 0x5a, 0xec, 0xeb, 0xc6,
+  0xc2, 0x51, 0x53, 0xec, 0x12, 0xb4, 0xdf, 0x7c, 0x6b, 0x41, 0xf3, 0x69, 0x10, 0x32, 0xe9, 0x9b,
+  0x35, 0x2d, 0x52, 0x21, 0x16, 0x37, 0x1b, 0xc0, 0x98, 0x8c, 0xd9, 0x30, 0xcb, 0x3b, 0x58, 0xae,
+  0x40, 0xcd, 0x78, 0x12, 0xf6, 0x37, 0x59, 0x19, 0x9f, 0x5c, 0xd8, 0x33, 0x89, 0x60, 0x19, 0xe1,
+  0x32, 0xc1, 0xdb, 0xad, 0x88, 0x9a, 0xf8, 0x7f, 0xfd, 0xcf, 0xb9, 0xf8, 0xab, 0x15, 0x00, 0x8f,
+  0x3e, 0x49, 0xec, 0xff, 0x2f, 0x12, 0x3f, 0xb3, 0xb4, 0x17, 0x39, 0xa7, 0x97, 0xf8, 0x59, 0xf8,
+  0x88, 0x98, 0x88, 0x61, 0xc9, 0xcd, 0xa0, 0x3f, 0xe3, 0x1e, 0x5b, 0x40, 0xaa, 0x58, 0xbc, 0xf1,
+  0xb2, 0x44, 0x26, 0x8c, 0x8b, 0x69, 0x6a, 0x2b, 0x49, 0x25, 0x68, 0xff, 0x37, 0x29, 0x15, 0x98,
+  0xf9, 0xea, 0x59, 0xe0, 0x07, 0x6a, 0x70, 0x81, 0x65, 0xe5, 0x47, 0xa9, 0x59, 0x75, 0x0b, 0x6b,
+  0x2b, 0x5b, 0x2d, 0xa1, 0xc8, 0x43, 0xa4, 0x0b, 0xdb, 0x5b, 0xb6, 0xeb, 0x07, 0x95, 0xb6, 0x0c,
+  0xf6, 0xef, 0xff, 0x93, 0x0c, 0x69, 0x02, 0xde, 0x89, 0xbc, 0xbb, 0xba, 0xb4, 0x60, 0x4a, 0x0f,
+  0x73, 0x75, 0xb9, 0xb0, 0xb7, 0x5a, 0xac, 0xfa, 0xd5, 0x1f, 0xc8, 0x0b, 0xc8, 0x23, 0x09, 0x94,
+  0xb1, 0xb1, 0xb5, 0x08, 0x2b, 0xe1, 0x97, 0x30, 0xb4, 0x50, 0x95, 0xf1, 0x4d, 0x55, 0xfe, 0xeb,
+  0xd9, 0xcb, 0xf0, 0x4f, 0x63, 0x2a, 0xa8, 0x8f, 0x2f, 0x78, 0x72, 0x25, 0x49, 0xd3, 0x2a, 0xf7,
+  0x2e, 0x09, 0xad, 0xf2, 0xe3, 0x2d, 0xd4, 0x50, 0x24, 0x8b, 0x44, 0x10, 0xca, 0xe4, 0xa7, 0x68,
+  0x1f, 0x93, 0x19, 0x4f, 0xde, 0xb3, 0x84, 0x4c, 0x28, 0x54, 0xf7, 0x90, 0xb2, 0x43, 0x8a, 0xe4,
+  0xc9, 0x29, 0x5f, 0xf3, 0x91, 0x5c, 0x3c, 0x9b, 0x00, 0x55, 0x10, 0xcb, 0x91, 0x02, 0x7b, 0x17,
+  0xd2, 0x06, 0x30, 0x77, 0x85, 0x22, 0x7a, 0x1a, 0xa4, 0x0c, 0xd1, 0xf2, 0xf0, 0x16, 0x8c, 0x09,
+  0xfb, 0x0b, 0x32, 0x7a, 0xf2, 0x4c, 0x98, 0xd1, 0x0d, 0xb2, 0x0f, 0x01, 0xb9, 0xc9, 0xa4, 0x9a,
+  0x2c, 0xb0, 0xd8, 0xc1, 0xa0, 0x6a, 0x4c, 0xca, 0xe4, 0x54, 0x34, 0x24, 0xc7, 0x90, 0xab, 0xee,
+  0x6c, 0xed, 0x74, 0xe4, 0xc9, 0x66, 0x10, 0x65, 0xec, 0xe1, 0xe9, 0x7b, 0x5b, 0x7b, 0x55, 0x23,
+  0x14, 0x93, 0x04, 0x6a, 0x33, 0xdc, 0x8a, 0x0c, 0x69, 0x6d, 0xc7, 0xd4, 0xfe, 0xc8, 0x03, 0xc2,
+  0xee, 0xe2, 0x20, 0x29, 0x6a, 0x94, 0xb2, 0x96, 0xa9, 0xf4, 0x6f, 0x95, 0x43, 0x68, 0x12, 0x57,
+  0x43, 0x1f, 0xd8, 0x24, 0x97, 0x6d, 0xbb, 0x29, 0x51, 0x4e, 0x2f, 0xd5, 0x8c, 0x72, 0xcf, 0x02,
+  0xa5, 0x62, 0x27, 0x9f, 0x23, 0x11, 0xad, 0xea, 0x33, 0x14, 0x4d, 0xe9, 0x52, 0xbf, 0xc0, 0xb0,
+  0x67, 0xf9, 0xc2, 0x72, 0xf6, 0x21, 0xff, 0x01, 0x54, 0x3d, 0x73, 0x58, 0x58, 0xa2, 0x04, 0x5f,
+  0x54, 0x52, 0x85, 0x82, 0x66, 0x74, 0xcb, 0x6a, 0x9a, 0x2e, 0x0d, 0x64, 0x7f, 0xe1, 0x0d, 0x9d,
+  0xa2, 0x0a, 0x38, 0xc5, 0x91, 0x57, 0x79, 0x52, 0x05, 0xdc, 0x99, 0xe4, 0x1f, 0x72, 0x20, 0x98,
+  0x62, 0x64, 0x2c, 0x1a, 0xc2, 0x25, 0x0c, 0xd5, 0x6c, 0xe1, 0xf7, 0xd8, 0xc1, 0x4b, 0x64, 0xbc,
+  0x98, 0xc8, 0x6e, 0xfb, 0x48, 0x75, 0xf9, 0x15, 0x57, 0xd6, 0x8c, 0x19, 0xa9, 0xd0, 0xa9, 0x61,
+  0x43, 0x4d, 0xd2, 0xe4, 0x77, 0x00, 0xf1, 0xb7, 0xff, 0x40, 0xae, 0x21, 0x38, 0x21, 0x5e, 0x63,
+  0xea, 0x10, 0xc6, 0x37, 0x69, 0x1c, 0x6c, 0xea, 0x36, 0xb6, 0x85, 0x78, 0x8d, 0xe8, 0x64, 0x2d,
+  0x74, 0x36, 0x2a, 0xba, 0x3c, 0x65, 0x62, 0xc2, 0xc1, 0x87, 0x38, 0x6f, 0xbf, 0xbc, 0x1e, 0x3a,
+  0x1b, 0xa5, 0x77, 0xaa, 0x11, 0x97, 0xf6, 0xc9, 0xbd, 0xa3, 0x99, 0xd9, 0x1d, 0xce, 0x63, 0xe6,
+  0xc0, 0x6c, 0x1a, 0xc7, 0xa1, 0x6e, 0x87, 0x6f, 0xa2, 0xf6, 0x3a, 0x85, 0x8a, 0x2f, 0x56, 0x6c,
+  0xce, 0xf8, 0x6a, 0x97, 0x05, 0xb7, 0xa0, 0x05, 0x49, 0x39, 0x4a, 0xd9, 0xb6, 0xb7, 0xa8, 0x0f,
+  0x0d, 0x41, 0xa8, 0x8b, 0x9b, 0x65, 0x71, 0xf3, 0x51, 0x3e, 0x9b, 0xbf, 0x7f, 0xc8, 0x60, 0x6f,
+  0xae, 0x59, 0x72, 0x0b, 0x82, 0x94, 0x6e, 0xb3, 0x09, 0xf9, 0xcd, 0xea, 0x10, 0xa1, 0xf8, 0x8d,
+  0xc6, 0xfe, 0x60, 0x6c, 0x47, 0xd2, 0x60, 0x62, 0x8f, 0x0a, 0x41, 0x5d, 0x70, 0x95, 0xcb, 0x02,
+  0xfa, 0x0f, 0xdf, 0xfd, 0xf6, 0x37, 0xe4, 0xe7, 0x3c, 0x88, 0x98, 0x56, 0x4d, 0xe3, 0x4e, 0x9e,
+  0xdc, 0xe3, 0x72, 0xf8, 0xfb, 0xca, 0x5b, 0x10, 0x1a, 0xca, 0x1e, 0x27, 0x46, 0x6f, 0x3f, 0xc4,
+  0x06, 0xd7, 0xda, 0xd1, 0xf6, 0x87, 0xef, 0xfe, 0xe3, 0x0f, 0x24, 0xf7, 0x53, 0xa0, 0x54, 0x19,
+  0x22, 0x6a, 0x40, 0xd1, 0x56, 0x4f, 0xb1, 0x52, 0xc0, 0x05, 0xd1, 0x5f, 0x3a, 0x6b, 0xb1, 0xa4,
+  0x92, 0xf1, 0x94, 0xc3, 0x0c, 0x82, 0x6d, 0x72, 0xd4, 0xba, 0x0c, 0xe6, 0x82, 0x86, 0x35, 0x3b,
+  0x81, 0x0a, 0x36, 0x37, 0xa0, 0x15, 0x6a, 0xf5, 0xc7, 0x5f, 0xfe, 0xd7, 0xff, 0xfc, 0xfe, 0x97,
+  0x64, 0x88, 0x30, 0x0a, 0x9b, 0x91, 0x9d, 0xed, 0x27, 0xf7, 0x39, 0xe4, 0x4a, 0x7e, 0x63, 0x65,
+  0x5b, 0x13, 0x21, 0xe2, 0x73, 0x9d, 0x05, 0x2d, 0x97, 0x10, 0xe4, 0x8f, 0xba, 0xf3, 0x4e, 0x0a,
+  0xc7, 0x93, 0xa3, 0x69, 0x00, 0x55, 0x41, 0xb8, 0x68, 0x42, 0x5d, 0x40, 0xaa, 0x36, 0x4c, 0x4a,
+  0x1b, 0xfc, 0x97, 0xef, 0xf5, 0x69, 0xc6, 0x72, 0xcc, 0x65, 0x48, 0xeb, 0xe0, 0x4e, 0x27, 0xd8,
+  0xc7, 0x5c, 0x82, 0xd3, 0x91, 0x2a, 0xf9, 0xe7, 0x2c, 0xf1, 0x02, 0x17, 0xdc, 0x98, 0x9c, 0x4a,
+  0x66, 0x81, 0x98, 0x10, 0x8a, 0x22, 0xd3, 0x4d, 0x90, 0x9c, 0xdb, 0xed, 0x88, 0xab, 0xce, 0x94,
+  0x8a, 0x55, 0x1d, 0xe7, 0x21, 0xe4, 0x53, 0x8e, 0x2c, 0xfa, 0x19, 0x88, 0x7a, 0x85, 0x51, 0xfc,
+  0xea, 0xb7, 0xe4, 0x0d, 0x27, 0x6a, 0x2a, 0x49, 0x65, 0xb1, 0x8e, 0xb9, 0x06, 0x76, 0x35, 0xb0,
+  0x99, 0x2f, 0x49, 0x03, 0x8d, 0x95, 0x55, 0xbd, 0x4c, 0x4f, 0x0c, 0x74, 0xfd, 0xf2, 0x74, 0xcc,
+  0x5e, 0xa7, 0xa6, 0xf3, 0xb0, 0x90, 0x6d, 0x07, 0xd4, 0xa9, 0x2c, 0x0e, 0x39, 0xf5, 0x48, 0xfa,
+  0x3e, 0x88, 0x63, 0xe6, 0x3d, 0xa0, 0xda, 0x16, 0xcd, 0xb5, 0xdc, 0xac, 0x9a, 0x9f, 0xe5, 0x16,
+  0x66, 0xbb, 0x96, 0x87, 0x12, 0x59, 0x0b, 0x01, 0x66, 0xaf, 0x55, 0xf8, 0x35, 0xff, 0xf9, 0x72,
+  0x38, 0x7c, 0x5b, 0xcd, 0x73, 0xdd, 0xe6, 0xfc, 0xb6, 0xbc, 0xa5, 0x0a, 0x32, 0x79, 0x08, 0xb3,
+  0x1a, 0x9b, 0x39, 0x81, 0xb1, 0x30, 0xc9, 0x55, 0x1f, 0x8b, 0x2a, 0x95, 0x0e, 0xd7, 0x24, 0xe9,
+  0xab, 0x71, 0xfe, 0xd3, 0xbf, 0xa3, 0x2d, 0x6b, 0x17, 0x9d, 0xd4, 0x0b, 0x99, 0x32, 0xac, 0xb5,
+  0x28, 0x29, 0x3d, 0x34, 0x25, 0x12, 0xac, 0xd2, 0x9b, 0x58, 0x9a, 0x4b, 0xdc, 0x5c, 0x34, 0x0b,
+  0xb6, 0xe6, 0x86, 0xad, 0xcd, 0x07, 0xa9, 0x3c, 0xac, 0x57, 0x67, 0xf5, 0xd5, 0xbd, 0x9b, 0x13,
+  0x98, 0xc8, 0x0f, 0x3c, 0xa6, 0xbb, 0x80, 0xb9, 0x4c, 0xf3, 0xc1, 0x9f, 0xa2, 0x06, 0xe3, 0x41,
+  0xce, 0x8b, 0xe0, 0x8e, 0x79, 0xed, 0xed, 0xa5, 0xa5, 0x10, 0xde, 0x48, 0xf8, 0xf2, 0xcd, 0xc5,
+  0x57, 0xe4, 0xf9, 0xe9, 0xf9, 0xcf, 0x2e, 0xae, 0xc8, 0xf9, 0xc5, 0xf0, 0xe2, 0x6c, 0x78, 0x71,
+  0xfe, 0x08, 0x6b, 0x2d, 0x0d, 0x0d, 0xa9, 0x2f, 0x60, 0x2f, 0x7e, 0x52, 0x2d, 0xfa, 0x1e, 0xe4,
+  0x96, 0xb9, 0x0b, 0xb4, 0x16, 0xc3, 0x96, 0xdd, 0x92, 0x60, 0xde, 0x2a, 0x9a, 0xd0, 0xaa, 0x6d,
+  0xc7, 0xdd, 0xb9, 0x79, 0x20, 0xd0, 0x35, 0xf1, 0xb1, 0xbd, 0x0d, 0xb6, 0x5e, 0x63, 0x66, 0x67,
+  0x5d, 0x6e, 0xa2, 0x41, 0x83, 0xf7, 0x29, 0xe5, 0x7e, 0x3e, 0x3a, 0x99, 0xde, 0x9f, 0x92, 0x99,
+  0xf6, 0xe5, 0xaa, 0xb5, 0x18, 0x0a, 0x24, 0x95, 0xd8, 0xf9, 0xe2, 0x21, 0x92, 0x56, 0xf2, 0xf2,
+  0xc7, 0x54, 0xa1, 0x57, 0x1f, 0x55, 0x80, 0x96, 0xb8, 0xb0, 0x8e, 0xf1, 0x35, 0x6f, 0xdb, 0xea,
+  0x15, 0xe4, 0x36, 0x58, 0x41, 0x6b, 0x5a, 0x97, 0x50, 0x97, 0xca, 0x46, 0xfe, 0xbd, 0x75, 0xd0,
+  0xd3, 0x74, 0x74, 0x6b, 0xde, 0x56, 0x8f, 0x6f, 0x9b, 0xf2, 0xf4, 0x4a, 0xf9, 0x52, 0x81, 0xd0,
+  0x50, 0xc3, 0x34, 0xdc, 0xd3, 0x71, 0x56, 0xa4, 0xfd, 0xd8, 0xd1, 0x39, 0x37, 0x85, 0x85, 0x89,
+  0xf2, 0x78, 0x34, 0x12, 0x87, 0x4c, 0x94, 0xcb, 0xc9, 0xfc, 0x0b, 0xd4, 0xe9, 0xa7, 0x99, 0xe0,
+  0x5d, 0x50, 0x71, 0x96, 0x57, 0x65, 0xd4, 0x17, 0xa0, 0x14, 0xdb, 0x5b, 0xe6, 0xd0, 0xbe, 0x60,
+  0x6b, 0x51, 0x64, 0x43, 0x62, 0x05, 0x55, 0xf7, 0x7d, 0xcd, 0x5b, 0x3f, 0x2a, 0x57, 0x93, 0x75,
+  0x2f, 0xdd, 0x24, 0x3e, 0x75, 0xed, 0x66, 0xb0, 0x6c, 0x6e, 0x85, 0x2d, 0xab, 0x6e, 0xe7, 0x38,
+  0xcb, 0x7c, 0xf8, 0x62, 0x43, 0x46, 0xf0, 0x2d, 0xbb, 0x46, 0xc6, 0xcd, 0x7b, 0x1e, 0x79, 0xcf,
+  0xe6, 0x23, 0x4e, 0x13, 0x08, 0xe6, 0x13, 0x9e, 0x08, 0x37, 0x13, 0xad, 0xbc, 0x28, 0x05, 0xd6,
+  0x5e, 0xdc, 0xc2, 0x97, 0xcb, 0x20, 0x05, 0xec, 0x0c, 0x0a, 0x75, 0x98, 0xec, 0x81, 0xb0, 0xa1,
+  0x0a, 0x32, 0xb5, 0x75, 0x9b, 0xd9, 0x07, 0x35, 0x4c, 0xc6, 0x51, 0x59, 0xf7, 0x3b, 0xd7, 0x78,
+  0x0f, 0xcd, 0xc1, 0xc3, 0xb0, 0xa5, 0x5c, 0x61, 0x90, 0x73, 0x31, 0xc4, 0x70, 0xce, 0x7c, 0x8a,
+  0x29, 0xae, 0x9d, 0xd5, 0xd6, 0x6b, 0xf6, 0x9c, 0x78, 0xf8, 0x26, 0xcf, 0x87, 0x33, 0x79, 0xcf,
+  0xe2, 0x39, 0x95, 0x35, 0xdb, 0xd6, 0xc0, 0x1a, 0x33, 0x27, 0xc6, 0x38, 0x82, 0x8d, 0xa4, 0x4b,
+  0xa8, 0x5f, 0x4a, 0x37, 0x0e, 0x24, 0xda, 0xf4, 0x92, 0xa7, 0xa2, 0x18, 0x2f, 0x0e, 0xa4, 0x40,
+  0xd4, 0xea, 0x0e, 0x47, 0x5b, 0x81, 0x33, 0x44, 0x97, 0x10, 0xaa, 0x87, 0x81, 0xf5, 0xa2, 0xa6,
+  0xfc, 0xfa, 0x74, 0x0c, 0x32, 0xae, 0x18, 0xeb, 0xe6, 0x40, 0xa4, 0x2c, 0xf4, 0xf1, 0x90, 0x11,
+  0x65, 0x1b, 0xb8, 0xa4, 0x2d, 0x63, 0xb1, 0x47, 0xc6, 0xdf, 0xc8, 0x44, 0x8a, 0xf8, 0x09, 0x9f,
+  0x42, 0x65, 0x42, 0xd3, 0x49, 0x67, 0x00, 0x56, 0x08, 0xce, 0x95, 0xdc, 0xd2, 0x10, 0x7c, 0x05,
+  0x2a, 0x32, 0x53, 0xaf, 0x27, 0x2c, 0x61, 0xcd, 0xe7, 0x1e, 0xe7, 0xb0, 0x4e, 0xca, 0xf2, 0x55,
+  0xe4, 0xf3, 0x1f, 0x77, 0xf4, 0x81, 0xa5, 0xae, 0x67, 0xc0, 0xd4, 0x4b, 0x64, 0xbc, 0xa9, 0xf2,
+  0x70, 0xcd, 0xb6, 0xb4, 0xab, 0xa1, 0xef, 0xe8, 0x54, 0x4f, 0x36, 0x70, 0xb8, 0x17, 0xc4, 0x6b,
+  0x02, 0x30, 0x97, 0x77, 0x1a, 0xa1, 0xe8, 0xbe, 0xf4, 0x9a, 0xa0, 0xf4, 0xb5, 0x9e, 0x46, 0x48,
+  0x45, 0x5b, 0x76, 0x4d, 0x60, 0xfa, 0x06, 0x4f, 0x23, 0x30, 0xd3, 0xbc, 0x5c, 0xf3, 0xf0, 0x66,
+  0x78, 0xd7, 0x0c, 0x46, 0xbd, 0x5b, 0x13, 0xc8, 0xd5, 0x0a, 0x20, 0x57, 0xeb, 0x02, 0x91, 0x57,
+  0xb8, 0x96, 0x82, 0xc1, 0xb7, 0x03, 0xdb, 0x3f, 0x6a, 0xa3, 0x51, 0x13, 0x94, 0xe5, 0x54, 0x8f,
+  0xc3, 0x6c, 0xfb, 0xc7, 0x6b, 0x1a, 0x10, 0x01, 0x23, 0x15, 0x09, 0x4b, 0xae, 0x49, 0x5e, 0xa7,
+  0xd4, 0xba, 0x0f, 0x95, 0x93, 0x3a, 0x4b, 0xf6, 0x08, 0x5e, 0x79, 0x25, 0x9b, 0xca, 0x78, 0xb1,
+  0xfc, 0x86, 0x62, 0x66, 0x4e, 0xdc, 0x09, 0x8d, 0xc6, 0xcc, 0xba, 0xa7, 0xa2, 0x22, 0x9d, 0xf4,
+  0x5d, 0x69, 0xf9, 0x20, 0x59, 0xdf, 0xde, 0x94, 0xaf, 0xae, 0x79, 0x96, 0xb8, 0x55, 0x7a, 0x20,
+  0x39, 0xb8, 0xbe, 0xbe, 0xc0, 0x06, 0x81, 0x98, 0x80, 0x9d, 0x8e, 0x12, 0x3e, 0x03, 0x1b, 0xed,
+  0xa3, 0x8b, 0x08, 0x65, 0x17, 0x17, 0x5d, 0x6f, 0xcc, 0xc3, 0x10, 0x5c, 0x99, 0xbd, 0xf3, 0x57,
+  0xf8, 0xa3, 0x02, 0xa0, 0xb7, 0x5d, 0x3d, 0x82, 0xdc, 0x20, 0x3b, 0x85, 0xe3, 0x55, 0xae, 0xa2,
+  0x7a, 0x46, 0x39, 0xa8, 0xb4, 0x37, 0x6b, 0xe7, 0xf5, 0xca, 0xf8, 0xf4, 0xae, 0xd5, 0xcd, 0x24,
+  0x6b, 0x07, 0x60, 0xb6, 0xea, 0x55, 0xa9, 0x97, 0xa6, 0x86, 0x1a, 0x7c, 0x38, 0x0a, 0x0e, 0x1c,
+  0xb8, 0xec, 0x1b, 0xd7, 0x8e, 0x34, 0x7f, 0x7e, 0xfd, 0xe5, 0x9b, 0x5e, 0x4c, 0x93, 0x94, 0x81,
+  0x2f, 0x07, 0x3a, 0x69, 0xa7, 0xb3, 0x16, 0x50, 0xb4, 0x16, 0x03, 0xb4, 0xea, 0x6c, 0xf0, 0x1d,
+  0x50, 0x5d, 0x07, 0xfd, 0x69, 0x56, 0x8a, 0x60, 0x7b, 0xae, 0x75, 0xfd, 0x44, 0x0e, 0x24, 0x10,
+  0x64, 0xf0, 0xee, 0x07, 0xf7, 0x7d, 0x10, 0x91, 0x1d, 0x11, 0x51, 0xfe, 0xe5, 0x35, 0xd5, 0x00,
+  0xfd, 0xb1, 0x7e, 0x4b, 0x42, 0xb3, 0xfd, 0x96, 0x12, 0xd9, 0x62, 0x2d, 0x8e, 0x61, 0x54, 0x5a,
+  0xc6, 0x31, 0x7c, 0xf7, 0x29, 0x1c, 0x5b, 0xe2, 0x8a, 0x10, 0x6c, 0x83, 0x2b, 0x2a, 0xec, 0x56,
+  0x4e, 0x28, 0xd9, 0xad, 0x61, 0x9c, 0x7c, 0x13, 0x42, 0x10, 0xc5, 0x70, 0xae, 0x03, 0xea, 0xf2,
+  0x5e, 0xcb, 0xbf, 0x61, 0x01, 0x8a, 0x21, 0x77, 0xaa, 0xef, 0x3a, 0x3e, 0xb9, 0x2f, 0xe1, 0x5e,
+  0x58, 0xb7, 0x1b, 0x49, 0x5b, 0x4c, 0x20, 0x92, 0x4c, 0x78, 0xe8, 0x99, 0x69, 0xf9, 0xc0, 0xa2,
+  0xd3, 0x70, 0xe2, 0x54, 0x94, 0x87, 0x8f, 0x6c, 0xaa, 0x1e, 0x20, 0x4a, 0x9e, 0x2b, 0x29, 0xbe,
+  0x80, 0xd6, 0xbb, 0xe8, 0x47, 0x54, 0xe6, 0xbd, 0x94, 0xb0, 0xe6, 0xae, 0x46, 0x91, 0x4c, 0x18,
+  0xe4, 0x83, 0xba, 0xd0, 0xc1, 0x8f, 0xe8, 0xbe, 0x4f, 0xaa, 0x62, 0x36, 0x07, 0x3f, 0x95, 0x10,
+  0x37, 0x0c, 0xa4, 0x05, 0xf3, 0x84, 0xa8, 0x6b, 0x91, 0xe9, 0x80, 0x80, 0x05, 0x63, 0xfa, 0x2c,
+  0x7d, 0x5c, 0xc8, 0xc7, 0x63, 0xd0, 0xe4, 0xd1, 0xbc, 0x9e, 0xfc, 0xac, 0xd6, 0xa5, 0xbc, 0xa1,
+  0xbe, 0x4c, 0xa1, 0xf2, 0xbe, 0xe2, 0x2a, 0x95, 0xb2, 0xdb, 0x0d, 0x31, 0xe7, 0xe1, 0x35, 0x56,
+  0x29, 0x91, 0x5b, 0xeb, 0x36, 0xc0, 0xee, 0x30, 0x06, 0x03, 0xb5, 0x6a, 0x73, 0x34, 0x82, 0x5d,
+  0x08, 0xc8, 0x6f, 0xfa, 0x24, 0xa5, 0x73, 0x32, 0x9b, 0xb0, 0x48, 0x36, 0x99, 0xfc, 0x04, 0x13,
+  0xdc, 0x19, 0x7a, 0x69, 0x0a, 0x41, 0x59, 0x5d, 0xb6, 0x83, 0xc4, 0xa8, 0xa1, 0xec, 0x94, 0x6b,
+  0x8e, 0xf3, 0x52, 0x53, 0xed, 0xfe, 0x5d, 0x14, 0xdc, 0x81, 0x59, 0xe7, 0xf7, 0x30, 0x1b, 0xde,
+  0xfe, 0x54, 0x35, 0xa6, 0xf2, 0x0b, 0x9a, 0xe6, 0x72, 0x66, 0x2d, 0x97, 0x5e, 0xf5, 0xe9, 0x93,
+  0x1b, 0xa5, 0xf3, 0x44, 0x37, 0xc2, 0xd4, 0xf5, 0x96, 0x0a, 0x3a, 0x39, 0xc3, 0xee, 0x85, 0xdd,
+  0x2c, 0x3d, 0x4d, 0xfd, 0x1d, 0xb9, 0x46, 0xfe, 0xc9, 0x7c, 0x0e, 0x59, 0xf0, 0xb8, 0x68, 0xbd,
+  0xd8, 0x7c, 0x95, 0xbd, 0x62, 0xdc, 0xf9, 0xa2, 0x03, 0x24, 0x90, 0xa7, 0x4d, 0x44, 0x37, 0xb6,
+  0x40, 0x80, 0x29, 0xaa, 0x2b, 0x50, 0xaa, 0xac, 0x01, 0xd8, 0x3a, 0x8d, 0x8f, 0xc5, 0x4f, 0x3a,
+  0x37, 0xe8, 0x20, 0xa3, 0x72, 0x61, 0xee, 0x74, 0x2a, 0x75, 0xb7, 0x1d, 0x8a, 0xea, 0x3d, 0xc8,
+  0x52, 0x3d, 0xf8, 0xe1, 0x43, 0xb9, 0xe3, 0x5c, 0x2e, 0x07, 0x8f, 0x54, 0x00, 0xac, 0x01, 0x34,
+  0x87, 0x0e, 0x6b, 0x9c, 0xd6, 0xab, 0x2b, 0x6f, 0xa6, 0x35, 0x68, 0xb1, 0x33, 0xe7, 0xe4, 0xfa,
+  0xb7, 0x2c, 0x3e, 0xae, 0xbb, 0xb4, 0x36, 0x05, 0x7d, 0xf2, 0x49, 0x12, 0x59, 0xff, 0x18, 0xe2,
+  0x41, 0x3a, 0x2a, 0x82, 0xad, 0xbb, 0xb1, 0xaa, 0xab, 0xb2, 0x52, 0x09, 0xe9, 0x1a, 0x65, 0x74,
+  0x4c, 0xd1, 0x0d, 0xa9, 0x7a, 0x65, 0xa0, 0x6e, 0xc8, 0xa2, 0x6d, 0xa7, 0x1c, 0x7f, 0x9e, 0x50,
+  0xf2, 0x46, 0x80, 0x4a, 0xdf, 0xc6, 0xae, 0x16, 0xc5, 0x52, 0xc0, 0x45, 0x9d, 0xd5, 0xb1, 0x6f,
+  0x92, 0x7c, 0xab, 0x12, 0x3c, 0x95, 0x0b, 0xe1, 0xcd, 0x41, 0x40, 0xd0, 0x2d, 0xb0, 0xeb, 0x63,
+  0xc5, 0x9a, 0xf4, 0x4a, 0x55, 0x5b, 0x71, 0x02, 0xba, 0x18, 0x94, 0x29, 0xc2, 0x1f, 0xe7, 0x2c,
+  0x21, 0x68, 0x3d, 0x7a, 0x72, 0x42, 0xca, 0x8d, 0x83, 0xa6, 0xa2, 0x51, 0xe3, 0xd7, 0x59, 0x2b,
+  0x7a, 0x21, 0xf0, 0xf3, 0x1c, 0xf2, 0x44, 0x1f, 0x98, 0x62, 0xee, 0x3d, 0x7a, 0x41, 0x1a, 0x87,
+  0x74, 0x9e, 0xb6, 0xec, 0x4c, 0xd1, 0x26, 0x6f, 0xc9, 0xed, 0x4a, 0x43, 0xb5, 0x29, 0x2f, 0xd7,
+  0xba, 0x47, 0x66, 0xfd, 0x02, 0xa1, 0x9a, 0x01, 0x58, 0xee, 0xad, 0x6d, 0xd5, 0xb2, 0x4f, 0xcb,
+  0xf6, 0x5b, 0x60, 0xd3, 0xce, 0x2e, 0x2f, 0xbc, 0x37, 0xcc, 0x73, 0xab, 0xb1, 0xe2, 0x1c, 0xb4,
+  0x2a, 0xa9, 0xf7, 0x00, 0x7f, 0x15, 0xa6, 0x7e, 0x01, 0x70, 0xb4, 0xa9, 0x7e, 0x0f, 0xb6, 0x29,
+  0x7f, 0x64, 0xdd, 0xfa, 0x5f, 0x3c, 0x7e, 0x46, 0xb0, 0x7c, 0x3d, 0x00, 0x00,
+};
+
+#endif
\ No newline at end of file
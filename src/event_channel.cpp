@@ -0,0 +1,186 @@
+// ============================================================================
+// event_channel.cpp - Server-Sent Events fan-out implementation
+// ============================================================================
+#include "event_channel.h"
+#include <lwip/sockets.h>
+
+EventChannel::EventChannel()
+  : stateLock(nullptr), published(0), coalesced(0), listenersServed(0), listenersRejected(0),
+    listenersDropped(0) {
+  for (int t = 0; t < EVENT_TYPE_COUNT; t++) {
+    states[t].length = 0;
+    states[t].version = 0;
+  }
+  for (int i = 0; i < EventsConfig::MAX_CLIENTS; i++) {
+    listeners[i].active = false;
+  }
+}
+
+bool EventChannel::begin() {
+  stateLock = xSemaphoreCreateMutex();
+  if (!stateLock) {
+    Serial.println("Event channel allocation failed");
+    return false;
+  }
+  return true;
+}
+
+void EventChannel::publish(EventType type, const char* json, size_t length) {
+  if (!stateLock || length >= sizeof(states[type].data)) return;
+  
+  xSemaphoreTake(stateLock, portMAX_DELAY);
+  memcpy(states[type].data, json, length);
+  states[type].length = length;
+  states[type].version++;
+  xSemaphoreGive(stateLock);
+  
+  published++;
+}
+
+bool EventChannel::addListener(httpd_handle_t server, int fd) {
+  EventListener* slot = nullptr;
+  for (int i = 0; i < EventsConfig::MAX_CLIENTS && !slot; i++) {
+    if (!listeners[i].active) slot = &listeners[i];
+  }
+  if (!slot) {
+    listenersRejected++;
+    return false;
+  }
+  
+  // No Content-Length: the body runs until either side closes
+  char head[256];
+  int headLength = snprintf(head, sizeof(head),
+                            "HTTP/1.1 200 OK\r\n"
+                            "Content-Type: text/event-stream\r\n"
+                            "Cache-Control: no-cache\r\n"
+                            "Access-Control-Allow-Origin: *\r\n\r\n"
+                            "retry: %d\n\n", EventsConfig::RETRY_MS);
+  if (httpd_socket_send(server, fd, head, headLength, 0) != headLength) {
+    return false;
+  }
+  
+  // Every type starts unsent, so the first flush is a full snapshot
+  slot->fd = fd;
+  for (int t = 0; t < EVENT_TYPE_COUNT; t++) {
+    slot->sent[t] = 0;
+  }
+  slot->backlogLength = 0;
+  slot->lastProgress = millis();
+  slot->lastWrite = millis();
+  slot->active = true;
+  listenersServed++;
+  
+  fill(*slot);
+  drain(server, *slot);
+  
+  Serial.printf("Event listener connected (%d listening)\n", getListenerCount());
+  return true;
+}
+
+void EventChannel::removeListener(int fd) {
+  for (int i = 0; i < EventsConfig::MAX_CLIENTS; i++) {
+    if (listeners[i].active && listeners[i].fd == fd) {
+      listeners[i].active = false;
+      Serial.printf("Event listener disconnected (%d listening)\n", getListenerCount());
+    }
+  }
+}
+
+void EventChannel::flush(httpd_handle_t server) {
+  for (int i = 0; i < EventsConfig::MAX_CLIENTS; i++) {
+    EventListener& listener = listeners[i];
+    if (!listener.active) continue;
+    
+    fill(listener);
+    
+    // A comment line keeps proxies from timing out and finds dead peers
+    if (listener.backlogLength == 0 && millis() - listener.lastWrite >= (unsigned long)EventsConfig::KEEPALIVE_MS) {
+      static const char keepalive[] = ": keepalive\n\n";
+      memcpy(listener.backlog, keepalive, sizeof(keepalive) - 1);
+      listener.backlogLength = sizeof(keepalive) - 1;
+      listener.lastProgress = millis();
+    }
+    
+    drain(server, listener);
+  }
+}
+
+// Only refilled once the previous batch is fully on the wire, so a slow
+// listener holds at most one frame per type and skips stale states
+void EventChannel::fill(EventListener& listener) {
+  if (listener.backlogLength > 0) return;
+  
+  xSemaphoreTake(stateLock, portMAX_DELAY);
+  for (int t = 0; t < EVENT_TYPE_COUNT; t++) {
+    const EventState& state = states[t];
+    if (state.version == listener.sent[t]) continue;
+    
+    char prefix[32];
+    int prefixLength = snprintf(prefix, sizeof(prefix), "event: %s\ndata: ", typeName((EventType)t));
+    size_t frameLength = prefixLength + state.length + 2;
+    
+    // No room this round; it goes out with the next batch
+    if (listener.backlogLength + frameLength > sizeof(listener.backlog)) continue;
+    
+    char* out = listener.backlog + listener.backlogLength;
+    memcpy(out, prefix, prefixLength);
+    memcpy(out + prefixLength, state.data, state.length);
+    memcpy(out + prefixLength + state.length, "\n\n", 2);
+    listener.backlogLength += frameLength;
+    
+    if (listener.sent[t] != 0) {
+      coalesced += state.version - listener.sent[t] - 1;
+    }
+    listener.sent[t] = state.version;
+  }
+  xSemaphoreGive(stateLock);
+  
+  listener.lastProgress = millis();
+}
+
+void EventChannel::drain(httpd_handle_t server, EventListener& listener) {
+  while (listener.backlogLength > 0) {
+    // Never block the server task on one slow listener
+    int sent = httpd_socket_send(server, listener.fd, listener.backlog, listener.backlogLength, MSG_DONTWAIT);
+    if (sent == HTTPD_SOCK_ERR_TIMEOUT) {
+      if (millis() - listener.lastProgress < (unsigned long)EventsConfig::STALL_TIMEOUT_MS) {
+        return;
+      }
+      drop(server, listener);
+      return;
+    }
+    if (sent <= 0) {
+      drop(server, listener);
+      return;
+    }
+    
+    listener.backlogLength -= sent;
+    memmove(listener.backlog, listener.backlog + sent, listener.backlogLength);
+    listener.lastProgress = millis();
+    listener.lastWrite = millis();
+  }
+}
+
+void EventChannel::drop(httpd_handle_t server, EventListener& listener) {
+  listener.active = false;
+  listenersDropped++;
+  httpd_sess_trigger_close(server, listener.fd);
+}
+
+int EventChannel::getListenerCount() const {
+  int count = 0;
+  for (int i = 0; i < EventsConfig::MAX_CLIENTS; i++) {
+    if (listeners[i].active) count++;
+  }
+  return count;
+}
+
+const char* EventChannel::typeName(EventType type) {
+  switch (type) {
+    case EVENT_UART:      return "uart";
+    case EVENT_DETECTION: return "detection";
+    case EVENT_WIFI:      return "wifi";
+    case EVENT_HEAP:      return "heap";
+    default:              return "unknown";
+  }
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+// ============================================================================
+// event_channel.h - Server-Sent Events fan-out for GET /events
+// ============================================================================
+#ifndef EVENT_CHANNEL_H
+#define EVENT_CHANNEL_H
+
+#include <Arduino.h>
+#include <esp_http_server.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "config.h"
+
+enum EventType {
+  EVENT_UART,         // Arduino command / link state
+  EVENT_DETECTION,    // Latest analysis verdict
+  EVENT_WIFI,         // Connection or signal change
+  EVENT_HEAP,         // Low-memory threshold crossings, and free heap while below it
+  EVENT_TYPE_COUNT
+};
+
+// Each event type is a state, so only its newest payload matters: a
+// listener that falls behind skips straight to the latest value rather
+// than replaying every intermediate one.
+struct EventState {
+  char data[EventsConfig::MAX_EVENT_SIZE];
+  size_t length;
+  uint32_t version;          // Bumped per publish; 0 = never published
+};
+
+struct EventListener {
+  int fd;
+  bool active;
+  uint32_t sent[EVENT_TYPE_COUNT];   // Version of each type already queued
+  char backlog[EventsConfig::CLIENT_BACKLOG];
+  size_t backlogLength;
+  unsigned long lastProgress;
+  unsigned long lastWrite;
+};
+
+// publish() may be called from any task. Everything touching listeners
+// runs on the HTTP server task, which owns the sockets.
+class EventChannel {
+private:
+  EventState states[EVENT_TYPE_COUNT];
+  EventListener listeners[EventsConfig::MAX_CLIENTS];
+  SemaphoreHandle_t stateLock;
+  
+  uint32_t published;
+  uint32_t coalesced;
+  uint32_t listenersServed;
+  uint32_t listenersRejected;
+  uint32_t listenersDropped;
+  
+  void fill(EventListener& listener);
+  void drain(httpd_handle_t server, EventListener& listener);
+  void drop(httpd_handle_t server, EventListener& listener);
+  
+public:
+  EventChannel();
+  
+  bool begin();
+  
+  // Replace the current payload for this type (a single-line JSON object)
+  void publish(EventType type, const char* json, size_t length);
+  
+  // Server task only
+  bool addListener(httpd_handle_t server, int fd);
+  void removeListener(int fd);
+  void flush(httpd_handle_t server);
+  
+  int getListenerCount() const;
+  bool hasListeners() const { return getListenerCount() > 0; }
+  uint32_t getPublished() const { return published; }
+  uint32_t getCoalesced() const { return coalesced; }
+  uint32_t getListenersServed() const { return listenersServed; }
+  uint32_t getListenersRejected() const { return listenersRejected; }
+  uint32_t getListenersDropped() const { return listenersDropped; }
+  static const char* typeName(EventType type);
+};
+
+#endif
\ No newline at end of file
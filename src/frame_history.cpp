@@ -0,0 +1,136 @@
+// ============================================================================
+// frame_history.cpp - Recent-frame ring implementation
+// ============================================================================
+#include "frame_history.h"
+
+FrameHistory::FrameHistory()
+  : lock(nullptr), slotCount(0), lastSequence(0), lastRecordAt(0), recorded(0), skippedBusy(0),
+    skippedOversize(0) {
+  for (int i = 0; i < HistoryConfig::SLOTS; i++) {
+    slots[i].data = nullptr;
+  }
+}
+
+bool FrameHistory::begin() {
+  if (!HistoryConfig::ENABLED) return false;
+  
+  lock = xSemaphoreCreateMutex();
+  if (!lock) return false;
+  
+  // Take what PSRAM allows; a shorter history beats none
+  for (int i = 0; i < HistoryConfig::SLOTS; i++) {
+    Slot& slot = slots[slotCount];
+    slot.data = (uint8_t*)ps_malloc(HistoryConfig::SLOT_BYTES);
+    if (!slot.data) break;
+    slot.length = 0;
+    slot.sequence = 0;
+    slot.readers = 0;
+    slot.writing = false;
+    slotCount++;
+  }
+  
+  if (slotCount == 0) {
+    Serial.println("Frame history allocation failed");
+    return false;
+  }
+  Serial.printf("Frame history: %d slots of %d KB\n", slotCount, HistoryConfig::SLOT_BYTES / 1024);
+  return true;
+}
+
+void FrameHistory::record(const camera_fb_t* fb) {
+  if (slotCount == 0 || !fb || fb->format != PIXFORMAT_JPEG) return;
+  if (lastRecordAt != 0 && millis() - lastRecordAt < (unsigned long)HistoryConfig::MIN_INTERVAL_MS) return;
+  
+  if (fb->len > (size_t)HistoryConfig::SLOT_BYTES) {
+    skippedOversize++;
+    return;
+  }
+  
+  // Claim the oldest free slot (empty ones sort first)
+  Slot* target = nullptr;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (int i = 0; i < slotCount; i++) {
+    Slot& slot = slots[i];
+    if (slot.readers > 0 || slot.writing) continue;
+    if (!target || slot.sequence < target->sequence) target = &slot;
+  }
+  if (target) {
+    target->writing = true;
+    target->sequence = 0;
+    lastRecordAt = millis();
+  }
+  xSemaphoreGive(lock);
+  
+  if (!target) {
+    skippedBusy++;
+    return;
+  }
+  
+  memcpy(target->data, fb->buf, fb->len);
+  
+  xSemaphoreTake(lock, portMAX_DELAY);
+  target->length = fb->len;
+  target->width = fb->width;
+  target->height = fb->height;
+  target->capturedAt = millis();
+  target->sequence = ++lastSequence;
+  target->writing = false;
+  xSemaphoreGive(lock);
+  
+  recorded++;
+}
+
+bool FrameHistory::acquire(uint32_t sequence, HistoryFrame& out) {
+  if (slotCount == 0 || sequence == 0) return false;
+  
+  bool found = false;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (int i = 0; i < slotCount && !found; i++) {
+    Slot& slot = slots[i];
+    if (slot.sequence != sequence || slot.writing) continue;
+    slot.readers++;
+    out.data = slot.data;
+    out.length = slot.length;
+    out.width = slot.width;
+    out.height = slot.height;
+    out.capturedAt = slot.capturedAt;
+    out.sequence = slot.sequence;
+    found = true;
+  }
+  xSemaphoreGive(lock);
+  return found;
+}
+
+void FrameHistory::release(const HistoryFrame& frame) {
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (int i = 0; i < slotCount; i++) {
+    if (slots[i].sequence == frame.sequence && slots[i].readers > 0) {
+      slots[i].readers--;
+      break;
+    }
+  }
+  xSemaphoreGive(lock);
+}
+
+int FrameHistory::list(HistoryFrame* out, int max) {
+  if (slotCount == 0) return 0;
+  
+  int count = 0;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (int i = 0; i < slotCount; i++) {
+    const Slot& slot = slots[i];
+    if (slot.sequence == 0 || slot.writing) continue;
+    
+    // Insertion sort by sequence, newest first; the ring is small
+    int at = count < max ? count : max - 1;
+    if (count >= max && slot.sequence <= out[at].sequence) continue;
+    while (at > 0 && out[at - 1].sequence < slot.sequence) {
+      out[at] = out[at - 1];
+      at--;
+    }
+    out[at] = {nullptr, slot.length, slot.width, slot.height, slot.capturedAt, slot.sequence};
+    if (count < max) count++;
+  }
+  xSemaphoreGive(lock);
+  return count;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+// ============================================================================
+// frame_history.h - PSRAM ring of recent JPEG frames for GET /history
+// ============================================================================
+#ifndef FRAME_HISTORY_H
+#define FRAME_HISTORY_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_camera.h"
+#include "config.h"
+
+// One recorded frame. From list() data is nullptr; from acquire() it
+// points into the pinned slot until release().
+struct HistoryFrame {
+  const uint8_t* data;
+  size_t length;
+  uint16_t width;
+  uint16_t height;
+  unsigned long capturedAt;  // millis()
+  uint32_t sequence;         // Stable id for /history/<n>
+};
+
+// Fixed slots allocated once, so recording never fragments PSRAM. Slots
+// are copy-on-write: a reader pins a published slot and sends straight
+// from it, and the writer always fills the oldest slot nobody holds. The
+// lock only guards slot bookkeeping - no frame is copied under it - so
+// a slow HTTP client never stalls the capture path.
+class FrameHistory {
+private:
+  struct Slot {
+    uint8_t* data;           // HistoryConfig::SLOT_BYTES
+    size_t length;
+    uint16_t width;
+    uint16_t height;
+    unsigned long capturedAt;
+    uint32_t sequence;       // 0 = empty
+    uint8_t readers;         // Pins held by acquire()
+    bool writing;            // Claimed by record(); invisible until published
+  };
+  
+  SemaphoreHandle_t lock;
+  Slot slots[HistoryConfig::SLOTS];
+  int slotCount;             // Slots actually allocated
+  uint32_t lastSequence;
+  unsigned long lastRecordAt;
+  
+  // Counters
+  uint32_t recorded;
+  uint32_t skippedBusy;      // Every slot pinned or being written
+  uint32_t skippedOversize;
+  
+public:
+  FrameHistory();
+  
+  bool begin();
+  bool isReady() const { return slotCount > 0; }
+  
+  // Called for each captured frame; keeps at most one per MIN_INTERVAL_MS
+  void record(const camera_fb_t* fb);
+  
+  // Pins frame `sequence` for zero-copy sending. False once it has been
+  // overwritten. Every successful acquire needs a release.
+  bool acquire(uint32_t sequence, HistoryFrame& out);
+  void release(const HistoryFrame& frame);
+  
+  // Metadata of the recorded frames, newest first. Returns the count.
+  int list(HistoryFrame* out, int max);
+  
+  // Status
+  int getCapacity() const { return slotCount; }
+  uint32_t getRecorded() const { return recorded; }
+  uint32_t getSkippedBusy() const { return skippedBusy; }
+  uint32_t getSkippedOversize() const { return skippedOversize; }
+};
+
+#endif
\ No newline at end of file
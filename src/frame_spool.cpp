@@ -0,0 +1,368 @@
+// ============================================================================
+// frame_spool.cpp - Store-and-forward frame spool implementation
+// ============================================================================
+#include "frame_spool.h"
+#include <time.h>
+#ifdef ARDUINO
+#include <LittleFS.h>
+#include <SD_MMC.h>
+#endif
+
+struct __attribute__((packed)) SpoolCursorRecord {
+  uint32_t segment;
+  uint32_t offset;
+  uint32_t nextSequence;
+};
+
+FrameSpool::FrameSpool()
+  : fs(nullptr), ready(false), firstSegment(1), writeSegment(1), cursorSegment(1), cursorOffset(0),
+    totalBytes(0), writeSegmentBytes(0), pendingFrames(0), nextSequence(1),
+    spooledFrames(0), drainedFrames(0), evictedFrames(0), rejectedFrames(0) {
+}
+
+bool FrameSpool::begin() {
+  if (!SpoolConfig::ENABLED) return false;
+  
+#ifdef ARDUINO
+  if (SpoolConfig::USE_SD_CARD) {
+    // 1-bit mode keeps GPIO 12/13 free for the Arduino UART
+    if (!SD_MMC.begin("/sdcard", true)) {
+      Serial.println("Spool: SD card mount failed");
+      return false;
+    }
+    return begin(SD_MMC);
+  }
+  
+  if (!LittleFS.begin(true)) {
+    Serial.println("Spool: LittleFS mount failed");
+    return false;
+  }
+  return begin(LittleFS);
+#else
+  // Host builds have no flash or SD card; pass a directory-backed fs::FS
+  return false;
+#endif
+}
+
+bool FrameSpool::begin(fs::FS& filesystem) {
+  fs = &filesystem;
+  
+  if (!fs->exists(SpoolConfig::DIRECTORY) && !fs->mkdir(SpoolConfig::DIRECTORY)) {
+    Serial.println("Spool: could not create " + String(SpoolConfig::DIRECTORY));
+    return false;
+  }
+  
+  scan();
+  loadCursor();
+  
+  // Count what is still undrained and resume the sequence numbering
+  pendingFrames = 0;
+  uint32_t lastSequence = 0;
+  for (uint32_t id = cursorSegment; id <= writeSegment; id++) {
+    pendingFrames += countRecords(id, id == cursorSegment ? cursorOffset : 0, &lastSequence);
+  }
+  if (lastSequence >= nextSequence) {
+    nextSequence = lastSequence + 1;
+  }
+  
+  // Start every boot on a fresh segment so a record torn by power loss is
+  // never followed by good data in the same file
+  if (segmentSize(writeSegment) > 0) {
+    writeSegment++;
+  }
+  writeSegmentBytes = 0;
+  
+  ready = true;
+  Serial.printf("Spool ready: %u frames pending, %u bytes in %u segments\n",
+                pendingFrames, (unsigned)totalBytes, getSegmentCount());
+  return true;
+}
+
+bool FrameSpool::append(camera_fb_t* fb, CaptureTrigger trigger, int rssi) {
+  if (!ready || !fb) return false;
+  
+  size_t recordBytes = sizeof(SpoolRecordHeader) + fb->len;
+  if (recordBytes > (size_t)SpoolConfig::SEGMENT_SIZE) {
+    rejectedFrames++;
+    return false;
+  }
+  
+  if (writeSegmentBytes > 0 && writeSegmentBytes + recordBytes > (size_t)SpoolConfig::SEGMENT_SIZE) {
+    writeSegment++;
+    writeSegmentBytes = 0;
+  }
+  
+  while (totalBytes + recordBytes > (size_t)SpoolConfig::MAX_BYTES) {
+    if (!evictOldest()) {
+      rejectedFrames++;
+      return false;
+    }
+  }
+  
+  SpoolRecordHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = SpoolConfig::RECORD_MAGIC;
+  header.length = fb->len;
+  header.sequence = nextSequence;
+  header.uptimeMs = millis();
+  time_t now = time(nullptr);
+  header.unixTime = now > 1600000000 ? (uint32_t)now : 0;
+  header.width = fb->width;
+  header.height = fb->height;
+  header.rssi = (int8_t)rssi;
+  header.trigger = trigger;
+  header.format = fb->format;
+  
+  File file = fs->open(segmentPath(writeSegment), FILE_APPEND);
+  if (!file) {
+    rejectedFrames++;
+    return false;
+  }
+  
+  size_t written = file.write((const uint8_t*)&header, sizeof(header));
+  if (written == sizeof(header)) {
+    written += file.write(fb->buf, fb->len);
+  }
+  file.close();
+  
+  totalBytes += written;
+  writeSegmentBytes += written;
+  
+  if (written != recordBytes) {
+    // Storage full or failing: readers stop at the torn record, so anything
+    // appended after it would be lost - move on to a new segment
+    Serial.printf("Spool: short write (%u of %u bytes)\n", (unsigned)written, (unsigned)recordBytes);
+    writeSegment++;
+    writeSegmentBytes = 0;
+    rejectedFrames++;
+    return false;
+  }
+  
+  nextSequence++;
+  pendingFrames++;
+  spooledFrames++;
+  return true;
+}
+
+bool FrameSpool::peek(SpoolFrame& frame) {
+  if (!ready) return false;
+  
+  while (pendingFrames > 0) {
+    size_t size = segmentSize(cursorSegment);
+    
+    if (cursorOffset >= size) {
+      if (cursorSegment >= writeSegment) {
+        pendingFrames = 0;  // Counter drifted; nothing left on disk
+        return false;
+      }
+      advanceCursor(size);
+      continue;
+    }
+    
+    File file = fs->open(segmentPath(cursorSegment), FILE_READ);
+    SpoolRecordHeader header;
+    bool valid = file && file.seek(cursorOffset) &&
+                 file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                 header.magic == SpoolConfig::RECORD_MAGIC &&
+                 cursorOffset + sizeof(header) + header.length <= size;
+                 
+    uint8_t* data = nullptr;
+    if (valid) {
+      data = (uint8_t*)ps_malloc(header.length);
+      if (!data) {
+        file.close();
+        return false;  // Try again when memory frees up
+      }
+      valid = file.read(data, header.length) == header.length;
+    }
+    file.close();
+    
+    if (!valid) {
+      // Torn or corrupt record - nothing after it in this segment is trusted
+      Serial.printf("Spool: skipping corrupt data in segment %u at %u\n", cursorSegment, cursorOffset);
+      free(data);
+      cursorOffset = size;
+      saveCursor();
+      continue;
+    }
+    
+    memset(&frame, 0, sizeof(frame));
+    frame.header = header;
+    frame.segment = cursorSegment;
+    frame.offset = cursorOffset;
+    frame.fb.buf = data;
+    frame.fb.len = header.length;
+    frame.fb.width = header.width;
+    frame.fb.height = header.height;
+    frame.fb.format = (pixformat_t)header.format;
+    return true;
+  }
+  
+  return false;
+}
+
+void FrameSpool::consume(const SpoolFrame& frame) {
+  if (frame.segment != cursorSegment || frame.offset != cursorOffset) return;
+  
+  if (pendingFrames > 0) pendingFrames--;
+  drainedFrames++;
+  advanceCursor(frame.offset + sizeof(SpoolRecordHeader) + frame.header.length);
+}
+
+void FrameSpool::release(SpoolFrame& frame) {
+  free(frame.fb.buf);
+  frame.fb.buf = nullptr;
+  frame.fb.len = 0;
+}
+
+String FrameSpool::segmentPath(uint32_t id) const {
+  char name[24];
+  snprintf(name, sizeof(name), "/%08u.seg", id);
+  return String(SpoolConfig::DIRECTORY) + name;
+}
+
+size_t FrameSpool::segmentSize(uint32_t id) {
+  String path = segmentPath(id);
+  if (!fs->exists(path.c_str())) return 0;
+  
+  File file = fs->open(path, FILE_READ);
+  size_t size = file ? file.size() : 0;
+  file.close();
+  return size;
+}
+
+uint32_t FrameSpool::countRecords(uint32_t id, uint32_t fromOffset, uint32_t* lastSequence) {
+  String path = segmentPath(id);
+  if (!fs->exists(path.c_str())) return 0;
+  
+  File file = fs->open(path, FILE_READ);
+  if (!file) return 0;
+  
+  size_t size = file.size();
+  uint32_t count = 0;
+  uint32_t offset = fromOffset;
+  SpoolRecordHeader header;
+  
+  while (offset + sizeof(header) <= size && file.seek(offset) &&
+         file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+         header.magic == SpoolConfig::RECORD_MAGIC &&
+         offset + sizeof(header) + header.length <= size) {
+    count++;
+    if (lastSequence) *lastSequence = header.sequence;
+    offset += sizeof(header) + header.length;
+  }
+  
+  file.close();
+  return count;
+}
+
+void FrameSpool::scan() {
+  firstSegment = 0;
+  writeSegment = 0;
+  totalBytes = 0;
+  
+  File dir = fs->open(SpoolConfig::DIRECTORY);
+  if (dir && dir.isDirectory()) {
+    File entry = dir.openNextFile();
+    while (entry) {
+      String name = entry.name();
+      int slash = name.lastIndexOf('/');
+      if (slash >= 0) name = name.substring(slash + 1);
+      
+      uint32_t id = strtoul(name.c_str(), nullptr, 10);
+      if (name.endsWith(".seg") && id > 0) {
+        if (firstSegment == 0 || id < firstSegment) firstSegment = id;
+        if (id > writeSegment) writeSegment = id;
+        totalBytes += entry.size();
+      }
+      
+      entry.close();
+      entry = dir.openNextFile();
+    }
+    dir.close();
+  }
+  
+  if (writeSegment == 0) {
+    firstSegment = writeSegment = 1;
+  }
+}
+
+bool FrameSpool::evictOldest() {
+  // Never delete the segment currently being written
+  if (firstSegment >= writeSegment) return false;
+  
+  uint32_t lost = 0;
+  if (cursorSegment <= firstSegment) {
+    lost = countRecords(firstSegment, cursorSegment == firstSegment ? cursorOffset : 0, nullptr);
+  }
+  
+  size_t size = segmentSize(firstSegment);
+  fs->remove(segmentPath(firstSegment).c_str());
+  totalBytes -= min(size, totalBytes);
+  firstSegment++;
+  
+  pendingFrames -= min(lost, pendingFrames);
+  evictedFrames += lost;
+  if (lost > 0) {
+    Serial.printf("Spool full: evicted %u oldest frames\n", lost);
+  }
+  
+  if (cursorSegment < firstSegment) {
+    cursorSegment = firstSegment;
+    cursorOffset = 0;
+    saveCursor();
+  }
+  return true;
+}
+
+void FrameSpool::loadCursor() {
+  SpoolCursorRecord record;
+  memset(&record, 0, sizeof(record));
+  
+  String path = String(SpoolConfig::DIRECTORY) + "/cursor";
+  if (fs->exists(path.c_str())) {
+    File file = fs->open(path, FILE_READ);
+    if (file && file.read((uint8_t*)&record, sizeof(record)) != sizeof(record)) {
+      memset(&record, 0, sizeof(record));
+    }
+    file.close();
+  }
+  
+  if (record.segment >= firstSegment && record.segment <= writeSegment) {
+    cursorSegment = record.segment;
+    cursorOffset = record.offset;
+  } else {
+    cursorSegment = firstSegment;
+    cursorOffset = 0;
+  }
+  
+  if (record.nextSequence > nextSequence) {
+    nextSequence = record.nextSequence;
+  }
+}
+
+void FrameSpool::saveCursor() {
+  SpoolCursorRecord record = { cursorSegment, cursorOffset, nextSequence };
+  
+  File file = fs->open(String(SpoolConfig::DIRECTORY) + "/cursor", FILE_WRITE);
+  if (file) {
+    file.write((const uint8_t*)&record, sizeof(record));
+    file.close();
+  }
+}
+
+void FrameSpool::advanceCursor(uint32_t toOffset) {
+  cursorOffset = toOffset;
+  
+  // A fully drained segment that is no longer written to can go
+  size_t size = segmentSize(cursorSegment);
+  if (cursorOffset >= size && cursorSegment < writeSegment) {
+    fs->remove(segmentPath(cursorSegment).c_str());
+    totalBytes -= min(size, totalBytes);
+    if (firstSegment == cursorSegment) firstSegment++;
+    cursorSegment++;
+    cursorOffset = 0;
+  }
+  
+  saveCursor();
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+// ============================================================================
+// frame_spool.h - Store-and-forward spool for frames the backend missed
+// ============================================================================
+#ifndef FRAME_SPOOL_H
+#define FRAME_SPOOL_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "esp_camera.h"
+#include "config.h"
+
+enum CaptureTrigger : uint8_t {
+  TRIGGER_HTTP_SYNC = 1,    // GET /api/analyze
+  TRIGGER_HTTP_JOB = 2,     // POST /api/analyze via the worker
+  TRIGGER_MOTION = 3        // Queued by the motion monitor
+};
+
+// On-disk record header; the frame bytes follow immediately
+struct __attribute__((packed)) SpoolRecordHeader {
+  uint32_t magic;           // SpoolConfig::RECORD_MAGIC
+  uint32_t length;          // Frame bytes after this header
+  uint32_t sequence;        // Monotonic across reboots (resumed from the spool)
+  uint32_t uptimeMs;        // millis() at capture
+  uint32_t unixTime;        // time(nullptr) at capture, 0 if the clock wasn't set
+  uint16_t width;
+  uint16_t height;
+  int8_t rssi;
+  uint8_t trigger;          // CaptureTrigger
+  uint8_t format;           // pixformat_t of the stored bytes
+  uint8_t reserved;
+};
+
+// A spooled frame loaded back into PSRAM, wrapped as a camera_fb_t so it
+// can go through BackendClient::analyzeImage unchanged
+struct SpoolFrame {
+  SpoolRecordHeader header;
+  camera_fb_t fb;
+  uint32_t segment;
+  uint32_t offset;
+};
+
+// Append-only spool of camera frames split into numbered segment files
+// (/spool/00000001.seg, ...). New frames go to the newest segment; the
+// drain cursor walks from the oldest. Once the spool exceeds MAX_BYTES the
+// oldest segment is deleted whole, so eviction is oldest-first and never
+// rewrites data.
+class FrameSpool {
+private:
+  fs::FS* fs;
+  bool ready;
+  uint32_t firstSegment;         // Oldest segment still on disk
+  uint32_t writeSegment;         // Segment new frames are appended to
+  uint32_t cursorSegment;        // Next frame to drain
+  uint32_t cursorOffset;
+  size_t totalBytes;
+  size_t writeSegmentBytes;
+  uint32_t pendingFrames;
+  uint32_t nextSequence;
+  
+  // Counters
+  uint32_t spooledFrames;
+  uint32_t drainedFrames;
+  uint32_t evictedFrames;
+  uint32_t rejectedFrames;
+  
+  String segmentPath(uint32_t id) const;
+  size_t segmentSize(uint32_t id);
+  uint32_t countRecords(uint32_t id, uint32_t fromOffset, uint32_t* lastSequence);
+  void scan();
+  bool evictOldest();
+  void loadCursor();
+  void saveCursor();
+  void advanceCursor(uint32_t toOffset);
+  
+public:
+  FrameSpool();
+  
+  // Mount the configured storage (SD_MMC or LittleFS) and recover state
+  bool begin();
+  // Use an already-mounted filesystem (e.g. a directory-backed one on host)
+  bool begin(fs::FS& filesystem);
+  bool isReady() const { return ready; }
+  
+  bool append(camera_fb_t* fb, CaptureTrigger trigger, int rssi);
+  
+  // Load the oldest undrained frame into PSRAM. Corrupt or torn records
+  // are skipped. Call release() when done, and consume() once delivered.
+  bool peek(SpoolFrame& frame);
+  void consume(const SpoolFrame& frame);
+  void release(SpoolFrame& frame);
+  
+  // Status
+  bool hasPending() const { return ready && pendingFrames > 0; }
+  uint32_t getPendingFrames() const { return pendingFrames; }
+  size_t getTotalBytes() const { return totalBytes; }
+  uint32_t getSegmentCount() const { return ready ? writeSegment - firstSegment + 1 : 0; }
+  uint32_t getSpooledFrames() const { return spooledFrames; }
+  uint32_t getDrainedFrames() const { return drainedFrames; }
+  uint32_t getEvictedFrames() const { return evictedFrames; }
+  uint32_t getRejectedFrames() const { return rejectedFrames; }
+};
+
+#endif
\ No newline at end of file
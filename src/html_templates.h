@@ -4,6 +4,9 @@
 #ifndef HTML_TEMPLATES_H
 #define HTML_TEMPLATES_H
 
+// Source for the dashboard. The firmware serves the gzipped copy in
+// dashboard_page.h, regenerated from this by tools/build_dashboard.py.
+
 const char HTML_MAIN_PAGE[] PROGMEM = R"(
 <!DOCTYPE html><html><head><title>ESP32-CAM Honey Badger Detector</title>
 <meta name='viewport' content='width=device-width,initial-scale=1'>
@@ -38,6 +41,7 @@ button:disabled{background:#ccc;cursor:not-allowed;transform:none}
 <h1>🦡 Honey Badger Detector</h1>
 <div style='margin-bottom:20px'>
 <button id='detectBtn' onclick='captureAndAnalyze()'>Detect Honey Badger</button>
+<button class='test-btn' onclick='window.open("/stream")'>Live Stream</button>
 <button class='test-btn' onclick='testConnection()'>Test Connection</button>
 <button class='clear-btn' onclick='clearLog()'>Clear Log</button>
 </div>
@@ -52,17 +56,17 @@ button:disabled{background:#ccc;cursor:not-allowed;transform:none}
 </div>
 <button class='uart-btn' onclick='testUART()'>Test UART</button>
 <div style='margin-top:10px;font-size:12px;color:#666'>
-ESP32 TX: Pin {{UART_TX}} | ESP32 RX: Pin {{UART_RX}} | Baud: 115200
+ESP32 TX: Pin <span id='uartTx'>-</span> | ESP32 RX: Pin <span id='uartRx'>-</span> | Baud: <span id='uartBaud'>-</span>
 </div>
 </div>
 
 <div class='info'>
 <strong>System Status:</strong><br>
-ESP32-CAM IP: {{ESP32_IP}}<br>
-Backend: {{BACKEND_INFO}}<br>
-WiFi Signal: {{WIFI_SIGNAL}} dBm<br>
-Uptime: {{UPTIME}} seconds<br>
-Memory: {{MEMORY_INFO}} bytes free
+ESP32-CAM IP: <span id='infoIp'>-</span><br>
+Backend: <span id='infoBackend'>-</span><br>
+WiFi Signal: <span id='infoSignal'>-</span> dBm<br>
+Uptime: <span id='infoUptime'>-</span> seconds<br>
+Memory: <span id='infoMemory'>-</span> bytes free
 </div>
 <div class='debug-log'>
 <div class='log-header'>🔍 Debug Log</div>
@@ -71,6 +75,7 @@ Memory: {{MEMORY_INFO}} bytes free
 </div>
 <script>
 let isProcessing = false;
+let ownAnalysisAt = 0;
 
 function addLog(message, isError = false) {
     const logContent = document.getElementById('logContent');
@@ -84,37 +89,50 @@ function clearLog() {
     document.getElementById('logContent').innerHTML = 'Log cleared.\n';
 }
 
+let lastUART = null;
+let lastUARTAt = 0;
+
+function renderUARTStatus(status) {
+    // Show actual device connection status, not just UART initialization
+    const isConnected = status.initialized && status.deviceConnected;
+    document.getElementById('uartInitStatus').textContent = 
+        isConnected ? 'Connected' : (status.initialized ? 'No Arduino' : 'Disconnected');
+    document.getElementById('uartInitStatus').style.color = 
+        isConnected ? 'green' : 'red';
+        
+    document.getElementById('uartLastCommand').textContent = 
+        status.lastCommand >= 0 ? status.lastCommand : 'None';
+    
+    // Log new commands only if device is actually connected
+    if (isConnected && status.lastCommand >= 0 && lastUART &&
+        status.lastCommandTime !== lastUART.lastCommandTime) {
+        addLog(`📡 Arduino sent command: ${status.lastCommand}`);
+    }
+    
+    lastUART = status;
+    lastUARTAt = Date.now();
+    renderUARTTimeSince();
+}
+
+// Ticks locally between pushes so the age stays current
+function renderUARTTimeSince() {
+    if (!lastUART) return;
+    const timeSince = (lastUART.timeSinceLastResponse || lastUART.timeSinceLastCommand) + (Date.now() - lastUARTAt);
+    if (timeSince < 60000) {
+        document.getElementById('uartTimeSince').textContent = 
+            Math.floor(timeSince / 1000) + 's ago';
+    } else if (timeSince < 3600000) {
+        document.getElementById('uartTimeSince').textContent = 
+            Math.floor(timeSince / 60000) + 'm ago';
+    } else {
+        document.getElementById('uartTimeSince').textContent = 'Long time ago';
+    }
+}
+
 async function updateUARTStatus() {
     try {
         const response = await fetch('/uart/status');
-        const status = await response.json();
-        
-        // Show actual device connection status, not just UART initialization
-        const isConnected = status.initialized && status.deviceConnected;
-        document.getElementById('uartInitStatus').textContent = 
-            isConnected ? 'Connected' : (status.initialized ? 'No Arduino' : 'Disconnected');
-        document.getElementById('uartInitStatus').style.color = 
-            isConnected ? 'green' : 'red';
-            
-        document.getElementById('uartLastCommand').textContent = 
-            status.lastCommand >= 0 ? status.lastCommand : 'None';
-            
-        const timeSince = status.timeSinceLastResponse || status.timeSinceLastCommand;
-        if (timeSince < 60000) {
-            document.getElementById('uartTimeSince').textContent = 
-                Math.floor(timeSince / 1000) + 's ago';
-        } else if (timeSince < 3600000) {
-            document.getElementById('uartTimeSince').textContent = 
-                Math.floor(timeSince / 60000) + 'm ago';
-        } else {
-            document.getElementById('uartTimeSince').textContent = 'Long time ago';
-        }
-        
-        // Log new commands only if device is actually connected
-        if (isConnected && status.lastCommand >= 0 && status.timeSinceLastCommand < 2000) {
-            addLog(`📡 Arduino sent command: ${status.lastCommand}`);
-        }
-        
+        renderUARTStatus(await response.json());
     } catch (error) {
         document.getElementById('uartInitStatus').textContent = 'Error';
         document.getElementById('uartInitStatus').style.color = 'red';
@@ -162,6 +180,19 @@ async function testConnection() {
     }
 }
 
+async function waitForResult(resultUrl) {
+    // Poll until the background worker has finished the job
+    while (true) {
+        await new Promise(resolve => setTimeout(resolve, 500));
+        const response = await fetch(resultUrl);
+        if (response.status === 202) continue;
+        if (response.status === 404) {
+            throw new Error('Analysis job expired');
+        }
+        return await response.json();
+    }
+}
+
 async function captureAndAnalyze(){
     if(isProcessing) return;
     
@@ -191,7 +222,14 @@ async function captureAndAnalyze(){
             throw new Error(`Server error: ${response.status}`);
         }
         
-        const result = await response.json();
+        const job = await response.json();
+        if (job.attached) {
+            addLog(`🤝 Joined analysis job ${job.jobId} already in flight`);
+        } else {
+            addLog(`🧾 Analysis queued as job ${job.jobId} (${job.pending} pending)`);
+        }
+        
+        const result = await waitForResult(job.resultUrl);
         const totalTime = Date.now() - startTime;
         
         addLog(`⏱️ Total request time: ${totalTime}ms`);
@@ -201,6 +239,12 @@ async function captureAndAnalyze(){
         if (result.processingTime) {
             addLog(`⚡ ESP32 processing time: ${result.processingTime}ms`);
         }
+        if (result.shared) {
+            addLog('🤝 Verdict shared with a concurrent request (no new capture)');
+        }
+        if (result.motionGated) {
+            addLog(`💤 No motion since the last verdict (${Math.round(result.verdictAgeMs / 1000)}s ago) - upload skipped`);
+        }
         
         if (result.error) {
             addLog(`❌ Analysis error: ${result.error}`, true);
@@ -237,6 +281,7 @@ async function captureAndAnalyze(){
         status.textContent = `Connection Error: ${error.message}`;
     } finally {
         isProcessing = false;
+        ownAnalysisAt = Date.now();
         btn.disabled = false;
         btn.textContent = 'Detect Honey Badger';
         
@@ -260,22 +305,109 @@ document.addEventListener('keydown', function(e) {
     }
 });
 
-// Update UART status every 2 seconds
-setInterval(updateUARTStatus, 2000);
+let uptimeBase = 0;
+let uptimeAt = 0;
+let heapLow = false;
+let eventsLost = false;
 
-// Initial UART status update
-setTimeout(updateUARTStatus, 1000);
+function setUptime(uptime) {
+    uptimeBase = uptime;
+    uptimeAt = Date.now();
+}
 
-// Auto-refresh main status every 30 seconds
-setInterval(async () => {
+// The page itself is static (served gzipped from flash); fixed values come from here
+async function updateDashboardInfo() {
     try {
-        const response = await fetch('/status');
-        const status = await response.json();
-        // Update status silently without logging
+        const response = await fetch('/api/dashboard');
+        const info = await response.json();
+        document.getElementById('infoIp').textContent = info.ip;
+        document.getElementById('infoBackend').textContent = info.backend;
+        document.getElementById('infoSignal').textContent = info.wifiSignal;
+        document.getElementById('infoMemory').textContent = info.freeHeap;
+        document.getElementById('uartTx').textContent = info.uartTx;
+        document.getElementById('uartRx').textContent = info.uartRx;
+        document.getElementById('uartBaud').textContent = info.uartBaud;
+        setUptime(info.uptime);
     } catch (e) {
         // Silent fail
     }
-}, 30000);
+}
+
+// Live values are pushed over /events as they change
+function connectEvents() {
+    if (!window.EventSource) {
+        // No SSE in this browser: fall back to polling
+        setInterval(updateUARTStatus, 2000);
+        updateUARTStatus();
+        return;
+    }
+    
+    const events = new EventSource('/events');
+    
+    events.addEventListener('uart', e => renderUARTStatus(JSON.parse(e.data)));
+    
+    events.addEventListener('wifi', e => {
+        const wifi = JSON.parse(e.data);
+        document.getElementById('infoSignal').textContent = wifi.connected ? wifi.rssi : 'offline';
+        if (wifi.connected) {
+            document.getElementById('infoIp').textContent = wifi.ip;
+        }
+    });
+    
+    events.addEventListener('heap', e => {
+        const heap = JSON.parse(e.data);
+        document.getElementById('infoMemory').textContent = heap.freeHeap;
+        setUptime(heap.uptime);
+        if (heap.low && !heapLow) {
+            addLog(`⚠️ Low memory: ${heap.freeHeap} bytes free (threshold ${heap.threshold})`, true);
+        } else if (!heap.low && heapLow) {
+            addLog(`💾 Memory recovered: ${heap.freeHeap} bytes free`);
+        }
+        heapLow = heap.low;
+    });
+    
+    // Verdicts from other clients or scripts; our own are logged by captureAndAnalyze
+    events.addEventListener('detection', e => {
+        const result = JSON.parse(e.data);
+        if (result.spoolSequence) {
+            // Backlog from an outage: say when the frame was taken, not now
+            const when = result.captureUnix ? new Date(result.captureUnix * 1000).toLocaleString()
+                                            : `uptime ${Math.floor(result.captureUptimeMs / 1000)}s`;
+            addLog(`📦 Spooled frame #${result.spoolSequence} (${when}): ` +
+                   (result.isHoneyBadger ? `🦡 honey badger (${(result.confidence * 100).toFixed(1)}%)` : 'no honey badger'));
+            return;
+        }
+        if (isProcessing || Date.now() - ownAnalysisAt < 2000) return;
+        if (!result.success) {
+            addLog(`📡 Analysis #${result.sequence} failed: ${result.error}`, true);
+        } else if (result.isHoneyBadger) {
+            addLog(`📡 Analysis #${result.sequence}: 🦡 honey badger (${(result.confidence * 100).toFixed(1)}%)`);
+        } else {
+            addLog(`📡 Analysis #${result.sequence}: no honey badger`);
+        }
+    });
+    
+    // EventSource reconnects by itself; just say so once
+    events.onerror = () => {
+        if (!eventsLost) addLog('🔌 Live updates lost - reconnecting...', true);
+        eventsLost = true;
+    };
+    events.onopen = () => {
+        if (eventsLost) addLog('🔌 Live updates reconnected');
+        eventsLost = false;
+    };
+}
+
+// Local clock for the age displays
+setInterval(() => {
+    renderUARTTimeSince();
+    if (uptimeAt) {
+        document.getElementById('infoUptime').textContent = Math.floor((uptimeBase + Date.now() - uptimeAt) / 1000);
+    }
+}, 1000);
+
+updateDashboardInfo();
+connectEvents();
 </script></body></html>
 )";
 
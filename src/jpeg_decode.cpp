@@ -0,0 +1,17 @@
+// ============================================================================
+// jpeg_decode.cpp - Serialized JPEG decode
+// ============================================================================
+#include "jpeg_decode.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+namespace JpegDecode {
+  static SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+  
+  esp_err_t decode(size_t length, jpg_scale_t scale, jpg_reader_cb reader, jpg_writer_cb writer, void* arg) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    esp_err_t err = esp_jpg_decode(length, scale, reader, writer, arg);
+    xSemaphoreGive(lock);
+    return err;
+  }
+}
\ No newline at end of file
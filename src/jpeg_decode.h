@@ -0,0 +1,17 @@
+// ============================================================================
+// jpeg_decode.h - Serialized access to the camera library's JPEG decoder
+// ============================================================================
+#ifndef JPEG_DECODE_H
+#define JPEG_DECODE_H
+
+#include <Arduino.h>
+#include "esp_jpg_decode.h"
+
+namespace JpegDecode {
+  // esp_jpg_decode keeps tjpgd's work area in a static buffer, so two
+  // tasks decoding at once corrupt each other's output. The perceptual
+  // hash, thumbnails and the motion monitor all decode through this.
+  esp_err_t decode(size_t length, jpg_scale_t scale, jpg_reader_cb reader, jpg_writer_cb writer, void* arg);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+// ============================================================================
+// json_writer.cpp - Streaming JSON writer implementation
+// ============================================================================
+#include "json_writer.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+JsonWriter::JsonWriter(char* buffer, size_t capacity, JsonSink sink, void* sinkContext)
+  : buffer(buffer), capacity(capacity), used(0), flushed(0), sink(sink), sinkContext(sinkContext),
+    depth(0), failed(false) {
+  needComma[0] = false;
+}
+
+bool JsonWriter::makeRoom() {
+  if (used < capacity) return !failed;
+  
+  // Fixed-buffer mode: running out of room is an error
+  if (!sink) failed = true;
+  return flush() && used < capacity;
+}
+
+void JsonWriter::put(char c) {
+  if (makeRoom()) {
+    buffer[used++] = c;
+  }
+}
+
+void JsonWriter::put(const char* text) {
+  put(text, strlen(text));
+}
+
+void JsonWriter::put(const char* data, size_t length) {
+  while (length > 0 && !failed) {
+    if (!makeRoom()) return;
+    size_t n = capacity - used < length ? capacity - used : length;
+    memcpy(buffer + used, data, n);
+    used += n;
+    data += n;
+    length -= n;
+  }
+}
+
+void JsonWriter::putEscaped(const char* text) {
+  put('"');
+  
+  // Copy runs of safe characters in one go; escape the rest
+  const char* run = text;
+  for (const char* p = text; *p; p++) {
+    unsigned char c = (unsigned char)*p;
+    if (c >= 0x20 && c != '"' && c != '\\') continue;
+    
+    put(run, p - run);
+    run = p + 1;
+    switch (c) {
+      case '"':  put("\\\"", 2); break;
+      case '\\': put("\\\\", 2); break;
+      case '\n': put("\\n", 2); break;
+      case '\r': put("\\r", 2); break;
+      case '\t': put("\\t", 2); break;
+      default: {
+        char escaped[7];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        put(escaped, 6);
+      }
+    }
+  }
+  put(run, strlen(run));
+  
+  put('"');
+}
+
+void JsonWriter::putUnsigned(unsigned long long value) {
+  char digits[21];
+  int n = sizeof(digits);
+  do {
+    digits[--n] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+  put(digits + n, sizeof(digits) - n);
+}
+
+void JsonWriter::putSigned(long long value) {
+  if (value < 0) {
+    put('-');
+    putUnsigned(0ULL - (unsigned long long)value);
+  } else {
+    putUnsigned(value);
+  }
+}
+
+void JsonWriter::separator() {
+  if (needComma[depth]) put(',');
+  needComma[depth] = true;
+}
+
+void JsonWriter::key(const char* name) {
+  separator();
+  if (name) {
+    putEscaped(name);
+    put(':');
+  }
+}
+
+void JsonWriter::open(const char* name, char bracket) {
+  key(name);
+  put(bracket);
+  if (depth + 1 >= MAX_DEPTH) {
+    failed = true;
+    return;
+  }
+  needComma[++depth] = false;
+}
+
+void JsonWriter::close(char bracket) {
+  if (depth > 0) depth--;
+  put(bracket);
+}
+
+JsonWriter& JsonWriter::beginObject(const char* name) {
+  open(name, '{');
+  return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+  close('}');
+  return *this;
+}
+
+JsonWriter& JsonWriter::beginArray(const char* name) {
+  open(name, '[');
+  return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+  close(']');
+  return *this;
+}
+
+JsonWriter& JsonWriter::field(const char* name, const char* value) {
+  key(name);
+  if (value) {
+    putEscaped(value);
+  } else {
+    put("null", 4);
+  }
+  return *this;
+}
+
+JsonWriter& JsonWriter::field(const char* name, bool value) {
+  key(name);
+  if (value) {
+    put("true", 4);
+  } else {
+    put("false", 5);
+  }
+  return *this;
+}
+
+JsonWriter& JsonWriter::field(const char* name, long long value) {
+  key(name);
+  putSigned(value);
+  return *this;
+}
+
+JsonWriter& JsonWriter::field(const char* name, unsigned long long value) {
+  key(name);
+  putUnsigned(value);
+  return *this;
+}
+
+JsonWriter& JsonWriter::field(const char* name, double value, int decimals) {
+  key(name);
+  if (isnan(value) || isinf(value)) {
+    put("null", 4);  // JSON has no NaN/Infinity
+    return *this;
+  }
+  
+  char number[32];
+  int n = snprintf(number, sizeof(number), "%.*f", decimals, value);
+  if (n > 0) put(number, (size_t)n < sizeof(number) ? n : sizeof(number) - 1);
+  return *this;
+}
+
+JsonWriter& JsonWriter::nullField(const char* name) {
+  key(name);
+  put("null", 4);
+  return *this;
+}
+
+#ifdef ARDUINO
+JsonWriter& JsonWriter::field(const char* name, const IPAddress& ip) {
+  uint32_t address = ip;
+  char dotted[16];
+  snprintf(dotted, sizeof(dotted), "%u.%u.%u.%u", (unsigned)(address & 0xFF), (unsigned)((address >> 8) & 0xFF),
+           (unsigned)((address >> 16) & 0xFF), (unsigned)(address >> 24));
+  return field(name, (const char*)dotted);
+}
+#endif
+
+bool JsonWriter::flush() {
+  if (failed || !sink) return !failed;
+  
+  if (used > 0) {
+    if (!sink(sinkContext, buffer, used)) {
+      failed = true;
+      return false;
+    }
+    flushed += used;
+    used = 0;
+  }
+  return true;
+}
\ No newline at end of file
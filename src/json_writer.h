@@ -0,0 +1,82 @@
+// ============================================================================
+// json_writer.h - Allocation-free streaming JSON writer
+// ============================================================================
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <IPAddress.h>
+#endif
+
+// Receives each full buffer (and the tail on flush). Return false to abort.
+typedef bool (*JsonSink)(void* context, const char* data, size_t length);
+
+// Builds JSON into a caller-owned buffer - usually on the stack - and
+// hands it to a sink whenever the buffer fills, so a response of any size
+// goes out through a few hundred bytes without touching the heap. With no
+// sink the buffer is the whole document and overflow marks it failed.
+// Strings are escaped; separators are tracked per nesting level.
+class JsonWriter {
+private:
+  static const int MAX_DEPTH = 8;
+  
+  char* buffer;
+  size_t capacity;
+  size_t used;
+  size_t flushed;
+  JsonSink sink;
+  void* sinkContext;
+  bool needComma[MAX_DEPTH];
+  int depth;
+  bool failed;
+  
+  bool makeRoom();
+  void put(char c);
+  void put(const char* text);
+  void put(const char* data, size_t length);
+  void putEscaped(const char* text);
+  void putUnsigned(unsigned long long value);
+  void putSigned(long long value);
+  void separator();
+  void key(const char* name);
+  void open(const char* name, char bracket);
+  void close(char bracket);
+  
+public:
+  JsonWriter(char* buffer, size_t capacity, JsonSink sink = nullptr, void* sinkContext = nullptr);
+  
+  // Containers; pass a name inside an object, nullptr at top level or in arrays
+  JsonWriter& beginObject(const char* name = nullptr);
+  JsonWriter& endObject();
+  JsonWriter& beginArray(const char* name = nullptr);
+  JsonWriter& endArray();
+  
+  // Members (name is nullptr for array elements)
+  JsonWriter& field(const char* name, const char* value);
+  JsonWriter& field(const char* name, bool value);
+  JsonWriter& field(const char* name, int value) { return field(name, (long long)value); }
+  JsonWriter& field(const char* name, long value) { return field(name, (long long)value); }
+  JsonWriter& field(const char* name, long long value);
+  JsonWriter& field(const char* name, unsigned int value) { return field(name, (unsigned long long)value); }
+  JsonWriter& field(const char* name, unsigned long value) { return field(name, (unsigned long long)value); }
+  JsonWriter& field(const char* name, unsigned long long value);
+  JsonWriter& field(const char* name, double value, int decimals);
+  JsonWriter& nullField(const char* name);
+#ifdef ARDUINO
+  JsonWriter& field(const char* name, const String& value) { return field(name, value.c_str()); }
+  JsonWriter& field(const char* name, const IPAddress& ip);
+#endif
+
+  // Pushes buffered bytes to the sink. No-op without one.
+  bool flush();
+  
+  bool ok() const { return !failed; }
+  const char* data() const { return buffer; }
+  size_t length() const { return used; }            // Bytes still in the buffer
+  size_t flushedBytes() const { return flushed; }   // Bytes already handed to the sink
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+// ============================================================================
+// last_frame_cache.cpp - Last-frame cache implementation
+// ============================================================================
+#include "last_frame_cache.h"
+
+LastFrameCache::LastFrameCache()
+  : lock(xSemaphoreCreateMutex()), data(nullptr), capacity(0), length(0), width(0), height(0),
+    capturedAt(0), stores(0), hits(0), misses(0) {
+}
+
+void LastFrameCache::store(const camera_fb_t* fb) {
+  if (!CameraConfig::CACHE_LAST_FRAME || !fb || fb->format != PIXFORMAT_JPEG) return;
+  
+  xSemaphoreTake(lock, portMAX_DELAY);
+  
+  // Grow only; frame sizes move around with the adaptive quality level
+  if (fb->len > capacity) {
+    free(data);
+    data = (uint8_t*)ps_malloc(fb->len);
+    capacity = data ? fb->len : 0;
+  }
+  
+  if (data) {
+    memcpy(data, fb->buf, fb->len);
+    length = fb->len;
+    width = fb->width;
+    height = fb->height;
+    capturedAt = millis();
+    stores++;
+  } else {
+    length = 0;
+  }
+  
+  xSemaphoreGive(lock);
+}
+
+uint8_t* LastFrameCache::copyIfFresh(unsigned long maxAgeMs, size_t& outLength, unsigned long& outAge, uint32_t& outSequence) {
+  uint8_t* copy = nullptr;
+  
+  xSemaphoreTake(lock, portMAX_DELAY);
+  unsigned long age = millis() - capturedAt;
+  if (length > 0 && age <= maxAgeMs) {
+    copy = (uint8_t*)ps_malloc(length);
+    if (copy) {
+      memcpy(copy, data, length);
+      outLength = length;
+      outAge = age;
+      outSequence = stores;       // Counts only successful stores, so it names this frame
+    }
+  }
+  if (copy) {
+    hits++;
+  } else {
+    misses++;
+  }
+  xSemaphoreGive(lock);
+  
+  return copy;
+}
\ No newline at end of file
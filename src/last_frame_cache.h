@@ -0,0 +1,51 @@
+// ============================================================================
+// last_frame_cache.h - PSRAM copy of the most recent flash capture
+// ============================================================================
+#ifndef LAST_FRAME_CACHE_H
+#define LAST_FRAME_CACHE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_camera.h"
+#include "config.h"
+
+// Holds the last good JPEG from CameraModule::captureImage, whichever
+// caller triggered it (/capture or an analysis). A reader that only needs
+// a recent snapshot takes a copy instead of firing the flash and sensor.
+// Locked because captures and readers run on different tasks.
+class LastFrameCache {
+private:
+  SemaphoreHandle_t lock;
+  uint8_t* data;
+  size_t capacity;
+  size_t length;
+  uint16_t width;
+  uint16_t height;
+  unsigned long capturedAt;
+  
+  // Counters
+  uint32_t stores;
+  uint32_t hits;
+  uint32_t misses;
+  
+public:
+  LastFrameCache();
+  
+  void store(const camera_fb_t* fb);
+  
+  // Copies the cached frame into a new PSRAM buffer (caller frees) if it is
+  // at most maxAgeMs old. Counts a hit or a miss. outSequence identifies
+  // the frame copied, for caching anything derived from it.
+  uint8_t* copyIfFresh(unsigned long maxAgeMs, size_t& outLength, unsigned long& outAge, uint32_t& outSequence);
+  
+  // Status
+  bool hasFrame() const { return length > 0; }
+  unsigned long getAge() const { return hasFrame() ? millis() - capturedAt : 0; }
+  size_t getLength() const { return length; }
+  uint32_t getStores() const { return stores; }
+  uint32_t getHits() const { return hits; }
+  uint32_t getMisses() const { return misses; }
+};
+
+#endif
\ No newline at end of file
@@ -2,7 +2,6 @@
 // main.cpp - Main application file (WITH UART)
 // ============================================================================
 #include <Arduino.h>
-#include <WebServer.h>
 #include "config.h"
 #include "system_utils.h"
 #include "camera_module.h"
@@ -14,8 +13,7 @@
 CameraModule camera;
 WiFiModule wifiModule;
 UARTController uartController;  // NEW: UART controller instance
-WebServer server(SystemConfig::WEB_SERVER_PORT);
-WebServerManager webManager(&server, &camera, &wifiModule, &uartController);  // Pass UART controller
+WebServerManager webManager(&camera, &wifiModule, &uartController);  // Pass UART controller
 
 // Timing variables
 unsigned long lastHeartbeat = 0;
@@ -50,10 +48,10 @@ void setup() {
   // Initialize WiFi
   bool wifiSuccess = wifiModule.initialize();
   
-  // Setup and start web server
-  webManager.setupRoutes();
-  server.begin();
-  Serial.println("\nHTTP server started on port " + String(SystemConfig::WEB_SERVER_PORT));
+  // Start web server (runs on its own task)
+  if (!webManager.begin()) {
+    Serial.println("WARNING: HTTP server failed to start");
+  }
   
   // Print status information
   if (wifiSuccess) {
@@ -72,12 +70,15 @@ void setup() {
 }
 
 void loop() {
-  // Handle HTTP requests
-  webManager.handleClient();
-  
   // Check UART commands (NEW)
   uartController.checkForCommands();
   
+  // Push state changes to /events listeners
+  webManager.pollEvents();
+  
+  // Finish deferred responses that were waiting on a full socket
+  webManager.pollDeferred();
+  
   // Heartbeat every 5 seconds
   if (millis() - lastHeartbeat > SystemConfig::HEARTBEAT_INTERVAL) {
     SystemUtils::heartbeat();
@@ -0,0 +1,197 @@
+// ============================================================================
+// metrics.cpp - Metrics registry and Prometheus text export
+// ============================================================================
+#include "metrics.h"
+#include <stdarg.h>
+
+MetricsRegistry metrics;
+
+namespace MetricBuckets {
+  const uint32_t LATENCY_MS[] = {10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+  const int LATENCY_MS_COUNT = sizeof(LATENCY_MS) / sizeof(LATENCY_MS[0]);
+  const uint32_t HANDLER_US[] = {100, 250, 500, 1000, 2500, 5000, 10000, 50000, 250000, 1000000};
+  const int HANDLER_US_COUNT = sizeof(HANDLER_US) / sizeof(HANDLER_US[0]);
+  const uint32_t UPLOAD_BYTES[] = {4096, 8192, 16384, 32768, 65536, 131072, 262144};
+  const int UPLOAD_BYTES_COUNT = sizeof(UPLOAD_BYTES) / sizeof(UPLOAD_BYTES[0]);
+}
+
+void Histogram::observe(uint32_t value) {
+  if (!slot) return;
+  
+  int bucket = 0;
+  while (bucket < slot->boundCount && value > slot->bounds[bucket]) {
+    bucket++;
+  }
+  slot->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  uint32_t before = slot->sumLow.fetch_add(value, std::memory_order_relaxed);
+  if (before + value < before) {
+    slot->sumHigh.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+Counter MetricsRegistry::counter(const char* name, const char* help, const char* labels) {
+  if (counterCount >= MetricsConfig::MAX_COUNTERS) {
+    Serial.printf("Metrics: no counter slot for %s\n", name);
+    return Counter();
+  }
+  CounterSlot& slot = counters[counterCount++];
+  slot.name = name;
+  slot.help = help;
+  slot.labels = labels;
+  return Counter(&slot);
+}
+
+Gauge MetricsRegistry::gauge(const char* name, const char* help, const char* labels) {
+  if (gaugeCount >= MetricsConfig::MAX_GAUGES) {
+    Serial.printf("Metrics: no gauge slot for %s\n", name);
+    return Gauge();
+  }
+  GaugeSlot& slot = gauges[gaugeCount++];
+  slot.name = name;
+  slot.help = help;
+  slot.labels = labels;
+  return Gauge(&slot);
+}
+
+Histogram MetricsRegistry::histogram(const char* name, const char* help, const uint32_t* bounds, int boundCount,
+                                     float scale, const char* labels) {
+  if (histogramCount >= MetricsConfig::MAX_HISTOGRAMS || boundCount > MetricsConfig::MAX_BUCKETS) {
+    Serial.printf("Metrics: no histogram slot for %s\n", name);
+    return Histogram();
+  }
+  HistogramSlot& slot = histograms[histogramCount++];
+  slot.name = name;
+  slot.help = help;
+  slot.labels = labels;
+  slot.bounds = bounds;
+  slot.boundCount = boundCount;
+  slot.scale = scale;
+  return Histogram(&slot);
+}
+
+// ----------------------------------------------------------------------------
+// Export
+// ----------------------------------------------------------------------------
+
+namespace {
+  // Formats lines into the caller's buffer and hands it to the sink when full
+  struct TextOut {
+    char* buffer;
+    size_t size;
+    size_t length;
+    MetricsSink sink;
+    void* context;
+    bool ok;
+    
+    bool flush() {
+      if (ok && length > 0) {
+        ok = sink(context, buffer, length);
+      }
+      length = 0;
+      return ok;
+    }
+    
+    void printf(const char* format, ...) {
+      for (int attempt = 0; attempt < 2 && ok; attempt++) {
+        va_list args;
+        va_start(args, format);
+        int n = vsnprintf(buffer + length, size - length, format, args);
+        va_end(args);
+        if (n >= 0 && (size_t)n < size - length) {
+          length += n;
+          return;
+        }
+        // Didn't fit: flush and retry once into the empty buffer
+        if (length == 0) {
+          ok = false;
+          return;
+        }
+        flush();
+      }
+    }
+  };
+  
+  // Labels go in braces, with any extra label (le) after the slot's own
+  void writeLabels(TextOut& out, const char* labels, const char* extra = nullptr) {
+    bool any = labels && labels[0];
+    if (!any && !extra) return;
+    out.printf("{%s%s%s}", any ? labels : "", any && extra ? "," : "", extra ? extra : "");
+  }
+  
+  // A family's samples must be contiguous: print each name's header once,
+  // followed by every slot that shares the name
+  template <typename Slot>
+  bool firstOfFamily(const Slot* slots, int index) {
+    for (int i = 0; i < index; i++) {
+      if (strcmp(slots[i].name, slots[index].name) == 0) return false;
+    }
+    return true;
+  }
+}
+
+bool MetricsRegistry::write(char* buffer, size_t size, MetricsSink sink, void* context) {
+  TextOut out = {buffer, size, 0, sink, context, true};
+  
+  for (int i = 0; i < counterCount; i++) {
+    if (!firstOfFamily(counters, i)) continue;
+    out.printf("# HELP %s %s\n# TYPE %s counter\n", counters[i].name, counters[i].help, counters[i].name);
+    for (int j = i; j < counterCount; j++) {
+      if (strcmp(counters[j].name, counters[i].name) != 0) continue;
+      out.printf("%s", counters[j].name);
+      writeLabels(out, counters[j].labels);
+      out.printf(" %u\n", (unsigned)counters[j].value.load(std::memory_order_relaxed));
+    }
+  }
+  
+  for (int i = 0; i < gaugeCount; i++) {
+    if (!firstOfFamily(gauges, i)) continue;
+    out.printf("# HELP %s %s\n# TYPE %s gauge\n", gauges[i].name, gauges[i].help, gauges[i].name);
+    for (int j = i; j < gaugeCount; j++) {
+      if (strcmp(gauges[j].name, gauges[i].name) != 0) continue;
+      out.printf("%s", gauges[j].name);
+      writeLabels(out, gauges[j].labels);
+      out.printf(" %d\n", (int)gauges[j].value.load(std::memory_order_relaxed));
+    }
+  }
+  
+  for (int i = 0; i < histogramCount; i++) {
+    if (!firstOfFamily(histograms, i)) continue;
+    out.printf("# HELP %s %s\n# TYPE %s histogram\n", histograms[i].name, histograms[i].help, histograms[i].name);
+    for (int j = i; j < histogramCount; j++) {
+      const HistogramSlot& h = histograms[j];
+      if (strcmp(h.name, histograms[i].name) != 0) continue;
+      
+      // Buckets are read one at a time; _count is their total so the
+      // exported series always agree with each other
+      uint32_t cumulative = 0;
+      char le[24];
+      for (int b = 0; b <= h.boundCount; b++) {
+        cumulative += h.buckets[b].load(std::memory_order_relaxed);
+        if (b < h.boundCount) {
+          snprintf(le, sizeof(le), "le=\"%g\"", h.bounds[b] * h.scale);
+        } else {
+          snprintf(le, sizeof(le), "le=\"+Inf\"");
+        }
+        out.printf("%s_bucket", h.name);
+        writeLabels(out, h.labels, le);
+        out.printf(" %u\n", (unsigned)cumulative);
+      }
+      out.printf("%s_sum", h.name);
+      writeLabels(out, h.labels);
+      // A scrape inside the few instructions between a wrap and its carry
+      // reads one carry short; re-reading covers a carry landing mid-read
+      uint32_t high, low;
+      do {
+        high = h.sumHigh.load(std::memory_order_relaxed);
+        low = h.sumLow.load(std::memory_order_relaxed);
+      } while (high != h.sumHigh.load(std::memory_order_relaxed));
+      // %g would keep only 6 significant digits of a growing total
+      out.printf(" %.6f\n", (((uint64_t)high << 32) | low) * (double)h.scale);
+      out.printf("%s_count", h.name);
+      writeLabels(out, h.labels);
+      out.printf(" %u\n", (unsigned)cumulative);
+    }
+  }
+  
+  return out.flush();
+}
\ No newline at end of file
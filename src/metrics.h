@@ -0,0 +1,105 @@
+// ============================================================================
+// metrics.h - Counters, gauges and histograms exported at GET /metrics
+// ============================================================================
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+// Values are 32-bit atomics (native on the ESP32), so any task on either
+// core can update them without a lock. Counters and bucket counts wrap at
+// 2^32, which Prometheus rate() treats like a restart. Histogram sums need
+// more (2^32 us is only 72 minutes of handler time), but 64-bit atomics go
+// through libatomic's critical section on the ESP32, so a sum is kept as
+// two 32-bit words and a carry out of the low one bumps the high one.
+struct CounterSlot {
+  const char* name;
+  const char* help;
+  const char* labels;        // e.g. command="on"; nullptr for none
+  std::atomic<uint32_t> value;
+};
+
+struct GaugeSlot {
+  const char* name;
+  const char* help;
+  const char* labels;
+  std::atomic<int32_t> value;
+};
+
+struct HistogramSlot {
+  const char* name;
+  const char* help;
+  const char* labels;
+  const uint32_t* bounds;    // Ascending upper bounds, in recorded units
+  int boundCount;
+  float scale;               // Recorded units -> exported base unit (e.g. 0.001 for ms -> s)
+  std::atomic<uint32_t> buckets[MetricsConfig::MAX_BUCKETS + 1];   // Last one is +Inf
+  std::atomic<uint32_t> sumLow;
+  std::atomic<uint32_t> sumHigh;   // Carries out of sumLow
+};
+
+// Handles are what modules keep. A default-constructed (or overflowed)
+// handle ignores updates, so nothing has to check registration.
+class Counter {
+private:
+  CounterSlot* slot;
+public:
+  Counter(CounterSlot* s = nullptr) : slot(s) {}
+  void inc(uint32_t n = 1) { if (slot) slot->value.fetch_add(n, std::memory_order_relaxed); }
+};
+
+class Gauge {
+private:
+  GaugeSlot* slot;
+public:
+  Gauge(GaugeSlot* s = nullptr) : slot(s) {}
+  void set(int32_t v) { if (slot) slot->value.store(v, std::memory_order_relaxed); }
+};
+
+class Histogram {
+private:
+  HistogramSlot* slot;
+public:
+  Histogram(HistogramSlot* s = nullptr) : slot(s) {}
+  void observe(uint32_t value);
+};
+
+typedef bool (*MetricsSink)(void* context, const char* data, size_t length);
+
+// Fixed arrays only; registration happens once at startup. The registry
+// has no constructor so a global one is zeroed before any static
+// constructor can register into it.
+class MetricsRegistry {
+private:
+  CounterSlot counters[MetricsConfig::MAX_COUNTERS];
+  GaugeSlot gauges[MetricsConfig::MAX_GAUGES];
+  HistogramSlot histograms[MetricsConfig::MAX_HISTOGRAMS];
+  int counterCount;
+  int gaugeCount;
+  int histogramCount;
+  
+public:
+  Counter counter(const char* name, const char* help, const char* labels = nullptr);
+  Gauge gauge(const char* name, const char* help, const char* labels = nullptr);
+  Histogram histogram(const char* name, const char* help, const uint32_t* bounds, int boundCount,
+                      float scale, const char* labels = nullptr);
+  
+  // Prometheus text exposition format (0.0.4), written through buffer
+  bool write(char* buffer, size_t size, MetricsSink sink, void* context);
+};
+
+extern MetricsRegistry metrics;
+
+// Shared bucket layouts
+namespace MetricBuckets {
+  extern const uint32_t LATENCY_MS[];        // 10 ms .. 10 s
+  extern const int LATENCY_MS_COUNT;
+  extern const uint32_t HANDLER_US[];        // 100 us .. 1 s
+  extern const int HANDLER_US_COUNT;
+  extern const uint32_t UPLOAD_BYTES[];      // 4 KB .. 256 KB
+  extern const int UPLOAD_BYTES_COUNT;
+}
+
+#endif
\ No newline at end of file
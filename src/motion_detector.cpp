@@ -0,0 +1,134 @@
+// ============================================================================
+// motion_detector.cpp - Motion detector implementation
+// ============================================================================
+#include "motion_detector.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#define MOTION_ALLOC(size) ps_malloc(size)
+#else
+#define MOTION_ALLOC(size) malloc(size)
+#endif
+
+MotionDetector::MotionDetector(const MotionParams& p)
+  : params(p), background(nullptr), changed(nullptr), pixelCapacity(0), blockCapacity(0), width(0),
+    height(0), blocksX(0), blocksY(0), frames(0) {
+  if (params.blockSize == 0) params.blockSize = 1;
+}
+
+MotionDetector::~MotionDetector() {
+  free(background);
+  free(changed);
+}
+
+bool MotionDetector::allocate(uint16_t w, uint16_t h) {
+  size_t pixels = (size_t)w * h;
+  uint16_t bx = (w + params.blockSize - 1) / params.blockSize;
+  uint16_t by = (h + params.blockSize - 1) / params.blockSize;
+  size_t blocks = (size_t)bx * by;
+  
+  // Grow only; frame sizes move around with the adaptive quality level
+  if (pixels > pixelCapacity) {
+    free(background);
+    background = (uint16_t*)MOTION_ALLOC(pixels * sizeof(uint16_t));
+    pixelCapacity = background ? pixels : 0;
+  }
+  if (blocks > blockCapacity) {
+    free(changed);
+    changed = (uint8_t*)MOTION_ALLOC(blocks);
+    blockCapacity = changed ? blocks : 0;
+  }
+  if (!background || !changed) return false;
+  
+  width = w;
+  height = h;
+  blocksX = bx;
+  blocksY = by;
+  return true;
+}
+
+void MotionDetector::seed(const uint8_t* gray) {
+  size_t pixels = (size_t)width * height;
+  for (size_t i = 0; i < pixels; i++) {
+    background[i] = gray[i] << 8;
+  }
+}
+
+bool MotionDetector::hasChangedNeighbour(int bx, int by) const {
+  for (int dy = -1; dy <= 1; dy++) {
+    for (int dx = -1; dx <= 1; dx++) {
+      if (dx == 0 && dy == 0) continue;
+      int x = bx + dx;
+      int y = by + dy;
+      if (x >= 0 && y >= 0 && x < blocksX && y < blocksY && changed[y * blocksX + x]) return true;
+    }
+  }
+  return false;
+}
+
+MotionResult MotionDetector::process(const uint8_t* gray, uint16_t w, uint16_t h) {
+  MotionResult result = {false, false, 0, 0};
+  if (!gray || w == 0 || h == 0) return result;
+  
+  if (frames == 0 || w != width || h != height) {
+    if (!allocate(w, h)) return result;
+    seed(gray);
+    frames = 1;
+    result.totalBlocks = blocksX * blocksY;
+    return result;
+  }
+  
+  const int size = params.blockSize;
+  int rawChanged = 0;
+  for (int by = 0; by < blocksY; by++) {
+    for (int bx = 0; bx < blocksX; bx++) {
+      uint32_t sum = 0;
+      int count = 0;
+      for (int y = by * size; y < (by + 1) * size && y < height; y++) {
+        for (int x = bx * size; x < (bx + 1) * size && x < width; x++) {
+          int i = y * width + x;
+          int diff = abs((int)gray[i] - (background[i] >> 8));
+          if (diff > params.pixelNoise) sum += diff - params.pixelNoise;
+          count++;
+        }
+      }
+      bool blockChanged = sum > (uint32_t)params.blockThreshold * count;
+      changed[by * blocksX + bx] = blockChanged;
+      rawChanged += blockChanged;
+    }
+  }
+  
+  result.totalBlocks = blocksX * blocksY;
+  
+  // Most of the frame at once: exposure or lighting moved, not the scene.
+  // Adopt the new frame outright rather than fading toward it.
+  if (rawChanged * 100 > params.lightingPercent * result.totalBlocks) {
+    seed(gray);
+    frames++;
+    result.lightingChange = true;
+    return result;
+  }
+  
+  for (int by = 0; by < blocksY; by++) {
+    for (int bx = 0; bx < blocksX; bx++) {
+      if (changed[by * blocksX + bx] && hasChangedNeighbour(bx, by)) result.changedBlocks++;
+    }
+  }
+  
+  // Slow learning inside changed blocks keeps a lingering animal from
+  // fading into the background after a few frames
+  for (int y = 0; y < height; y++) {
+    const uint8_t* blockRow = changed + (y / size) * blocksX;
+    for (int x = 0; x < width; x++) {
+      int i = y * width + x;
+      int shift = blockRow[x / size] ? params.motionLearnShift : params.learnShift;
+      int32_t delta = ((int32_t)gray[i] << 8) - background[i];
+      background[i] += delta >> shift;
+    }
+  }
+  
+  frames++;
+  result.motion = frames > params.warmupFrames && result.changedBlocks >= params.minBlocks;
+  return result;
+}
\ No newline at end of file
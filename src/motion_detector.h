@@ -0,0 +1,68 @@
+// ============================================================================
+// motion_detector.h - Background-subtraction motion detector
+// ============================================================================
+#ifndef MOTION_DETECTOR_H
+#define MOTION_DETECTOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Tuning. Thresholds are in luma levels (0-255) of the reduced frame; the
+// defaults suit the 1/8-scale DC-only decode the firmware feeds in.
+struct MotionParams {
+  uint8_t blockSize = 2;          // Grid pixels per block side (16 source pixels at 1/8 scale)
+  uint8_t pixelNoise = 6;         // Per-pixel differences up to this are sensor noise
+  uint8_t blockThreshold = 10;    // Mean difference beyond the noise floor that marks a block changed
+  uint8_t minBlocks = 2;          // Changed blocks, after isolated ones are dropped, that make motion
+  uint8_t lightingPercent = 60;   // More of the frame changing at once is exposure or lighting
+  uint8_t learnShift = 4;         // Background follows the scene by 1/16 per frame...
+  uint8_t motionLearnShift = 7;   // ...but only 1/128 where something is moving
+  uint8_t warmupFrames = 8;       // Frames to settle the background before reporting
+};
+
+struct MotionResult {
+  bool motion;
+  bool lightingChange;            // Whole-frame change; background re-seeded
+  uint16_t changedBlocks;         // After noise suppression
+  uint16_t totalBlocks;
+};
+
+// Plain C++ with no Arduino or FreeRTOS dependency so the same code runs
+// on the host against recorded frames (tools/motion_replay.cpp).
+//
+// The background is a per-pixel running average in 8.8 fixed point. A
+// frame is split into blocks; a block changes when its mean difference
+// from the background, with the per-pixel noise floor taken off first,
+// passes blockThreshold. A changed block with no changed neighbour is
+// treated as noise, and a frame where most blocks change at once is a
+// lighting change (flash, AE step, clouds), not motion.
+class MotionDetector {
+private:
+  MotionParams params;
+  uint16_t* background;           // 8.8 luma per grid pixel
+  uint8_t* changed;               // Per block, this frame
+  size_t pixelCapacity;
+  size_t blockCapacity;
+  uint16_t width;
+  uint16_t height;
+  uint16_t blocksX;
+  uint16_t blocksY;
+  uint32_t frames;
+  
+  bool allocate(uint16_t w, uint16_t h);
+  void seed(const uint8_t* gray);
+  bool hasChangedNeighbour(int bx, int by) const;
+  
+public:
+  explicit MotionDetector(const MotionParams& p = MotionParams());
+  ~MotionDetector();
+  
+  // gray is width x height luma, row-major. A size change restarts the
+  // background.
+  MotionResult process(const uint8_t* gray, uint16_t width, uint16_t height);
+  void reset() { frames = 0; }
+  
+  const MotionParams& getParams() const { return params; }
+};
+
+#endif
\ No newline at end of file
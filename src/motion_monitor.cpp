@@ -0,0 +1,179 @@
+// ============================================================================
+// motion_monitor.cpp - Motion watch task implementation
+// ============================================================================
+#include "motion_monitor.h"
+#include "jpeg_decode.h"
+
+namespace {
+  struct DecodeState {
+    const camera_fb_t* fb;
+    MotionMonitor* owner;
+  };
+}
+
+MotionMonitor::MotionMonitor(CameraModule* cam)
+  : camera(cam), taskHandle(nullptr), onMotion(nullptr), callbackContext(nullptr), gray(nullptr),
+    grayCapacity(0), grayWidth(0), grayHeight(0), lastMotionAt(0), lastTriggerAt(0), inMotion(false),
+    lastResult{false, false, 0, 0}, meter{0, 0, 0}, windowStart(0), windowBusyUs(0), cpuPercent(0),
+    framesProcessed(0), motionFrames(0), lightingChanges(0), decodeFailures(0), triggers(0),
+    uploadsPassed(0), uploadsAvoided(0) {
+}
+
+bool MotionMonitor::begin(MotionCallback callback, void* context) {
+  onMotion = callback;
+  callbackContext = context;
+  
+  const char* help = "Analyses by whether the motion gate let the upload through";
+  passedCount = metrics.counter("honeybadger_motion_gate_total", help, "result=\"passed\"");
+  avoidedCount = metrics.counter("honeybadger_motion_gate_total", help, "result=\"avoided\"");
+  
+  // Core 1 with the capture task, leaving core 0 to WiFi and uploads
+  BaseType_t created = xTaskCreatePinnedToCore(monitorTask, "motion", MotionConfig::TASK_STACK,
+                                               this, MotionConfig::TASK_PRIORITY, &taskHandle, 1);
+  if (created != pdPASS) {
+    taskHandle = nullptr;
+    Serial.println("Motion task creation failed");
+    return false;
+  }
+  
+  Serial.printf("Motion monitor started (%d fps, gate %s)\n", MotionConfig::SAMPLE_FPS,
+                MotionConfig::GATE_UPLOADS ? "on" : "off");
+  return true;
+}
+
+void MotionMonitor::monitorTask(void* param) {
+  static_cast<MotionMonitor*>(param)->monitorLoop();
+}
+
+void MotionMonitor::monitorLoop() {
+  const TickType_t period = pdMS_TO_TICKS(1000 / MotionConfig::SAMPLE_FPS);
+  TickType_t wake = xTaskGetTickCount();
+  
+  while (true) {
+    vTaskDelayUntil(&wake, period);
+    
+    camera_fb_t* fb = camera->grabFrame();
+    if (!fb) continue;
+    
+    // A capture-size frame would restart the background; wait for watch frames
+    if (fb->width != resolution[camera->getWatchProfile().frameSize].width) {
+      camera->releaseFrameBuffer(fb);
+      continue;
+    }
+    
+    unsigned long start = micros();
+    bool decoded = decode(fb);
+    camera->releaseFrameBuffer(fb);
+    if (!decoded) {
+      decodeFailures++;
+      continue;
+    }
+    
+    lastResult = detector.process(gray, grayWidth, grayHeight);
+    noteBusy(micros() - start);
+    framesProcessed++;
+    meter.tick();
+    
+    if (lastResult.lightingChange) {
+      lightingChanges++;
+    }
+    if (!lastResult.motion) {
+      inMotion = false;
+      continue;
+    }
+    
+    motionFrames++;
+    lastMotionAt = millis();
+    
+    // Onset only, and not more often than the cooldown
+    bool onset = !inMotion;
+    inMotion = true;
+    if (onset && onMotion && MotionConfig::AUTO_ANALYZE &&
+        (lastTriggerAt == 0 || millis() - lastTriggerAt >= (unsigned long)MotionConfig::TRIGGER_COOLDOWN_MS)) {
+      lastTriggerAt = millis();
+      triggers++;
+      Serial.printf("Motion: %u of %u blocks changed - starting analysis\n",
+                    lastResult.changedBlocks, lastResult.totalBlocks);
+      onMotion(callbackContext);
+    }
+  }
+}
+
+void MotionMonitor::noteBusy(uint32_t busyUs) {
+  unsigned long now = millis();
+  if (windowStart == 0) windowStart = now;
+  windowBusyUs += busyUs;
+  if (now - windowStart >= 1000) {
+    cpuPercent = windowBusyUs / (10.0f * (now - windowStart));
+    windowStart = now;
+    windowBusyUs = 0;
+  }
+}
+
+bool MotionMonitor::motionWithin(unsigned long ms) const {
+  unsigned long at = lastMotionAt;
+  return at != 0 && millis() - at <= ms;
+}
+
+void MotionMonitor::recordUpload(bool passed) {
+  if (passed) {
+    uploadsPassed++;
+    passedCount.inc();
+  } else {
+    uploadsAvoided++;
+    avoidedCount.inc();
+  }
+}
+
+bool MotionMonitor::decode(const camera_fb_t* fb) {
+  if (fb->format != PIXFORMAT_JPEG || fb->len == 0) return false;
+  
+  DecodeState state = {fb, this};
+  grayWidth = 0;
+  grayHeight = 0;
+  return JpegDecode::decode(fb->len, JPG_SCALE_8X, readJpeg, writeBlock, &state) == ESP_OK && grayWidth > 0;
+}
+
+size_t MotionMonitor::readJpeg(void* arg, size_t index, uint8_t* buf, size_t len) {
+  const camera_fb_t* fb = static_cast<DecodeState*>(arg)->fb;
+  if (index >= fb->len) return 0;
+  if (index + len > fb->len) {
+    len = fb->len - index;
+  }
+  if (buf) {
+    memcpy(buf, fb->buf + index, len);
+  }
+  return len;
+}
+
+bool MotionMonitor::writeBlock(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data) {
+  MotionMonitor* self = static_cast<DecodeState*>(arg)->owner;
+  
+  // Called with no data at start (output size) and at the end
+  if (!data) {
+    if (x == 0 && y == 0 && self->grayWidth == 0) {
+      size_t pixels = (size_t)w * h;
+      if (pixels > self->grayCapacity) {
+        free(self->gray);
+        self->gray = (uint8_t*)ps_malloc(pixels);
+        self->grayCapacity = self->gray ? pixels : 0;
+        if (!self->gray) return false;
+      }
+      self->grayWidth = w;
+      self->grayHeight = h;
+    }
+    return true;
+  }
+  if (self->grayWidth == 0) return false;
+  
+  // data is an RGB888 block of w x h pixels at (x, y)
+  for (uint16_t row = 0; row < h && y + row < self->grayHeight; row++) {
+    const uint8_t* px = data + (size_t)row * w * 3;
+    uint8_t* out = self->gray + (size_t)(y + row) * self->grayWidth + x;
+    for (uint16_t col = 0; col < w && x + col < self->grayWidth; col++) {
+      out[col] = (px[0] + 2 * px[1] + px[2]) / 4;
+      px += 3;
+    }
+  }
+  return true;
+}
\ No newline at end of file
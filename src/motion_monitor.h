@@ -0,0 +1,91 @@
+// ============================================================================
+// motion_monitor.h - Continuous motion watch that gates backend uploads
+// ============================================================================
+#ifndef MOTION_MONITOR_H
+#define MOTION_MONITOR_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "camera_module.h"
+#include "motion_detector.h"
+#include "metrics.h"
+#include "config.h"
+
+typedef void (*MotionCallback)(void* context);
+
+// Samples frames at MotionConfig::SAMPLE_FPS, decodes them at 1/8 scale
+// into a luma grid and runs the detector. At 1/8 scale tjpgd keeps only
+// each 8x8 block's DC coefficient, so there is no IDCT and the decode
+// costs little more than the entropy pass. The analysis path asks
+// motionWithin() before uploading; motion onset can also start one.
+class MotionMonitor {
+private:
+  CameraModule* camera;
+  MotionDetector detector;
+  TaskHandle_t taskHandle;
+  MotionCallback onMotion;
+  void* callbackContext;
+  
+  uint8_t* gray;             // Decoded luma grid (PSRAM, grow only)
+  size_t grayCapacity;
+  uint16_t grayWidth;
+  uint16_t grayHeight;
+  
+  volatile unsigned long lastMotionAt;
+  unsigned long lastTriggerAt;
+  bool inMotion;
+  MotionResult lastResult;
+  
+  // Throughput and CPU share of one core, over roughly the last second
+  RateMeter meter;
+  unsigned long windowStart;
+  uint32_t windowBusyUs;
+  float cpuPercent;
+  
+  // Counters
+  uint32_t framesProcessed;
+  uint32_t motionFrames;
+  uint32_t lightingChanges;
+  uint32_t decodeFailures;
+  uint32_t triggers;
+  uint32_t uploadsPassed;
+  uint32_t uploadsAvoided;
+  Counter passedCount;
+  Counter avoidedCount;
+  
+  static void monitorTask(void* param);
+  void monitorLoop();
+  bool decode(const camera_fb_t* fb);
+  void noteBusy(uint32_t busyUs);
+  static size_t readJpeg(void* arg, size_t index, uint8_t* buf, size_t len);
+  static bool writeBlock(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data);
+  
+public:
+  explicit MotionMonitor(CameraModule* cam);
+  
+  // callback runs on the monitor task when motion starts (rate limited)
+  bool begin(MotionCallback callback, void* context);
+  bool isRunning() const { return taskHandle != nullptr; }
+  
+  bool motionWithin(unsigned long ms) const;
+  
+  // Upload gate bookkeeping, called by the analysis path
+  void recordUpload(bool passed);
+  
+  // Status
+  float getFps() const { return meter.rate; }
+  float getCpuPercent() const { return cpuPercent; }
+  unsigned long getLastMotionAge() const { return lastMotionAt ? millis() - lastMotionAt : 0; }
+  bool hasSeenMotion() const { return lastMotionAt != 0; }
+  const MotionResult& getLastResult() const { return lastResult; }
+  uint32_t getFramesProcessed() const { return framesProcessed; }
+  uint32_t getMotionFrames() const { return motionFrames; }
+  uint32_t getLightingChanges() const { return lightingChanges; }
+  uint32_t getDecodeFailures() const { return decodeFailures; }
+  uint32_t getTriggers() const { return triggers; }
+  uint32_t getUploadsPassed() const { return uploadsPassed; }
+  uint32_t getUploadsAvoided() const { return uploadsAvoided; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+// ============================================================================
+// multipart_stream.cpp - Zero-copy multipart/form-data body implementation
+// ============================================================================
+#include "multipart_stream.h"
+
+MultipartStream::MultipartStream(camera_fb_t* fb, const String& boundary)
+  : image(fb->buf), imageLength(fb->len), position(0) {
+  preamble = "--" + boundary + "\r\n";
+  preamble += "Content-Disposition: form-data; name=\"image\"; filename=\"capture.jpg\"\r\n";
+  preamble += "Content-Type: image/jpeg\r\n\r\n";
+  
+  epilogue = "\r\n--" + boundary + "--\r\n";
+}
+
+int MultipartStream::available() {
+  size_t remaining = totalLength() - position;
+  // Stream::available() is an int; clamp so huge frames never go negative
+  return remaining > INT32_MAX ? INT32_MAX : (int)remaining;
+}
+
+int MultipartStream::peek() {
+  size_t offset = position;
+  
+  if (offset < preamble.length()) {
+    return (uint8_t)preamble[offset];
+  }
+  offset -= preamble.length();
+  
+  if (offset < imageLength) {
+    return image[offset];
+  }
+  offset -= imageLength;
+  
+  if (offset < epilogue.length()) {
+    return (uint8_t)epilogue[offset];
+  }
+  return -1;
+}
+
+int MultipartStream::read() {
+  int c = peek();
+  if (c >= 0) {
+    position++;
+  }
+  return c;
+}
+
+size_t MultipartStream::readBytes(char* buffer, size_t length) {
+  uint8_t* dest = (uint8_t*)buffer;
+  size_t copied = 0;
+  
+  size_t imageStart = preamble.length();
+  size_t epilogueStart = imageStart + imageLength;
+  
+  copied += copySegment((const uint8_t*)preamble.c_str(), preamble.length(), 0,
+                        dest + copied, length - copied);
+  copied += copySegment(image, imageLength, imageStart,
+                        dest + copied, length - copied);
+  copied += copySegment((const uint8_t*)epilogue.c_str(), epilogue.length(), epilogueStart,
+                        dest + copied, length - copied);
+                        
+  return copied;
+}
+
+size_t MultipartStream::copySegment(const uint8_t* src, size_t srcLength, size_t segmentStart,
+                                    uint8_t* dest, size_t maxLength) {
+  if (maxLength == 0 || position < segmentStart || position >= segmentStart + srcLength) {
+    return 0;
+  }
+  
+  size_t offset = position - segmentStart;
+  size_t toCopy = min(srcLength - offset, maxLength);
+  memcpy(dest, src + offset, toCopy);
+  position += toCopy;
+  return toCopy;
+}
\ No newline at end of file
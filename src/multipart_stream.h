@@ -0,0 +1,41 @@
+// ============================================================================
+// multipart_stream.h - Zero-copy multipart/form-data body for frame uploads
+// ============================================================================
+#ifndef MULTIPART_STREAM_H
+#define MULTIPART_STREAM_H
+
+#include <Arduino.h>
+#include "esp_camera.h"
+
+// Read-only Stream that yields the multipart preamble, then the JPEG bytes
+// straight out of the camera frame buffer, then the closing boundary.
+// HTTPClient::sendRequest() pulls from it in TCP-sized chunks, so the
+// full frame is never duplicated in heap.
+class MultipartStream : public Stream {
+private:
+  String preamble;
+  String epilogue;
+  const uint8_t* image;
+  size_t imageLength;
+  size_t position;
+  
+  size_t copySegment(const uint8_t* src, size_t srcLength, size_t segmentStart,
+                     uint8_t* dest, size_t maxLength);
+                     
+public:
+  MultipartStream(camera_fb_t* fb, const String& boundary);
+  
+  size_t totalLength() const { return preamble.length() + imageLength + epilogue.length(); }
+  void rewind() { position = 0; }
+  
+  // Stream interface (read side)
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char* buffer, size_t length) override;
+  
+  // Print interface (unused - body is read-only)
+  size_t write(uint8_t) override { return 0; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+// ============================================================================
+// perceptual_hash.cpp - Difference hash implementation
+// ============================================================================
+#include "perceptual_hash.h"
+#include "jpeg_decode.h"
+
+bool PerceptualHash::compute(const camera_fb_t* fb, uint64_t& hash) {
+  if (!fb || fb->format != PIXFORMAT_JPEG || fb->len == 0) return false;
+  
+  Accumulator acc;
+  memset(&acc, 0, sizeof(acc));
+  acc.fb = fb;
+  
+  // 1/8 scale keeps the decode cheap; a 9x8 grid needs far less detail
+  if (JpegDecode::decode(fb->len, JPG_SCALE_8X, readJpeg, writeBlock, &acc) != ESP_OK) {
+    return false;
+  }
+  
+  uint32_t gray[GRID_H][GRID_W];
+  for (int gy = 0; gy < GRID_H; gy++) {
+    for (int gx = 0; gx < GRID_W; gx++) {
+      if (acc.count[gy][gx] == 0) return false;  // Image smaller than the grid
+      gray[gy][gx] = acc.sum[gy][gx] / acc.count[gy][gx];
+    }
+  }
+  
+  hash = 0;
+  for (int gy = 0; gy < GRID_H; gy++) {
+    for (int gx = 0; gx < GRID_W - 1; gx++) {
+      hash = (hash << 1) | (gray[gy][gx] > gray[gy][gx + 1] ? 1 : 0);
+    }
+  }
+  return true;
+}
+
+int PerceptualHash::distance(uint64_t a, uint64_t b) {
+  return __builtin_popcountll(a ^ b);
+}
+
+size_t PerceptualHash::readJpeg(void* arg, size_t index, uint8_t* buf, size_t len) {
+  const camera_fb_t* fb = static_cast<Accumulator*>(arg)->fb;
+  if (index >= fb->len) return 0;
+  if (index + len > fb->len) {
+    len = fb->len - index;
+  }
+  if (buf) {
+    memcpy(buf, fb->buf + index, len);
+  }
+  return len;
+}
+
+bool PerceptualHash::writeBlock(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data) {
+  Accumulator* acc = static_cast<Accumulator*>(arg);
+  
+  // Called with no data at start (output size) and at the end
+  if (!data) {
+    if (x == 0 && y == 0) {
+      acc->width = w;
+      acc->height = h;
+    }
+    return true;
+  }
+  if (acc->width == 0 || acc->height == 0) return false;
+  
+  // data is an RGB888 block of w x h pixels at (x, y)
+  for (uint16_t row = 0; row < h; row++) {
+    int gy = (int)(y + row) * GRID_H / acc->height;
+    if (gy >= GRID_H) break;
+    
+    for (uint16_t col = 0; col < w; col++) {
+      int gx = (int)(x + col) * GRID_W / acc->width;
+      if (gx >= GRID_W) break;
+      
+      const uint8_t* px = data + ((size_t)row * w + col) * 3;
+      acc->sum[gy][gx] += (px[0] + 2 * px[1] + px[2]) / 4;
+      acc->count[gy][gx]++;
+    }
+  }
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+// ============================================================================
+// perceptual_hash.h - Difference hash (dHash) of a captured JPEG frame
+// ============================================================================
+#ifndef PERCEPTUAL_HASH_H
+#define PERCEPTUAL_HASH_H
+
+#include <Arduino.h>
+#include "esp_camera.h"
+
+// 64-bit dHash: the frame is decoded at 1/8 scale, reduced to a 9x8
+// grayscale grid, and each bit records whether a cell is brighter than its
+// right-hand neighbour. Small changes in exposure or JPEG noise flip few
+// bits, so near-identical scenes land a short Hamming distance apart.
+class PerceptualHash {
+private:
+  static const int GRID_W = 9;
+  static const int GRID_H = 8;
+  
+  struct Accumulator {
+    const camera_fb_t* fb;
+    uint16_t width;
+    uint16_t height;
+    uint32_t sum[GRID_H][GRID_W];
+    uint16_t count[GRID_H][GRID_W];
+  };
+  
+  static size_t readJpeg(void* arg, size_t index, uint8_t* buf, size_t len);
+  static bool writeBlock(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data);
+  
+public:
+  // Returns false if the frame isn't a decodable JPEG
+  static bool compute(const camera_fb_t* fb, uint64_t& hash);
+  static int distance(uint64_t a, uint64_t b);
+};
+
+#endif
\ No newline at end of file
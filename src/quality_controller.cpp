@@ -0,0 +1,145 @@
+// ============================================================================
+// quality_controller.cpp - Closed-loop quality controller implementation
+// ============================================================================
+#include "quality_controller.h"
+
+// Cheapest first. Nothing here may exceed CameraConfig::MAX_FRAME_SIZE,
+// which sizes the frame buffer at init.
+const QualityProfile QualityController::PROFILES[] = {
+  { FRAMESIZE_QQVGA, 30, "QQVGA q30" },
+  { FRAMESIZE_QVGA,  25, "QVGA q25"  },
+  { FRAMESIZE_QVGA,  20, "QVGA q20"  },
+  { FRAMESIZE_CIF,   18, "CIF q18"   },
+  { FRAMESIZE_VGA,   15, "VGA q15"   },
+  { FRAMESIZE_SVGA,  12, "SVGA q12"  },
+};
+const int QualityController::PROFILE_COUNT = sizeof(PROFILES) / sizeof(PROFILES[0]);
+
+QualityController::QualityController() : enabled(AdaptiveConfig::ENABLED) {
+  reset();
+}
+
+void QualityController::reset() {
+  reset(CameraConfig::FRAME_SIZE, CameraConfig::JPEG_QUALITY);
+}
+
+void QualityController::reset(framesize_t frameSize, int jpegQuality) {
+  // The ladder grows in pixels and, within a size, in quality (lower q)
+  uint32_t pixels = pixelCount(frameSize);
+  level = 0;
+  for (int i = 0; i < PROFILE_COUNT; i++) {
+    uint32_t stepPixels = pixelCount(PROFILES[i].frameSize);
+    if (stepPixels < pixels || (stepPixels == pixels && PROFILES[i].jpegQuality >= jpegQuality)) {
+      level = i;
+    }
+  }
+  
+  avgLatency = 0;
+  avgBytes = 0;
+  slowStreak = 0;
+  fastStreak = 0;
+  lastRSSI = 0;
+  lastChange = 0;
+  changeCount = 0;
+  lastDecision = "init";
+}
+
+bool QualityController::update(unsigned long latencyMs, size_t payloadBytes, int rssi,
+                               bool linkFailed, unsigned long now) {
+  if (!enabled) return false;
+  
+  lastRSSI = rssi;
+  bool cooldownDone = (now - lastChange >= (unsigned long)AdaptiveConfig::COOLDOWN_MS) || changeCount == 0;
+  
+  // A timed-out or dropped upload is the strongest "too slow" signal:
+  // step down right away instead of waiting for the average to catch up
+  if (linkFailed) {
+    if (level > 0) {
+      changeLevel(level - 1, "down (link failure)", now);
+      return true;
+    }
+    lastDecision = "hold (link failure, at minimum)";
+    return false;
+  }
+  
+  const float alpha = AdaptiveConfig::EWMA_ALPHA;
+  avgLatency = (avgLatency == 0) ? latencyMs : avgLatency + alpha * (latencyMs - avgLatency);
+  avgBytes = (avgBytes == 0) ? payloadBytes : avgBytes + alpha * (payloadBytes - avgBytes);
+  
+  float high = AdaptiveConfig::TARGET_LATENCY_MS * (100 + AdaptiveConfig::HYSTERESIS_PERCENT) / 100.0f;
+  float low = AdaptiveConfig::TARGET_LATENCY_MS * (100 - AdaptiveConfig::HYSTERESIS_PERCENT) / 100.0f;
+  
+  if (avgLatency > high) {
+    slowStreak++;
+    fastStreak = 0;
+  } else if (avgLatency < low) {
+    fastStreak++;
+    slowStreak = 0;
+  } else {
+    slowStreak = 0;
+    fastStreak = 0;
+    lastDecision = "hold (on target)";
+    return false;
+  }
+  
+  if (!cooldownDone) {
+    lastDecision = "hold (cooldown)";
+    return false;
+  }
+  
+  if (slowStreak >= AdaptiveConfig::DOWN_STREAK) {
+    if (level > 0) {
+      changeLevel(level - 1, "down (slow)", now);
+      return true;
+    }
+    lastDecision = "hold (slow, at minimum)";
+    return false;
+  }
+  
+  if (fastStreak >= AdaptiveConfig::UP_STREAK) {
+    if (level >= PROFILE_COUNT - 1) {
+      lastDecision = "hold (fast, at maximum)";
+      return false;
+    }
+    if (rssi < AdaptiveConfig::MIN_RSSI_FOR_UPGRADE) {
+      lastDecision = "hold (weak signal)";
+      return false;
+    }
+    
+    // Upload time scales roughly with payload, which scales with pixels;
+    // don't step up if the next profile is predicted to overshoot
+    float ratio = (float)pixelCount(PROFILES[level + 1].frameSize) / pixelCount(PROFILES[level].frameSize);
+    if (avgLatency * ratio > high) {
+      lastDecision = "hold (next profile predicted too slow)";
+      return false;
+    }
+    
+    changeLevel(level + 1, "up (fast)", now);
+    return true;
+  }
+  
+  lastDecision = slowStreak > 0 ? "hold (slow, confirming)" : "hold (fast, confirming)";
+  return false;
+}
+
+float QualityController::getThroughput() const {
+  // bytes per ms == KB/s
+  return avgLatency > 0 ? avgBytes / avgLatency : 0;
+}
+
+uint32_t QualityController::pixelCount(framesize_t frameSize) {
+  return (uint32_t)resolution[frameSize].width * resolution[frameSize].height;
+}
+
+void QualityController::changeLevel(int newLevel, const char* decision, unsigned long now) {
+  level = newLevel;
+  lastDecision = decision;
+  lastChange = now;
+  changeCount++;
+  
+  // Old averages describe the previous profile; start measuring afresh
+  avgLatency = 0;
+  avgBytes = 0;
+  slowStreak = 0;
+  fastStreak = 0;
+}
\ No newline at end of file
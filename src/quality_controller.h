@@ -0,0 +1,68 @@
+// ============================================================================
+// quality_controller.h - Closed-loop JPEG quality / frame size controller
+// ============================================================================
+#ifndef QUALITY_CONTROLLER_H
+#define QUALITY_CONTROLLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sensor.h"
+#include "config.h"
+
+struct QualityProfile {
+  framesize_t frameSize;
+  int jpegQuality;
+  const char* name;
+};
+
+// Walks a fixed ladder of frame size / JPEG quality profiles toward
+// AdaptiveConfig::TARGET_LATENCY_MS, using the httpDuration and upload
+// size of each analysis. A deadband around the target, a streak
+// requirement and a cooldown keep it from oscillating. The controller
+// only decides; CameraModule::applyProfile() pushes the result to the
+// sensor.
+class QualityController {
+private:
+  static const QualityProfile PROFILES[];
+  static const int PROFILE_COUNT;
+  
+  bool enabled;
+  int level;
+  float avgLatency;         // EWMA of httpDuration (ms), 0 = no samples yet
+  float avgBytes;           // EWMA of upload size (bytes)
+  int slowStreak;
+  int fastStreak;
+  int lastRSSI;
+  unsigned long lastChange;
+  unsigned long changeCount;
+  const char* lastDecision;
+  
+  static uint32_t pixelCount(framesize_t frameSize);
+  void changeLevel(int newLevel, const char* decision, unsigned long now);
+  
+public:
+  QualityController();
+  
+  // Start from the profile closest to the compiled-in camera settings, or
+  // to the given ones: the richest step that doesn't exceed them
+  void reset();
+  void reset(framesize_t frameSize, int jpegQuality);
+  void setEnabled(bool on) { enabled = on; }
+  bool isEnabled() const { return enabled; }
+  
+  // Feed one analysis. Returns true when the active profile changed.
+  bool update(unsigned long latencyMs, size_t payloadBytes, int rssi, bool linkFailed, unsigned long now);
+  
+  // Status
+  const QualityProfile& getProfile() const { return PROFILES[level]; }
+  int getLevel() const { return level; }
+  int getLevelCount() const { return PROFILE_COUNT; }
+  float getAverageLatency() const { return avgLatency; }
+  float getAverageBytes() const { return avgBytes; }
+  float getThroughput() const;
+  int getLastRSSI() const { return lastRSSI; }
+  unsigned long getChangeCount() const { return changeCount; }
+  const char* getLastDecision() const { return lastDecision; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+// ============================================================================
+// result_cache.cpp - Perceptual hash result cache implementation
+// ============================================================================
+#include "result_cache.h"
+#include "perceptual_hash.h"
+
+ResultCache::ResultCache()
+  : enabled(CacheConfig::ENABLED), lookups(0), hits(0), hashFailures(0), savedBytes(0) {
+}
+
+bool ResultCache::lookup(uint64_t hash, unsigned long now, size_t frameBytes, AnalysisResult& out, int& distance) {
+  if (!enabled) return false;
+  lookups++;
+  
+  Entry* best = nullptr;
+  int bestDistance = CacheConfig::MAX_DISTANCE + 1;
+  for (int i = 0; i < CacheConfig::ENTRIES; i++) {
+    if (!isFresh(entries[i], now)) continue;
+    
+    int d = PerceptualHash::distance(hash, entries[i].hash);
+    if (d < bestDistance) {
+      best = &entries[i];
+      bestDistance = d;
+    }
+  }
+  
+  if (!best) return false;
+  
+  best->lastHit = now;
+  hits++;
+  savedBytes += frameBytes;
+  out = best->result;
+  distance = bestDistance;
+  return true;
+}
+
+void ResultCache::store(uint64_t hash, const AnalysisResult& result, unsigned long now) {
+  if (!enabled || !result.success) return;
+  
+  // Prefer refreshing the entry for the same scene, then a free or
+  // expired slot, then the least recently used one
+  Entry* slot = nullptr;
+  for (int i = 0; i < CacheConfig::ENTRIES && !slot; i++) {
+    if (entries[i].used && PerceptualHash::distance(hash, entries[i].hash) <= CacheConfig::MAX_DISTANCE) {
+      slot = &entries[i];
+    }
+  }
+  for (int i = 0; i < CacheConfig::ENTRIES && !slot; i++) {
+    if (!isFresh(entries[i], now)) {
+      slot = &entries[i];
+    }
+  }
+  if (!slot) {
+    slot = &entries[0];
+    for (int i = 1; i < CacheConfig::ENTRIES; i++) {
+      if (now - entries[i].lastHit > now - slot->lastHit) {
+        slot = &entries[i];
+      }
+    }
+  }
+  
+  slot->used = true;
+  slot->hash = hash;
+  slot->storedAt = now;
+  slot->lastHit = now;
+  slot->result = result;
+}
+
+void ResultCache::clear() {
+  for (int i = 0; i < CacheConfig::ENTRIES; i++) {
+    entries[i] = Entry();
+  }
+}
+
+int ResultCache::getSize(unsigned long now) const {
+  int size = 0;
+  for (int i = 0; i < CacheConfig::ENTRIES; i++) {
+    if (isFresh(entries[i], now)) size++;
+  }
+  return size;
+}
+
+bool ResultCache::isFresh(const Entry& entry, unsigned long now) const {
+  return entry.used && now - entry.storedAt < (unsigned long)CacheConfig::TTL_MS;
+}
\ No newline at end of file
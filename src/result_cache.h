@@ -0,0 +1,62 @@
+// ============================================================================
+// result_cache.h - Recent verdicts keyed by perceptual hash
+// ============================================================================
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <Arduino.h>
+#include "backend_client.h"
+#include "config.h"
+
+// Small LRU of perceptual hash -> AnalysisResult. A frame within
+// CacheConfig::MAX_DISTANCE bits of a cached hash reuses that verdict
+// until it is TTL_MS old, so a static scene isn't uploaded again and again.
+// Not locked: AnalysisQueue only touches it while holding its runLock.
+class ResultCache {
+private:
+  struct Entry {
+    bool used;
+    uint64_t hash;
+    unsigned long storedAt;
+    unsigned long lastHit;
+    AnalysisResult result;
+    
+    Entry() : used(false), hash(0), storedAt(0), lastHit(0) {}
+  };
+  
+  bool enabled;
+  Entry entries[CacheConfig::ENTRIES];
+  
+  // Counters
+  unsigned long lookups;
+  unsigned long hits;
+  unsigned long hashFailures;
+  uint64_t savedBytes;
+  
+  bool isFresh(const Entry& entry, unsigned long now) const;
+  
+public:
+  ResultCache();
+  
+  void setEnabled(bool on) { enabled = on; }
+  bool isEnabled() const { return enabled; }
+  
+  // Closest fresh match. On a hit, out gets the cached verdict, distance
+  // the Hamming distance, and frameBytes is counted as saved upload.
+  bool lookup(uint64_t hash, unsigned long now, size_t frameBytes, AnalysisResult& out, int& distance);
+  
+  // Store a successful verdict, replacing a near-duplicate or the LRU entry
+  void store(uint64_t hash, const AnalysisResult& result, unsigned long now);
+  void clear();
+  void recordHashFailure() { hashFailures++; }
+  
+  // Status
+  int getSize(unsigned long now) const;
+  unsigned long getLookups() const { return lookups; }
+  unsigned long getHits() const { return hits; }
+  unsigned long getHashFailures() const { return hashFailures; }
+  float getHitRate() const { return lookups > 0 ? (float)hits / lookups : 0; }
+  uint64_t getSavedBytes() const { return savedBytes; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,320 @@
+// ============================================================================
+// stream_server.cpp - MJPEG live stream implementation
+// ============================================================================
+#include "stream_server.h"
+#include "img_converters.h"
+#include <lwip/sockets.h>
+#include <errno.h>
+
+#define STREAM_BOUNDARY "honeybadgerframe"
+
+StreamServer::StreamServer(CameraModule* cam)
+  : camera(cam), server(StreamConfig::PORT), taskHandle(nullptr), latest(nullptr), lastCapture(0),
+    framesCaptured(0), framesSent(0), framesDropped(0), viewersServed(0), viewersRejected(0) {
+  for (int i = 0; i < StreamConfig::MAX_VIEWERS; i++) {
+    viewers[i].frame = nullptr;
+    viewers[i].active = false;
+  }
+  for (int i = 0; i < StreamConfig::MAX_PENDING; i++) {
+    pending[i].active = false;
+  }
+}
+
+bool StreamServer::begin() {
+  server.begin();
+  server.setNoDelay(true);
+  
+  BaseType_t created = xTaskCreatePinnedToCore(streamTask, "stream", StreamConfig::TASK_STACK,
+                                               this, StreamConfig::TASK_PRIORITY, &taskHandle, 1);
+  if (created != pdPASS) {
+    taskHandle = nullptr;
+    Serial.println("Stream task creation failed");
+    return false;
+  }
+  
+  Serial.printf("MJPEG stream on port %d (max %d viewers, %d fps)\n",
+                StreamConfig::PORT, StreamConfig::MAX_VIEWERS, StreamConfig::MAX_FPS);
+  return true;
+}
+
+int StreamServer::getViewerCount() const {
+  int count = 0;
+  for (int i = 0; i < StreamConfig::MAX_VIEWERS; i++) {
+    if (viewers[i].active) count++;
+  }
+  return count;
+}
+
+int StreamServer::getPendingCount() const {
+  int count = 0;
+  for (int i = 0; i < StreamConfig::MAX_PENDING; i++) {
+    if (pending[i].active) count++;
+  }
+  return count;
+}
+
+void StreamServer::streamTask(void* param) {
+  static_cast<StreamServer*>(param)->streamLoop();
+}
+
+void StreamServer::streamLoop() {
+  const unsigned long frameInterval = 1000 / StreamConfig::MAX_FPS;
+  
+  while (true) {
+    acceptViewers();
+    
+    if (getViewerCount() == 0) {
+      // Nobody watching: no captures, and give the last frame's memory back
+      release(latest);
+      latest = nullptr;
+      // A request head still arriving is worth a quicker look
+      vTaskDelay(getPendingCount() > 0 ? 1 : pdMS_TO_TICKS(StreamConfig::IDLE_POLL_MS));
+      continue;
+    }
+    
+    // Capture only when some viewer has finished the newest frame
+    bool wanted = false;
+    for (int i = 0; i < StreamConfig::MAX_VIEWERS; i++) {
+      const Viewer& viewer = viewers[i];
+      if (viewer.active && !viewer.frame && (!latest || latest->sequence == viewer.lastSequence)) {
+        wanted = true;
+      }
+    }
+    if (wanted && millis() - lastCapture >= frameInterval) {
+      lastCapture = millis();
+      captureFrame();
+    }
+    
+    bool progress = false;
+    for (int i = 0; i < StreamConfig::MAX_VIEWERS; i++) {
+      if (viewers[i].active && serviceViewer(viewers[i])) {
+        progress = true;
+      }
+    }
+    
+    // Every socket is full or every viewer is waiting for the next frame
+    if (!progress) {
+      vTaskDelay(1);
+    }
+  }
+}
+
+void StreamServer::acceptViewers() {
+  WiFiClient client = server.available();
+  if (client) {
+    Pending* slot = nullptr;
+    for (int i = 0; i < StreamConfig::MAX_PENDING && !slot; i++) {
+      if (!pending[i].active) slot = &pending[i];
+    }
+    if (slot) {
+      slot->client = client;
+      slot->lineLength = 0;
+      slot->sawRequestLine = false;
+      slot->isStream = false;
+      slot->acceptedAt = millis();
+      slot->active = true;
+    } else {
+      viewersRejected++;
+      client.print("HTTP/1.1 503 Service Unavailable\r\nRetry-After: 1\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+      client.stop();
+    }
+  }
+  
+  for (int i = 0; i < StreamConfig::MAX_PENDING; i++) {
+    Pending& request = pending[i];
+    if (!request.active) continue;
+    
+    if (readRequestHead(request)) {
+      request.active = false;
+      admitViewer(request.client, request.isStream);
+      request.client = WiFiClient();
+    } else if (!request.client.connected() ||
+               millis() - request.acceptedAt >= (unsigned long)StreamConfig::REQUEST_TIMEOUT_MS) {
+      request.active = false;
+      request.client.stop();
+    }
+  }
+}
+
+bool StreamServer::readRequestHead(Pending& request) {
+  // Only what has already arrived; the rest is picked up next round
+  int available = request.client.available();
+  while (available-- > 0) {
+    int c = request.client.read();
+    if (c < 0) break;
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (request.lineLength < sizeof(request.line) - 1) request.line[request.lineLength++] = (char)c;
+      continue;
+    }
+    
+    // Only the request line matters; a blank line ends the head
+    if (request.lineLength == 0) return true;
+    if (!request.sawRequestLine) {
+      request.line[request.lineLength] = '\0';
+      request.isStream = strncmp(request.line, "GET /stream", 11) == 0;
+      request.sawRequestLine = true;
+    }
+    request.lineLength = 0;
+  }
+  return false;
+}
+
+void StreamServer::admitViewer(WiFiClient& client, bool isStream) {
+  if (!isStream) {
+    client.print("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    client.stop();
+    return;
+  }
+  
+  Viewer* slot = nullptr;
+  for (int i = 0; i < StreamConfig::MAX_VIEWERS && !slot; i++) {
+    if (!viewers[i].active) slot = &viewers[i];
+  }
+  if (!slot) {
+    viewersRejected++;
+    client.print("HTTP/1.1 503 Service Unavailable\r\nRetry-After: 10\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    client.stop();
+    return;
+  }
+  
+  client.setNoDelay(true);
+  client.print("HTTP/1.1 200 OK\r\n"
+               "Content-Type: multipart/x-mixed-replace; boundary=" STREAM_BOUNDARY "\r\n"
+               "Cache-Control: no-cache, no-store\r\n"
+               "Access-Control-Allow-Origin: *\r\n"
+               "Connection: close\r\n\r\n");
+               
+  slot->client = client;
+  slot->frame = nullptr;
+  slot->lastSequence = 0;
+  slot->cursor = 0;
+  slot->lastProgress = millis();
+  slot->active = true;
+  viewersServed++;
+  
+  Serial.printf("Stream viewer connected from %s (%d watching)\n",
+                client.remoteIP().toString().c_str(), getViewerCount());
+}
+
+bool StreamServer::captureFrame() {
+  camera_fb_t* fb = camera->grabFrame();
+  if (!fb) return false;
+  
+  SharedFrame* frame = (SharedFrame*)malloc(sizeof(SharedFrame));
+  if (!frame) {
+    camera->releaseFrameBuffer(fb);
+    return false;
+  }
+  frame->data = nullptr;
+  frame->length = 0;
+  
+  if (fb->format == PIXFORMAT_JPEG) {
+    frame->data = (uint8_t*)ps_malloc(fb->len);
+    if (frame->data) {
+      memcpy(frame->data, fb->buf, fb->len);
+      frame->length = fb->len;
+    }
+  } else if (!frame2jpg(fb, UploadConfig::JPEG_QUALITY, &frame->data, &frame->length)) {
+    frame->data = nullptr;
+  }
+  camera->releaseFrameBuffer(fb);
+  
+  if (!frame->data) {
+    free(frame);
+    return false;
+  }
+  
+  frame->sequence = ++framesCaptured;
+  frame->refs = 1;           // Held by "latest"
+  release(latest);
+  latest = frame;
+  return true;
+}
+
+void StreamServer::startPart(Viewer& viewer) {
+  viewer.partHeaderLength = snprintf(viewer.partHeader, sizeof(viewer.partHeader),
+                                     "--" STREAM_BOUNDARY "\r\nContent-Type: image/jpeg\r\nContent-Length: %u\r\n\r\n",
+                                     (unsigned)viewer.frame->length);
+  viewer.cursor = 0;
+  viewer.lastProgress = millis();
+}
+
+bool StreamServer::serviceViewer(Viewer& viewer) {
+  if (!viewer.client.connected()) {
+    dropViewer(viewer);
+    return false;
+  }
+  
+  if (!viewer.frame) {
+    if (!latest || latest->sequence == viewer.lastSequence) return false;
+    
+    // Frames captured while this viewer was still sending are skipped
+    if (viewer.lastSequence != 0 && latest->sequence > viewer.lastSequence + 1) {
+      framesDropped += latest->sequence - viewer.lastSequence - 1;
+    }
+    viewer.frame = retain(latest);
+    startPart(viewer);
+  }
+  
+  // The part is header + JPEG + CRLF; send whichever piece the cursor is in
+  size_t jpegStart = viewer.partHeaderLength;
+  size_t jpegEnd = jpegStart + viewer.frame->length;
+  size_t partLength = jpegEnd + 2;
+  
+  const uint8_t* src;
+  size_t length;
+  if (viewer.cursor < jpegStart) {
+    src = (const uint8_t*)viewer.partHeader + viewer.cursor;
+    length = jpegStart - viewer.cursor;
+  } else if (viewer.cursor < jpegEnd) {
+    src = viewer.frame->data + (viewer.cursor - jpegStart);
+    length = min(jpegEnd - viewer.cursor, (size_t)StreamConfig::SEND_SLICE);
+  } else {
+    src = (const uint8_t*)"\r\n" + (viewer.cursor - jpegEnd);
+    length = partLength - viewer.cursor;
+  }
+  
+  // Never block on one viewer: a full socket just means "try next round"
+  int sent = send(viewer.client.fd(), src, length, MSG_DONTWAIT);
+  if (sent < 0) {
+    if ((errno == EAGAIN || errno == EWOULDBLOCK) &&
+        millis() - viewer.lastProgress < (unsigned long)StreamConfig::STALL_TIMEOUT_MS) {
+      return false;
+    }
+    dropViewer(viewer);
+    return false;
+  }
+  
+  viewer.cursor += sent;
+  viewer.lastProgress = millis();
+  
+  if (viewer.cursor >= partLength) {
+    viewer.lastSequence = viewer.frame->sequence;
+    release(viewer.frame);
+    viewer.frame = nullptr;
+    framesSent++;
+  }
+  return sent > 0;
+}
+
+void StreamServer::dropViewer(Viewer& viewer) {
+  release(viewer.frame);
+  viewer.frame = nullptr;
+  viewer.client.stop();
+  viewer.active = false;
+  Serial.printf("Stream viewer disconnected (%d watching)\n", getViewerCount());
+}
+
+// Frames are only ever touched by the stream task, so plain counts suffice
+SharedFrame* StreamServer::retain(SharedFrame* frame) {
+  if (frame) frame->refs++;
+  return frame;
+}
+
+void StreamServer::release(SharedFrame* frame) {
+  if (frame && --frame->refs == 0) {
+    free(frame->data);
+    free(frame);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+// ============================================================================
+// stream_server.h - MJPEG live stream with shared-frame fan-out
+// ============================================================================
+#ifndef STREAM_SERVER_H
+#define STREAM_SERVER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "camera_module.h"
+#include "config.h"
+
+// One captured JPEG shared by every viewer. Copied out of the camera
+// buffer so the sensor is free again straight away; freed when the last
+// viewer (or the stream server's "latest" slot) lets go of it.
+struct SharedFrame {
+  uint8_t* data;
+  size_t length;
+  uint32_t sequence;
+  int refs;
+};
+
+// multipart/x-mixed-replace stream on its own port, so endless responses
+// never hold one of the HTTP server's few sockets; /stream on port 80
+// redirects here. A single task captures at most StreamConfig::MAX_FPS,
+// and only while some viewer is ready for a new frame, so extra viewers
+// never add sensor reads. Each viewer has its own send cursor into the
+// shared frame and is written with non-blocking sends. A viewer still
+// busy with an old frame simply skips to the newest one when it finishes,
+// so a slow client drops frames instead of stalling the others.
+class StreamServer {
+private:
+  struct Viewer {
+    WiFiClient client;
+    SharedFrame* frame;
+    uint32_t lastSequence;
+    char partHeader[96];
+    size_t partHeaderLength;
+    size_t cursor;             // Bytes of header + JPEG + trailer already sent
+    unsigned long lastProgress;
+    bool active;
+  };
+  
+  // A connection whose request head hasn't fully arrived yet. It's read a
+  // little each round like the viewers are written, so a slow client never
+  // holds up the stream.
+  struct Pending {
+    WiFiClient client;
+    char line[128];
+    size_t lineLength;
+    bool sawRequestLine;
+    bool isStream;             // Request line was GET /stream...
+    unsigned long acceptedAt;
+    bool active;
+  };
+  
+  CameraModule* camera;
+  WiFiServer server;
+  TaskHandle_t taskHandle;
+  Viewer viewers[StreamConfig::MAX_VIEWERS];
+  Pending pending[StreamConfig::MAX_PENDING];
+  SharedFrame* latest;
+  unsigned long lastCapture;
+  
+  // Counters
+  uint32_t framesCaptured;
+  uint32_t framesSent;
+  uint32_t framesDropped;
+  uint32_t viewersServed;
+  uint32_t viewersRejected;
+  
+  static void streamTask(void* param);
+  void streamLoop();
+  void acceptViewers();
+  bool readRequestHead(Pending& request);
+  void admitViewer(WiFiClient& client, bool isStream);
+  int getPendingCount() const;
+  bool captureFrame();
+  bool serviceViewer(Viewer& viewer);
+  void dropViewer(Viewer& viewer);
+  void startPart(Viewer& viewer);
+  
+  static SharedFrame* retain(SharedFrame* frame);
+  static void release(SharedFrame* frame);
+  
+public:
+  StreamServer(CameraModule* cam);
+  
+  bool begin();
+  bool isRunning() const { return taskHandle != nullptr; }
+  
+  // Status
+  int getViewerCount() const;
+  uint32_t getFramesCaptured() const { return framesCaptured; }
+  uint32_t getFramesSent() const { return framesSent; }
+  uint32_t getFramesDropped() const { return framesDropped; }
+  uint32_t getViewersServed() const { return viewersServed; }
+  uint32_t getViewersRejected() const { return viewersRejected; }
+};
+
+#endif
\ No newline at end of file
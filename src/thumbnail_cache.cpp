@@ -0,0 +1,168 @@
+// ============================================================================
+// thumbnail_cache.cpp - Thumbnail decode / re-encode and cache
+// ============================================================================
+#include "thumbnail_cache.h"
+#include "jpeg_decode.h"
+#include "img_converters.h"
+
+ThumbnailCache::ThumbnailCache()
+  : lock(xSemaphoreCreateMutex()), renders(0), hits(0), failures(0) {
+  for (int i = 0; i < SCALES; i++) {
+    entries[i].jpeg = {nullptr, 0, 0};
+    entries[i].sequence = 0;
+  }
+}
+
+int ThumbnailCache::indexFor(int scale) {
+  switch (scale) {
+    case 2:  return 0;
+    case 4:  return 1;
+    case 8:  return 2;
+    default: return -1;
+  }
+}
+
+bool ThumbnailCache::sendCached(uint32_t sequence, int scale, ThumbnailSink sink, void* context) {
+  int index = indexFor(scale);
+  if (index < 0 || sequence == 0) return false;
+  
+  bool found = false;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  Entry& entry = entries[index];
+  if (entry.sequence == sequence && entry.jpeg.length > 0) {
+    found = true;
+    hits++;
+    sink(context, entry.jpeg.data, entry.jpeg.length);
+  }
+  xSemaphoreGive(lock);
+  return found;
+}
+
+bool ThumbnailCache::render(const uint8_t* jpeg, size_t length, uint32_t sequence, int scale,
+                            ThumbnailSink sink, void* context, size_t& outBytes) {
+  int index = indexFor(scale);
+  outBytes = 0;
+  if (index < 0 || !jpeg || length == 0) return false;
+  
+  EncodeState state = {sink, context, nullptr, 0, true};
+  bool ok;
+  
+  if (sequence != 0) {
+    // Held for the whole render so a reader never sees a half-built entry
+    xSemaphoreTake(lock, portMAX_DELAY);
+    Entry& entry = entries[index];
+    entry.sequence = 0;
+    entry.jpeg.length = 0;
+    state.keep = &entry.jpeg;
+    ok = encode(jpeg, length, scale, state);
+    if (ok) {
+      entry.sequence = sequence;
+    }
+    xSemaphoreGive(lock);
+  } else {
+    ok = encode(jpeg, length, scale, state);
+  }
+  
+  outBytes = state.bytes;
+  if (ok) {
+    renders++;
+  } else {
+    failures++;
+  }
+  return ok;
+}
+
+bool ThumbnailCache::encode(const uint8_t* jpeg, size_t length, int scale, EncodeState& state) {
+  DecodeState decode = {jpeg, length, nullptr, 0, 0};
+  jpg_scale_t jpegScale = scale == 2 ? JPG_SCALE_2X : scale == 4 ? JPG_SCALE_4X : JPG_SCALE_8X;
+  
+  bool ok = JpegDecode::decode(length, jpegScale, readJpeg, writeBlock, &decode) == ESP_OK && decode.pixels;
+  if (ok) {
+    ok = fmt2jpg_cb(decode.pixels, (size_t)decode.width * decode.height * 3, decode.width, decode.height,
+                    PIXFORMAT_RGB888, ThumbnailConfig::JPEG_QUALITY, onJpegData, &state);
+    // fmt2jpg_cb ignores short writes from the callback; check ourselves
+    ok = ok && state.ok && state.bytes > 0;
+  }
+  
+  free(decode.pixels);
+  return ok;
+}
+
+size_t ThumbnailCache::readJpeg(void* arg, size_t index, uint8_t* buf, size_t len) {
+  const DecodeState* decode = static_cast<DecodeState*>(arg);
+  if (index >= decode->length) return 0;
+  if (index + len > decode->length) {
+    len = decode->length - index;
+  }
+  if (buf) {
+    memcpy(buf, decode->jpeg + index, len);
+  }
+  return len;
+}
+
+bool ThumbnailCache::writeBlock(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data) {
+  DecodeState* decode = static_cast<DecodeState*>(arg);
+  
+  // Called with no data at start (output size) and at the end
+  if (!data) {
+    if (x == 0 && y == 0 && !decode->pixels) {
+      decode->width = w;
+      decode->height = h;
+      decode->pixels = (uint8_t*)ps_malloc((size_t)w * h * 3);
+      return decode->pixels != nullptr;
+    }
+    return true;
+  }
+  if (!decode->pixels) return false;
+  
+  // data is an RGB888 block of w x h pixels at (x, y). esp32-camera's
+  // PIXFORMAT_RGB888 is stored B, G, R, so swap while copying.
+  for (uint16_t row = 0; row < h && y + row < decode->height; row++) {
+    const uint8_t* in = data + (size_t)row * w * 3;
+    uint8_t* out = decode->pixels + ((size_t)(y + row) * decode->width + x) * 3;
+    for (uint16_t col = 0; col < w && x + col < decode->width; col++) {
+      out[0] = in[2];
+      out[1] = in[1];
+      out[2] = in[0];
+      in += 3;
+      out += 3;
+    }
+  }
+  return true;
+}
+
+size_t ThumbnailCache::onJpegData(void* arg, size_t index, const void* data, size_t len) {
+  EncodeState* state = static_cast<EncodeState*>(arg);
+  if (!state->ok) return 0;
+  
+  // A failed cache append only loses the cache entry, not the response
+  if (state->keep && !appendToBuffer(state->keep, (const uint8_t*)data, len)) {
+    state->keep->length = 0;
+    state->keep = nullptr;
+  }
+  if (state->sink && !state->sink(state->context, (const uint8_t*)data, len)) {
+    state->ok = false;
+    return 0;
+  }
+  state->bytes += len;
+  return len;
+}
+
+bool ThumbnailCache::appendToBuffer(void* context, const uint8_t* data, size_t length) {
+  ThumbnailBuffer* buffer = static_cast<ThumbnailBuffer*>(context);
+  
+  if (buffer->length + length > buffer->capacity) {
+    size_t capacity = buffer->capacity ? buffer->capacity : ThumbnailConfig::INITIAL_BUFFER;
+    while (capacity < buffer->length + length) {
+      capacity *= 2;
+    }
+    uint8_t* grown = (uint8_t*)ps_realloc(buffer->data, capacity);
+    if (!grown) return false;
+    buffer->data = grown;
+    buffer->capacity = capacity;
+  }
+  
+  memcpy(buffer->data + buffer->length, data, length);
+  buffer->length += length;
+  return true;
+}
\ No newline at end of file
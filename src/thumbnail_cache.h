@@ -0,0 +1,90 @@
+// ============================================================================
+// thumbnail_cache.h - Reduced-size JPEG previews for /capture?scale
+// ============================================================================
+#ifndef THUMBNAIL_CACHE_H
+#define THUMBNAIL_CACHE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "config.h"
+
+typedef bool (*ThumbnailSink)(void* context, const uint8_t* data, size_t length);
+
+// Growable PSRAM byte buffer (grow only)
+struct ThumbnailBuffer {
+  uint8_t* data;
+  size_t capacity;
+  size_t length;
+};
+
+// A thumbnail is the source JPEG decoded straight at 1/2, 1/4 or 1/8 size
+// (tjpgd scales during the IDCT, so the full-size image never exists) and
+// re-encoded. The encoder output goes to the sink as it is produced. One
+// thumbnail per scale is kept, keyed by the LastFrameCache sequence of its
+// source, so repeated previews of the same capture skip both steps.
+class ThumbnailCache {
+private:
+  static const int SCALES = 3;
+  
+  struct Entry {
+    ThumbnailBuffer jpeg;
+    uint32_t sequence;       // Source frame; 0 = empty
+  };
+  
+  struct DecodeState {
+    const uint8_t* jpeg;
+    size_t length;
+    uint8_t* pixels;         // RGB888 at output size
+    uint16_t width;
+    uint16_t height;
+  };
+  
+  struct EncodeState {
+    ThumbnailSink sink;
+    void* context;
+    ThumbnailBuffer* keep;   // Cache entry being filled, or nullptr
+    size_t bytes;
+    bool ok;
+  };
+  
+  SemaphoreHandle_t lock;
+  Entry entries[SCALES];
+  
+  // Counters
+  uint32_t renders;
+  uint32_t hits;
+  uint32_t failures;
+  
+  static int indexFor(int scale);
+  static size_t readJpeg(void* arg, size_t index, uint8_t* buf, size_t len);
+  static bool writeBlock(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data);
+  static size_t onJpegData(void* arg, size_t index, const void* data, size_t len);
+  bool encode(const uint8_t* jpeg, size_t length, int scale, EncodeState& state);
+  
+public:
+  ThumbnailCache();
+  
+  static bool isValidScale(int scale) { return indexFor(scale) >= 0; }
+  
+  // Passes the cached thumbnail of frame `sequence` to the sink in one
+  // piece. False if there is none.
+  bool sendCached(uint32_t sequence, int scale, ThumbnailSink sink, void* context);
+  
+  // Renders a thumbnail of `jpeg` into the sink. A nonzero sequence also
+  // caches it (replacing that scale's entry); 0 renders an uncached frame.
+  // On failure, check outBytes: if nothing reached the sink the caller can
+  // still send an error.
+  bool render(const uint8_t* jpeg, size_t length, uint32_t sequence, int scale,
+              ThumbnailSink sink, void* context, size_t& outBytes);
+  
+  // Sink that appends to a ThumbnailBuffer (context)
+  static bool appendToBuffer(void* context, const uint8_t* data, size_t length);
+  
+  // Status
+  uint32_t getRenders() const { return renders; }
+  uint32_t getHits() const { return hits; }
+  uint32_t getFailures() const { return failures; }
+};
+
+#endif
\ No newline at end of file
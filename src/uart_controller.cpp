@@ -15,6 +15,13 @@ bool UARTController::initialize() {
     serial->read();
   }
   
+  const char* help = "Commands received from the Arduino over UART";
+  commandsOff = metrics.counter("honeybadger_uart_commands_total", help, "command=\"off\"");
+  commandsOn = metrics.counter("honeybadger_uart_commands_total", help, "command=\"on\"");
+  commandsStatus = metrics.counter("honeybadger_uart_commands_total", help, "command=\"status\"");
+  commandsPing = metrics.counter("honeybadger_uart_commands_total", help, "command=\"ping\"");
+  commandsUnknown = metrics.counter("honeybadger_uart_commands_total", help, "command=\"unknown\"");
+  
   initialized = true;
   deviceConnected = false;  // Initially no device connected
   lastResponseTime = 0;     // No responses yet
@@ -63,25 +70,30 @@ void UARTController::processCommand(const String& command) {
   deviceConnected = true;
   
   if (cmd == "0") {
+    commandsOff.inc();
     lastCommand = 0;
     lastCommandTime = millis();
     Serial.println("Arduino command: 0 (OFF)");
     sendResponse("OK_0");
     
   } else if (cmd == "1") {
+    commandsOn.inc();
     lastCommand = 1;
     lastCommandTime = millis();
     Serial.println("Arduino command: 1 (ON)");
     sendResponse("OK_1");
     
   } else if (cmd == "STATUS") {
+    commandsStatus.inc();
     sendStatus();
     
   } else if (cmd == "PING") {
+    commandsPing.inc();
     sendResponse("PONG");
     Serial.println("Arduino ping received - device connected");
     
   } else {
+    commandsUnknown.inc();
     Serial.println("Unknown UART command: " + cmd);
     sendResponse("ERROR_UNKNOWN");
   }
@@ -7,6 +7,7 @@
 #include <Arduino.h>
 #include <HardwareSerial.h>
 #include "config.h"
+#include "metrics.h"
 
 class UARTController {
 private:
@@ -18,6 +19,13 @@ private:
   unsigned long lastResponseTime = 0;  // NEW: Track last response from Arduino
   String inputBuffer = "";
   
+  // Commands received, by kind
+  Counter commandsOff;
+  Counter commandsOn;
+  Counter commandsStatus;
+  Counter commandsPing;
+  Counter commandsUnknown;
+  
   // Private method for processing commands
   void processCommand(const String& command);
   
@@ -0,0 +1,206 @@
+// ============================================================================
+// verdict_parser.cpp - Streaming verdict parser implementation
+// ============================================================================
+#include "verdict_parser.h"
+
+VerdictParser::VerdictParser(AnalysisResult& target) : result(target) {
+  reset();
+}
+
+void VerdictParser::reset() {
+  state = EXPECT_VALUE;
+  containerBits = 0;
+  depth = 0;
+  stringIsKey = false;
+  valueIsString = false;
+  key[0] = '\0';
+  value[0] = '\0';
+  keyLength = 0;
+  valueLength = 0;
+  verdictDepth = 0;
+  confidenceDepth = 0;
+  bytesParsed = 0;
+}
+
+size_t VerdictParser::write(uint8_t c) {
+  processChar((char)c);
+  bytesParsed++;
+  return 1;
+}
+
+size_t VerdictParser::write(const uint8_t* buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    processChar((char)buffer[i]);
+  }
+  bytesParsed += size;
+  return size;
+}
+
+void VerdictParser::processChar(char c) {
+  bool whitespace = (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+  
+  switch (state) {
+    case EXPECT_VALUE:
+      if (whitespace) return;
+      if (c == '{' || c == '[') {
+        if (!pushContainer(c == '{')) return;
+        state = (c == '{') ? EXPECT_KEY : EXPECT_VALUE;
+      } else if (c == ']' && depth > 0 && !insideObject()) {
+        popContainer(c);  // Empty array
+      } else if (c == '"') {
+        stringIsKey = false;
+        valueIsString = true;
+        valueLength = 0;
+        state = IN_STRING;
+      } else if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+        valueIsString = false;
+        valueLength = 0;
+        appendToken(c);
+        state = IN_LITERAL;
+      } else {
+        state = FAILED;
+      }
+      break;
+      
+    case EXPECT_KEY:
+      if (whitespace) return;
+      if (c == '"') {
+        stringIsKey = true;
+        keyLength = 0;
+        state = IN_STRING;
+      } else if (c == '}') {
+        popContainer(c);  // Empty object
+      } else {
+        state = FAILED;
+      }
+      break;
+      
+    case EXPECT_COLON:
+      if (whitespace) return;
+      state = (c == ':') ? EXPECT_VALUE : FAILED;
+      break;
+      
+    case EXPECT_COMMA:
+      if (whitespace) return;
+      if (c == ',') {
+        state = insideObject() ? EXPECT_KEY : EXPECT_VALUE;
+      } else if (c == '}' || c == ']') {
+        popContainer(c);
+      } else {
+        state = FAILED;
+      }
+      break;
+      
+    case IN_STRING:
+      if (c == '\\') {
+        state = IN_STRING_ESCAPE;
+      } else if (c == '"') {
+        if (stringIsKey) {
+          key[keyLength] = '\0';
+          stringIsKey = false;
+          state = EXPECT_COLON;
+        } else {
+          finishValue();
+        }
+      } else {
+        appendToken(c);
+      }
+      break;
+      
+    case IN_STRING_ESCAPE:
+      // Escapes only matter for byte-exact keys; keep the escaped char as-is
+      appendToken(c);
+      state = IN_STRING;
+      break;
+      
+    case IN_LITERAL:
+      if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          c == '.' || c == '-' || c == '+') {
+        appendToken(c);
+        return;
+      }
+      finishValue();
+      // The terminator (',', '}', ']' or whitespace) belongs to the next state
+      if (state != DONE) {
+        processChar(c);
+      }
+      break;
+      
+    case DONE:
+    case FAILED:
+      break;
+  }
+}
+
+bool VerdictParser::pushContainer(bool isObject) {
+  if (depth >= MAX_DEPTH) {
+    state = FAILED;
+    return false;
+  }
+  
+  if (isObject) {
+    containerBits |= (1UL << depth);
+  } else {
+    containerBits &= ~(1UL << depth);
+  }
+  depth++;
+  return true;
+}
+
+void VerdictParser::popContainer(char closer) {
+  bool isObject = insideObject();
+  if (depth == 0 || (closer == '}') != isObject) {
+    state = FAILED;
+    return;
+  }
+  
+  depth--;
+  afterValue();
+}
+
+bool VerdictParser::insideObject() const {
+  return depth > 0 && (containerBits & (1UL << (depth - 1)));
+}
+
+void VerdictParser::appendToken(char c) {
+  // Over-long tokens are truncated; they can't be one of our fields anyway
+  if (stringIsKey) {
+    if (keyLength < TOKEN_SIZE - 1) key[keyLength++] = c;
+  } else {
+    if (valueLength < TOKEN_SIZE - 1) value[valueLength++] = c;
+  }
+}
+
+void VerdictParser::finishValue() {
+  value[valueLength] = '\0';
+  
+  // Only direct members of an object have a key. A shallower match wins,
+  // so a top-level verdict beats one nested inside e.g. a debug object.
+  if (insideObject() && !valueIsString) {
+    if (strcmp(key, "isHoneyBadger") == 0 && (verdictDepth == 0 || depth < verdictDepth)) {
+      if (strcmp(value, "true") == 0) {
+        result.isHoneyBadger = true;
+        verdictDepth = depth;
+      } else if (strcmp(value, "false") == 0) {
+        result.isHoneyBadger = false;
+        verdictDepth = depth;
+      }
+    } else if (strcmp(key, "confidence") == 0 && (confidenceDepth == 0 || depth < confidenceDepth)) {
+      char* end = nullptr;
+      float parsed = strtof(value, &end);
+      if (end != value) {
+        result.confidence = parsed;
+        confidenceDepth = depth;
+      }
+    }
+  }
+  
+  afterValue();
+}
+
+void VerdictParser::afterValue() {
+  key[0] = '\0';
+  keyLength = 0;
+  valueLength = 0;
+  state = (depth == 0) ? DONE : EXPECT_COMMA;
+}
\ No newline at end of file
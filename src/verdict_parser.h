@@ -0,0 +1,76 @@
+// ============================================================================
+// verdict_parser.h - Streaming parser for the backend JSON verdict
+// ============================================================================
+#ifndef VERDICT_PARSER_H
+#define VERDICT_PARSER_H
+
+#include <Arduino.h>
+#include "analysis_result.h"
+
+// Incremental JSON tokenizer that is written to like a Stream (e.g. by
+// HTTPClient::writeToStream) and fills the isHoneyBadger/confidence
+// fields of an AnalysisResult as the bytes go past. Whitespace and key
+// order don't matter, and nothing is allocated: keys and scalar values are
+// held in small fixed buffers and anything longer is truncated.
+class VerdictParser : public Stream {
+private:
+  enum State {
+    EXPECT_VALUE,
+    EXPECT_KEY,
+    EXPECT_COLON,
+    EXPECT_COMMA,
+    IN_STRING,
+    IN_STRING_ESCAPE,
+    IN_LITERAL,
+    DONE,
+    FAILED
+  };
+  
+  static const int MAX_DEPTH = 32;
+  static const int TOKEN_SIZE = 24;
+  
+  AnalysisResult& result;
+  State state;
+  uint32_t containerBits;    // Bit n set = depth n+1 is an object, clear = array
+  uint8_t depth;
+  bool stringIsKey;
+  bool valueIsString;        // Quoted "true"/"0.9" is not a verdict
+  char key[TOKEN_SIZE];
+  char value[TOKEN_SIZE];
+  uint8_t keyLength;
+  uint8_t valueLength;
+  uint8_t verdictDepth;      // Depth the field was found at, 0 = not yet
+  uint8_t confidenceDepth;
+  size_t bytesParsed;
+  
+  void processChar(char c);
+  bool pushContainer(bool isObject);
+  void popContainer(char closer);
+  bool insideObject() const;
+  void appendToken(char c);
+  void finishValue();
+  void afterValue();
+  
+public:
+  VerdictParser(AnalysisResult& target);
+  
+  void reset();
+  
+  // Print interface - feed response bytes here
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  
+  // Stream read side (unused - the parser is write-only)
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  
+  // Parse outcome
+  bool hasVerdict() const { return verdictDepth != 0; }
+  bool hasConfidence() const { return confidenceDepth != 0; }
+  bool isComplete() const { return state == DONE; }
+  bool hasError() const { return state == FAILED; }
+  size_t getBytesParsed() const { return bytesParsed; }
+};
+
+#endif
\ No newline at end of file
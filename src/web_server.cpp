@@ -2,243 +2,1388 @@
 // web_server.cpp - Web server implementation (WITH UART)
 // ============================================================================
 #include "web_server.h"
-#include "html_templates.h"
+#include "dashboard_page.h"
+#include "json_writer.h"
 #include "config.h"
+#include <lwip/sockets.h>
 
-WebServerManager::WebServerManager(WebServer* srv, CameraModule* cam, WiFiModule* wf, UARTController* uart) 
-  : server(srv), camera(cam), wifi(wf), uartController(uart) {
+WebServerManager::WebServerManager(CameraModule* cam, WiFiModule* wf, UARTController* uart) 
+  : server(nullptr), camera(cam), wifi(wf), uartController(uart),
+    analysisQueue(cam, wf, &backendClient), streamServer(cam), routeCount(0),
+    deferredLock(nullptr), workQueue(nullptr), workHandle(nullptr),
+    deferredServed(0), deferredCancelled(0), deferredRejected(0), lastDeferredPoll(0), deferredFlushQueued(false),
+    lastEventPoll(0), eventsPrimed(false), eventFlushQueued(false), seenUartCommand(0), seenUartResponse(0),
+    seenUartConnected(false), seenWifiConnected(false), seenRssi(0), seenHeap(0), seenHeapLow(false),
+    seenResult(0) {
+  for (int i = 0; i < HttpConfig::MAX_DEFERRED; i++) {
+    deferred[i].owner = this;
+    deferred[i].active = false;
+    deferred[i].data = nullptr;
+    deferred[i].sending = false;
+  }
 }
 
-void WebServerManager::setupRoutes() {
+bool WebServerManager::begin() {
+  deferredLock = xSemaphoreCreateMutex();
+  workQueue = xQueueCreate(HttpConfig::MAX_DEFERRED, sizeof(DeferredResponse*));
+  if (!deferredLock || !workQueue) {
+    Serial.println("HTTP deferred queue allocation failed");
+    return false;
+  }
+  
+  // Slow requests run here so the server task only ever multiplexes sockets
+  BaseType_t created = xTaskCreatePinnedToCore(workTask, "http-work", HttpConfig::WORK_TASK_STACK,
+                                               this, HttpConfig::WORK_TASK_PRIORITY, &workHandle, 0);
+  if (created != pdPASS) {
+    workHandle = nullptr;
+    Serial.println("HTTP work task creation failed");
+    return false;
+  }
+  
+  // Background worker for POST /api/analyze
+  if (!analysisQueue.begin()) {
+    Serial.println("WARNING: Analysis worker not running - POST /api/analyze unavailable");
+  }
+  
+  // State pushes for GET /events
+  if (!events.begin()) {
+    Serial.println("WARNING: Event channel unavailable - /events disabled");
+  }
+  
+  // Live MJPEG stream on its own port
+  if (!streamServer.begin()) {
+    Serial.println("WARNING: Stream server not running - /stream unavailable");
+  }
+  
+  httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+  config.server_port = SystemConfig::WEB_SERVER_PORT;
+  config.max_open_sockets = HttpConfig::MAX_OPEN_SOCKETS;
+  config.max_uri_handlers = HttpConfig::MAX_URI_HANDLERS;
+  config.stack_size = HttpConfig::TASK_STACK;
+  config.task_priority = HttpConfig::TASK_PRIORITY;
+  // No LRU purge: a socket's LRU stamp only moves when a request arrives,
+  // so /events listeners and deferred sockets would always be evicted
+  // first. MAX_OPEN_SOCKETS has room for all of them instead.
+  config.lru_purge_enable = false;
+  config.uri_match_fn = httpd_uri_match_wildcard;
+  config.close_fn = onSocketClose;
+  config.global_user_ctx = this;
+  config.global_user_ctx_free_fn = keepGlobalContext;
+  
+  if (httpd_start(&server, &config) != ESP_OK) {
+    server = nullptr;
+    Serial.println("HTTP server failed to start");
+    return false;
+  }
+  
   // Existing routes
-  server->on("/", HTTP_GET, [this]() { handleRoot(); });
-  server->on("/capture", HTTP_GET, [this]() { handleCapture(); });
-  server->on("/api/analyze", HTTP_GET, [this]() { handleAnalyzeAPI(); });
-  server->on("/api/analyze", HTTP_POST, [this]() { handleAnalyzeAPI(); });
-  server->on("/status", HTTP_GET, [this]() { handleStatus(); });
-  server->on("/test", HTTP_GET, [this]() { handleTestConnection(); });
+  addRoute("/", HTTP_GET, route<&WebServerManager::handleRoot>);
+  addRoute("/capture", HTTP_GET, route<&WebServerManager::handleCapture>);
+  addRoute("/stream", HTTP_GET, route<&WebServerManager::handleStream>);
+  addRoute("/api/analyze", HTTP_GET, route<&WebServerManager::handleAnalyzeAPI>);
+  addRoute("/api/analyze", HTTP_POST, route<&WebServerManager::handleAnalyzeSubmit>);
+  addRoute("/api/result/*", HTTP_GET, route<&WebServerManager::handleAnalyzeResult>);
+  addRoute("/status", HTTP_GET, route<&WebServerManager::handleStatus>);
+  addRoute("/api/dashboard", HTTP_GET, route<&WebServerManager::handleDashboardInfo>);
+  addRoute("/test", HTTP_GET, route<&WebServerManager::handleTestConnection>);
+  addRoute("/events", HTTP_GET, route<&WebServerManager::handleEvents>);
+  addRoute("/metrics", HTTP_GET, route<&WebServerManager::handleMetrics>);
+  addRoute("/history/?*", HTTP_GET, route<&WebServerManager::handleHistory>);
+  addRoute("/api/camera/config", HTTP_GET, route<&WebServerManager::handleCameraConfig>);
+  addRoute("/api/camera/config", HTTP_POST, route<&WebServerManager::handleCameraConfigUpdate>);
   
   // NEW: UART control routes
-  server->on("/uart/status", HTTP_GET, [this]() { handleUARTStatus(); });
-  server->on("/uart/test", HTTP_GET, [this]() { handleUARTTest(); });
+  addRoute("/uart/status", HTTP_GET, route<&WebServerManager::handleUARTStatus>);
+  addRoute("/uart/test", HTTP_GET, route<&WebServerManager::handleUARTTest>);
+  
+  httpd_register_err_handler(server, HTTPD_404_NOT_FOUND, handleNotFound);
+  
+  heapFree = metrics.gauge("honeybadger_heap_free_bytes", "Free internal heap");
+  heapMinFree = metrics.gauge("honeybadger_heap_min_free_bytes", "Lowest free heap since boot (low-water mark)");
+  heapMaxAlloc = metrics.gauge("honeybadger_heap_max_alloc_bytes", "Largest allocatable heap block");
+  psramFree = metrics.gauge("honeybadger_psram_free_bytes", "Free PSRAM");
+  psramMinFree = metrics.gauge("honeybadger_psram_min_free_bytes", "Lowest free PSRAM since boot (low-water mark)");
+  wifiRssi = metrics.gauge("honeybadger_wifi_rssi_dbm", "WiFi signal strength, 0 while disconnected");
+  uptime = metrics.gauge("honeybadger_uptime_seconds", "Seconds since boot");
   
-  server->onNotFound([this]() { handleNotFound(); });
+  Serial.printf("HTTP server started on port %d (%d sockets, %d deferred)\n",
+                SystemConfig::WEB_SERVER_PORT, HttpConfig::MAX_OPEN_SOCKETS, HttpConfig::MAX_DEFERRED);
+  return true;
+}
+
+void WebServerManager::addRoute(const char* uri, httpd_method_t method, esp_err_t (*handler)(httpd_req_t*)) {
+  if (routeCount >= HttpConfig::MAX_URI_HANDLERS) {
+    Serial.printf("Failed to register route %s (raise HttpConfig::MAX_URI_HANDLERS)\n", uri);
+    return;
+  }
   
-  Serial.println("Web server routes configured (with UART control)");
+  RouteContext& context = routes[routeCount++];
+  context.owner = this;
+  snprintf(context.labels, sizeof(context.labels), "route=\"%s\",method=\"%s\"",
+           uri, method == HTTP_POST ? "POST" : "GET");
+  context.latency = metrics.histogram("honeybadger_http_handler_duration_seconds",
+                                      "Time the HTTP server task spent in each handler",
+                                      MetricBuckets::HANDLER_US, MetricBuckets::HANDLER_US_COUNT, 0.000001f,
+                                      context.labels);
+  
+  httpd_uri_t route = {};
+  route.uri = uri;
+  route.method = method;
+  route.handler = handler;
+  route.user_ctx = &context;
+  
+  if (httpd_register_uri_handler(server, &route) != ESP_OK) {
+    Serial.printf("Failed to register route %s\n", uri);
+  }
 }
 
-void WebServerManager::handleClient() {
-  server->handleClient();
+// The dashboard is a static gzip blob in flash; nothing is copied to heap.
+// Live values come from /api/dashboard once the page has loaded.
+esp_err_t WebServerManager::handleRoot(httpd_req_t* req) {
+  httpd_resp_set_hdr(req, "ETag", DASHBOARD_ETAG);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  
+  char ifNoneMatch[16] = "";
+  if (httpd_req_get_hdr_value_str(req, "If-None-Match", ifNoneMatch, sizeof(ifNoneMatch)) == ESP_OK &&
+      strcmp(ifNoneMatch, DASHBOARD_ETAG) == 0) {
+    httpd_resp_set_status(req, statusLine(304));
+    return httpd_resp_send(req, nullptr, 0);
+  }
+  
+  httpd_resp_set_status(req, statusLine(200));
+  httpd_resp_set_type(req, "text/html");
+  httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  return httpd_resp_send(req, (const char*)DASHBOARD_GZ, DASHBOARD_GZ_LENGTH);
 }
 
-void WebServerManager::handleRoot() {
-  String html = processHTMLTemplate(FPSTR(HTML_MAIN_PAGE));
-  server->send(200, "text/html", html);
+esp_err_t WebServerManager::handleDashboardInfo(httpd_req_t* req) {
+  char backend[80];
+  snprintf(backend, sizeof(backend), "%s:%d", NetworkConfig::BACKEND_HOST, NetworkConfig::BACKEND_PORT);
+  
+  char buffer[HttpConfig::JSON_BUFFER];
+  JsonWriter json = beginJson(req, 200, buffer, sizeof(buffer));
+  json.beginObject();
+  json.field("ip", WiFi.localIP());
+  json.field("backend", backend);
+  json.field("wifiSignal", wifi->getSignalStrength());
+  json.field("uptime", millis());
+  json.field("freeHeap", ESP.getFreeHeap());
+  json.field("uartTx", SystemPins::UART_TX);
+  json.field("uartRx", SystemPins::UART_RX);
+  json.field("uartBaud", UARTConfig::BAUD_RATE);
+  json.endObject();
+  return endJson(req, json);
 }
 
-void WebServerManager::handleCapture() {
+esp_err_t WebServerManager::handleCapture(httpd_req_t* req) {
   if (!camera->isInitialized()) {
-    server->send(503, "text/plain", "Camera not available");
-    return;
+    return sendResponse(req, 503, "text/plain", "Camera not available");
   }
   
-  camera_fb_t* fb = camera->captureImage();
-  if (!fb) {
-    server->send(500, "text/plain", "Capture failed");
-    return;
+  // ?scale=2|4|8: a reduced-size re-encode instead of the full frame
+  int scale = 1;
+  char scaleArg[4];
+  if (getQueryValue(req, "scale", scaleArg, sizeof(scaleArg))) {
+    scale = atoi(scaleArg);
+    if (scale != 1 && !ThumbnailCache::isValidScale(scale)) {
+      return sendError(req, 400, "Invalid scale", "Use scale=1, 2, 4 or 8");
+    }
   }
   
-  sendImageResponse(fb);
-  camera->releaseFrameBuffer(fb);
+  // ?maxAge=ms: a recent enough cached frame skips the flash and sensor
+  char maxAge[12];
+  if (getQueryValue(req, "maxAge", maxAge, sizeof(maxAge))) {
+    size_t length = 0;
+    unsigned long age = 0;
+    uint32_t sequence = 0;
+    uint8_t* frame = camera->getLastFrame().copyIfFresh(strtoul(maxAge, nullptr, 10), length, age, sequence);
+    if (frame) {
+      char ageHeader[12];
+      snprintf(ageHeader, sizeof(ageHeader), "%lu", age);
+      httpd_resp_set_hdr(req, "X-Frame-Age", ageHeader);
+      httpd_resp_set_hdr(req, "Cache-Control", "no-cache, no-store, must-revalidate");
+      httpd_resp_set_hdr(req, "Content-Disposition", "inline; filename=esp32cam.jpg");
+      httpd_resp_set_type(req, "image/jpeg");
+      esp_err_t err = scale > 1 ? sendThumbnail(req, frame, length, sequence, scale)
+                                : httpd_resp_send(req, (const char*)frame, length);
+      free(frame);
+      return err;
+    }
+  }
+  
+  return defer(req, DEFER_CAPTURE, scale);
+}
+
+// Headers are already set. A cached thumbnail goes out as one chunk;
+// otherwise the encoder's output is written to the socket as it comes.
+esp_err_t WebServerManager::sendThumbnail(httpd_req_t* req, const uint8_t* frame, size_t length,
+                                          uint32_t sequence, int scale) {
+  if (!thumbnails.sendCached(sequence, scale, sendImageChunk, req)) {
+    size_t sent = 0;
+    if (!thumbnails.render(frame, length, sequence, scale, sendImageChunk, req, sent)) {
+      // Too late for an error status once part of the image is out
+      if (sent > 0) return ESP_FAIL;
+      return sendError(req, 500, "Thumbnail encoding failed");
+    }
+  }
+  return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// GET /history lists the ring, newest first; GET /history/<sequence>
+// sends that frame straight from its pinned slot
+esp_err_t WebServerManager::handleHistory(httpd_req_t* req) {
+  FrameHistory& history = camera->getHistory();
+  if (!history.isReady()) {
+    return sendError(req, 503, "Frame history not available");
+  }
+  
+  const char* tail = req->uri + strlen("/history");
+  if (*tail == '/') tail++;
+  
+  if (*tail == '\0' || *tail == '?') {
+    HistoryFrame frames[HistoryConfig::SLOTS];
+    int count = history.list(frames, HistoryConfig::SLOTS);
+    unsigned long now = millis();
+    
+    char buffer[HttpConfig::JSON_BUFFER];
+    JsonWriter json = beginJson(req, 200, buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("capacity", history.getCapacity());
+    json.field("count", count);
+    json.beginArray("frames");
+    for (int i = 0; i < count; i++) {
+      json.beginObject();
+      json.field("sequence", frames[i].sequence);
+      json.field("age", now - frames[i].capturedAt);
+      json.field("bytes", frames[i].length);
+      json.field("width", frames[i].width);
+      json.field("height", frames[i].height);
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    return endJson(req, json);
+  }
+  
+  HistoryFrame frame;
+  if (!history.acquire(strtoul(tail, nullptr, 10), frame)) {
+    return sendError(req, 404, "Frame not in history", "It may have been overwritten - list /history again");
+  }
+  
+  char ageHeader[12];
+  char sequenceHeader[12];
+  snprintf(ageHeader, sizeof(ageHeader), "%lu", millis() - frame.capturedAt);
+  snprintf(sequenceHeader, sizeof(sequenceHeader), "%u", (unsigned)frame.sequence);
+  httpd_resp_set_hdr(req, "X-Frame-Age", ageHeader);
+  httpd_resp_set_hdr(req, "X-Frame-Sequence", sequenceHeader);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache, no-store, must-revalidate");
+  httpd_resp_set_hdr(req, "Content-Disposition", "inline; filename=esp32cam.jpg");
+  httpd_resp_set_type(req, "image/jpeg");
+  esp_err_t err = httpd_resp_send(req, (const char*)frame.data, frame.length);
+  history.release(frame);
+  return err;
 }
 
-void WebServerManager::handleAnalyzeAPI() {
+// The stream server owns its own port so long-lived responses never tie
+// up a socket here; send viewers there
+esp_err_t WebServerManager::handleStream(httpd_req_t* req) {
+  if (!streamServer.isRunning()) {
+    return sendResponse(req, 503, "text/plain", "Stream not available");
+  }
+  
+  char host[64] = "";
+  httpd_req_get_hdr_value_str(req, "Host", host, sizeof(host));
+  char* colon = strchr(host, ':');
+  if (colon) *colon = '\0';
+  
+  char location[96];
+  if (host[0]) {
+    snprintf(location, sizeof(location), "http://%s:%d/stream", host, StreamConfig::PORT);
+  } else {
+    uint32_t ip = WiFi.localIP();
+    snprintf(location, sizeof(location), "http://%u.%u.%u.%u:%d/stream", (unsigned)(ip & 0xFF),
+             (unsigned)((ip >> 8) & 0xFF), (unsigned)((ip >> 16) & 0xFF), (unsigned)(ip >> 24), StreamConfig::PORT);
+  }
+  httpd_resp_set_hdr(req, "Location", location);
+  return sendResponse(req, 302, "text/plain", "");
+}
+
+// Legacy synchronous analysis - kept for scripts that expect the verdict
+// inline. The capture and upload run on the work task; only this client waits.
+esp_err_t WebServerManager::handleAnalyzeAPI(httpd_req_t* req) {
   // Check system status
   if (!camera->isInitialized()) {
-    server->send(503, "application/json", 
-      "{\"error\":\"Camera not initialized\",\"debug\":\"Camera initialization failed during startup\"}");
-    return;
+    return sendError(req, 503, "Camera not initialized", "Camera initialization failed during startup");
   }
   
-  if (!wifi->isConnected()) {
-    server->send(503, "application/json", 
-      "{\"error\":\"WiFi not connected\",\"debug\":\"WiFi connection lost or never established\"}");
-    return;
+  // Offline captures go to the spool when it's mounted
+  bool canSpool = analysisQueue.getSpool().isReady();
+  if (!wifi->isConnected() && !canSpool) {
+    return sendError(req, 503, "WiFi not connected", "WiFi connection lost or never established");
   }
   
-  // Capture image
-  camera_fb_t* fb = camera->captureImage();
-  if (!fb) {
-    server->send(500, "application/json", 
-      "{\"error\":\"Camera capture failed\",\"debug\":\"Frame buffer allocation failed - possible memory issue\"}");
-    return;
+  return defer(req, DEFER_ANALYZE);
+}
+
+esp_err_t WebServerManager::handleAnalyzeSubmit(httpd_req_t* req) {
+  // Check system status
+  if (!camera->isInitialized()) {
+    return sendError(req, 503, "Camera not initialized", "Camera initialization failed during startup");
   }
   
-  // Analyze with backend
-  AnalysisResult result = backendClient.analyzeImage(fb);
-  camera->releaseFrameBuffer(fb);
+  // Offline captures go to the spool when it's mounted
+  bool canSpool = analysisQueue.getSpool().isReady();
+  if (!wifi->isConnected() && !canSpool) {
+    return sendError(req, 503, "WiFi not connected", "WiFi connection lost or never established");
+  }
   
-  // Build response JSON
-  String response = "{";
-  if (result.success) {
-    response += "\"isHoneyBadger\":" + String(result.isHoneyBadger ? "true" : "false") + ",";
-    response += "\"confidence\":" + String(result.confidence) + ",";
-    response += "\"processingTime\":" + String(result.processingTime) + ",";
-    response += "\"httpDuration\":" + String(result.httpDuration) + ",";
-    response += "\"captureTime\":\"" + String(millis()) + "\",";
-    response += "\"debug\":\"" + result.debug + "\"";
-  } else {
-    response += "\"error\":\"" + result.error + "\",";
-    response += "\"code\":" + String(result.httpCode) + ",";
-    response += "\"debug\":\"" + result.debug + "\"";
-    if (result.serverResponse.length() > 0 && result.serverResponse.length() < 200) {
-      String escapedResponse = result.serverResponse;
-      escapedResponse.replace("\"", "'");
-      response += ",\"serverResponse\":\"" + escapedResponse + "\"";
-    }
+  char buffer[HttpConfig::JSON_BUFFER];
+  
+  if (!backendClient.isAvailable() && !canSpool) {
+    unsigned long retryIn = backendClient.getBreaker().getRetryIn(millis());
+    char retryAfter[12];
+    snprintf(retryAfter, sizeof(retryAfter), "%lu", (retryIn + 999) / 1000);
+    httpd_resp_set_hdr(req, "Retry-After", retryAfter);
+    
+    JsonWriter json = beginJson(req, 503, buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("error", "Backend unavailable (circuit open)");
+    json.field("retryIn", retryIn);
+    json.endObject();
+    return endJson(req, json);
+  }
+  
+  bool attached = false;
+  uint32_t jobId = analysisQueue.submit(attached);
+  if (jobId == 0) {
+    return sendError(req, 503, "Analysis queue full", "Too many analyses pending - retry shortly");
+  }
+  
+  char resultURL[32];
+  snprintf(resultURL, sizeof(resultURL), "/api/result/%u", (unsigned)jobId);
+  httpd_resp_set_hdr(req, "Location", resultURL);
+  
+  JsonWriter json = beginJson(req, 202, buffer, sizeof(buffer));
+  json.beginObject();
+  json.field("jobId", jobId);
+  json.field("status", "queued");
+  json.field("attached", attached);    // Joined a queued job that had not started yet
+  json.field("pending", analysisQueue.getPendingCount());
+  json.field("resultUrl", resultURL);
+  json.endObject();
+  return endJson(req, json);
+}
+
+esp_err_t WebServerManager::handleAnalyzeResult(httpd_req_t* req) {
+  uint32_t jobId = strtoul(req->uri + strlen("/api/result/"), nullptr, 10);
+  
+  AnalysisJob job;
+  if (!analysisQueue.getJob(jobId, job)) {
+    return sendError(req, 404, "Unknown or expired job id");
   }
-  response += "}";
   
-  server->send(result.success ? 200 : 500, "application/json", response);
+  // Still queued or running - client should poll again
+  int code = job.state != JOB_DONE ? 202 : (job.result.success ? 200 : 500);
+  
+  char buffer[HttpConfig::JSON_BUFFER];
+  JsonWriter json = beginJson(req, code, buffer, sizeof(buffer));
+  json.beginObject();
+  json.field("jobId", job.id);
+  json.field("status", AnalysisQueue::stateName(job.state));
+  if (job.state != JOB_DONE) {
+    json.field("queuedFor", millis() - job.submittedAt);
+  } else {
+    json.field("completedAt", job.completedAt);
+    writeAnalysisFields(json, job.result);
+  }
+  json.endObject();
+  return endJson(req, json);
 }
 
-void WebServerManager::handleStatus() {
-  String json = getStatusJSON();
-  server->send(200, "application/json", json);
+esp_err_t WebServerManager::handleStatus(httpd_req_t* req) {
+  char buffer[HttpConfig::JSON_BUFFER];
+  JsonWriter json = beginJson(req, 200, buffer, sizeof(buffer));
+  writeStatusJSON(json);
+  return endJson(req, json);
 }
 
-void WebServerManager::handleTestConnection() {
+esp_err_t WebServerManager::handleTestConnection(httpd_req_t* req) {
   if (!wifi->isConnected()) {
-    String response = "{\"error\":\"WiFi not connected\",\"wifiStatus\":" + String(WiFi.status()) + "}";
-    server->send(503, "application/json", response);
-    return;
+    char buffer[HttpConfig::JSON_BUFFER];
+    JsonWriter json = beginJson(req, 503, buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("error", "WiFi not connected");
+    json.field("wifiStatus", (int)WiFi.status());
+    json.endObject();
+    return endJson(req, json);
   }
   
-  ConnectionTestResult testResult = backendClient.testConnection();
+  return defer(req, DEFER_TEST);
+}
+
+esp_err_t WebServerManager::handleCameraConfig(httpd_req_t* req) {
+  if (!camera->isInitialized()) {
+    return sendError(req, 503, "Camera not initialized");
+  }
   
-  String response = "{";
-  response += "\"testURL\":\"" + testResult.testURL + "\",";
-  response += "\"responseCode\":" + String(testResult.responseCode) + ",";
-  response += "\"duration\":" + String(testResult.duration) + ",";
-  response += "\"success\":" + String(testResult.success ? "true" : "false") + ",";
-  response += "\"wifiSignal\":" + String(testResult.wifiSignal) + ",";
-  response += "\"freeHeap\":" + String(testResult.freeHeap);
+  char buffer[HttpConfig::JSON_BUFFER];
+  JsonWriter json = beginJson(req, 200, buffer, sizeof(buffer));
+  json.beginObject();
+  writeCameraSettings(json, camera->getSettings());
+  json.endObject();
+  return endJson(req, json);
+}
+
+// Form fields (body or query string) named as in the esp32-camera web
+// server; fields left out keep their current value. Everything is checked
+// before anything is applied, and applied settings are saved to NVS unless
+// persist=0.
+esp_err_t WebServerManager::handleCameraConfigUpdate(httpd_req_t* req) {
+  if (!camera->isInitialized()) {
+    return sendError(req, 503, "Camera not initialized");
+  }
   
-  if (!testResult.success) {
-    response += ",\"error\":\"" + testResult.error + "\"";
+  char form[256];
+  if (!readForm(req, form, sizeof(form))) {
+    return sendError(req, 400, "Invalid request body", "Send form fields, e.g. framesize=8&quality=12");
   }
   
-  response += "}";
+  CameraSettings settings = camera->getSettings();
+  bool invalid = false;
+  int value = 0;
+  
+  bool profileSet = false;
+  if (formInt(form, "framesize", 0, FRAMESIZE_INVALID - 1, value, invalid)) {
+    settings.frameSize = (framesize_t)value;
+    profileSet = true;
+  }
+  if (formInt(form, "quality", 0, 63, value, invalid)) {
+    settings.quality = value;
+    profileSet = true;
+  }
+  if (formInt(form, "xclk", 1, 40, value, invalid)) settings.xclkMhz = value;
+  if (formInt(form, "gainceiling", 0, 6, value, invalid)) settings.gainCeiling = value;
+  if (formInt(form, "aec", 0, 1, value, invalid)) settings.aec = value;
+  if (formInt(form, "aec2", 0, 1, value, invalid)) settings.aec2 = value;
+  if (formInt(form, "ae_level", -2, 2, value, invalid)) settings.aeLevel = value;
+  if (formInt(form, "aec_value", 0, 1200, value, invalid)) settings.aecValue = value;
+  if (formInt(form, "agc", 0, 1, value, invalid)) settings.agc = value;
+  if (formInt(form, "agc_gain", 0, 30, value, invalid)) settings.agcGain = value;
+  if (formInt(form, "awb", 0, 1, value, invalid)) settings.awb = value;
+  if (formInt(form, "awb_gain", 0, 1, value, invalid)) settings.awbGain = value;
+  if (formInt(form, "wb_mode", 0, 4, value, invalid)) settings.wbMode = value;
+  
+  // A hand-set profile would be undone by the next adaptive step
+  if (formInt(form, "adaptive", 0, 1, value, invalid)) {
+    settings.adaptive = value;
+  } else if (profileSet) {
+    settings.adaptive = false;
+  }
+  
+  int persist = 1;
+  formInt(form, "persist", 0, 1, persist, invalid);
+  
+  if (invalid) {
+    return sendError(req, 400, "Invalid camera setting", "Fields must be integers within their ranges");
+  }
+  if (settings.adaptive && !AdaptiveConfig::ENABLED) {
+    return sendError(req, 400, "Adaptive quality is disabled in this build");
+  }
+  const char* problem = CameraLimits::check(settings);
+  if (problem) {
+    return sendError(req, 400, "Invalid camera setting", problem);
+  }
   
-  server->send(200, "application/json", response);
+  // Applying waits on the capture lock and the quality sync on a running
+  // analysis - seconds, during which the server task must keep serving
+  return defer(req, DEFER_CAMERA_CONFIG, 1, &settings, persist);
 }
 
 // NEW: UART Status Handler
-void WebServerManager::handleUARTStatus() {
+esp_err_t WebServerManager::handleUARTStatus(httpd_req_t* req) {
   if (!uartController || !uartController->isInitialized()) {
-    server->send(503, "application/json", "{\"error\":\"UART controller not available\"}");
-    return;
+    return sendError(req, 503, "UART controller not available");
   }
   
-  String json = "{";
-  json += "\"initialized\":" + String(uartController->isInitialized() ? "true" : "false") + ",";
-  json += "\"deviceConnected\":" + String(uartController->isDeviceConnected() ? "true" : "false") + ",";  // NEW
-  json += "\"lastCommand\":" + String(uartController->getLastCommand()) + ",";
-  json += "\"lastCommandTime\":" + String(uartController->getLastCommandTime()) + ",";
-  json += "\"lastResponseTime\":" + String(uartController->getLastResponseTime()) + ",";  // NEW
-  json += "\"timeSinceLastCommand\":" + String(millis() - uartController->getLastCommandTime()) + ",";
-  json += "\"timeSinceLastResponse\":" + String(millis() - uartController->getLastResponseTime()) + ",";  // NEW
-  json += "\"txPin\":" + String(SystemPins::UART_TX) + ",";
-  json += "\"rxPin\":" + String(SystemPins::UART_RX) + ",";
-  json += "\"baudRate\":" + String(UARTConfig::BAUD_RATE);
-  json += "}";
-  
-  server->send(200, "application/json", json);
+  char buffer[HttpConfig::JSON_BUFFER];
+  JsonWriter json = beginJson(req, 200, buffer, sizeof(buffer));
+  writeUARTStatus(json);
+  return endJson(req, json);
 }
 
 // NEW: UART Test Handler
-void WebServerManager::handleUARTTest() {
+esp_err_t WebServerManager::handleUARTTest(httpd_req_t* req) {
   if (!uartController || !uartController->isInitialized()) {
-    server->send(503, "application/json", "{\"error\":\"UART controller not available\"}");
-    return;
+    return sendError(req, 503, "UART controller not available");
   }
   
   uartController->pingDevice();  // Send ping to test actual connection
   
-  String response = "{";
-  response += "\"success\":true,";
-  response += "\"message\":\"Ping sent to Arduino - check if device responds\",";
-  response += "\"timestamp\":" + String(millis()) + ",";
-  response += "\"deviceConnected\":" + String(uartController->isDeviceConnected() ? "true" : "false");
-  response += "}";
+  char buffer[HttpConfig::JSON_BUFFER];
+  JsonWriter json = beginJson(req, 200, buffer, sizeof(buffer));
+  json.beginObject();
+  json.field("success", true);
+  json.field("message", "Ping sent to Arduino - check if device responds");
+  json.field("timestamp", millis());
+  json.field("deviceConnected", uartController->isDeviceConnected());
+  json.endObject();
+  return endJson(req, json);
+}
+
+// Long-lived: the stream head goes out now and the socket stays with the
+// event channel, which writes to it from flushEventsWork()
+esp_err_t WebServerManager::handleEvents(httpd_req_t* req) {
+  if (!events.addListener(server, httpd_req_to_sockfd(req))) {
+    httpd_resp_set_hdr(req, "Retry-After", "10");
+    return sendError(req, 503, "Too many event listeners");
+  }
+  return ESP_OK;
+}
+
+// Prometheus text format for the fleet scraper
+esp_err_t WebServerManager::handleMetrics(httpd_req_t* req) {
+  heapFree.set(ESP.getFreeHeap());
+  heapMinFree.set(ESP.getMinFreeHeap());
+  heapMaxAlloc.set(ESP.getMaxAllocHeap());
+  psramFree.set(ESP.getFreePsram());
+  psramMinFree.set(ESP.getMinFreePsram());
+  wifiRssi.set(wifi->isConnected() ? wifi->getSignalStrength() : 0);
+  uptime.set(millis() / 1000);
   
-  server->send(200, "application/json", response);
+  char buffer[MetricsConfig::WRITE_BUFFER];
+  httpd_resp_set_status(req, statusLine(200));
+  httpd_resp_set_type(req, "text/plain; version=0.0.4; charset=utf-8");
+  if (!metrics.write(buffer, sizeof(buffer), sendChunk, req)) {
+    return ESP_FAIL;
+  }
+  return httpd_resp_send_chunk(req, nullptr, 0);
 }
 
-void WebServerManager::handleNotFound() {
-  server->send(404, "application/json", "{\"error\":\"Endpoint not found\"}");
+esp_err_t WebServerManager::handleNotFound(httpd_req_t* req, httpd_err_code_t error) {
+  return sendError(req, 404, "Endpoint not found");
 }
 
-String WebServerManager::getStatusJSON() {
-  String json = "{";
-  json += "\"camera\":" + String(camera->isInitialized() ? "true" : "false") + ",";
-  json += "\"wifi\":" + String(wifi->isConnected() ? "true" : "false") + ",";
-  json += "\"wifiStatus\":" + String(WiFi.status()) + ",";
-  json += "\"wifiSignal\":" + String(wifi->getSignalStrength()) + ",";
-  json += "\"ip\":\"" + wifi->getIP() + "\",";
-  json += "\"freeHeap\":" + String(ESP.getFreeHeap()) + ",";
-  json += "\"freePSRAM\":" + String(ESP.getFreePsram()) + ",";
-  json += "\"uptime\":" + String(millis()) + ",";
-  json += "\"backend\":\"https://" + String(NetworkConfig::BACKEND_HOST) + ":" + String(NetworkConfig::BACKEND_PORT) + "\"";
+// ----------------------------------------------------------------------------
+// Deferred responses
+// ----------------------------------------------------------------------------
+
+esp_err_t WebServerManager::defer(httpd_req_t* req, DeferredKind kind, int scale,
+                                  const CameraSettings* settings, bool persist) {
+  DeferredResponse* slot = nullptr;
+  
+  xSemaphoreTake(deferredLock, portMAX_DELAY);
+  for (int i = 0; i < HttpConfig::MAX_DEFERRED && !slot; i++) {
+    if (!deferred[i].active) slot = &deferred[i];
+  }
+  if (slot) {
+    slot->kind = kind;
+    slot->scale = scale;
+    if (settings) {
+      slot->settings = *settings;
+    }
+    slot->persist = persist;
+    slot->fd = httpd_req_to_sockfd(req);
+    slot->arrivedAt = millis();
+    slot->active = true;
+    slot->cancelled = false;
+    slot->code = 500;
+    slot->contentType = "application/json";
+    slot->headers = "";
+    slot->textLength = 0;
+    slot->data = nullptr;
+    slot->length = 0;
+    slot->sending = false;
+  }
+  xSemaphoreGive(deferredLock);
+  
+  if (!slot || xQueueSend(workQueue, &slot, 0) != pdTRUE) {
+    if (slot) releaseDeferred(*slot);
+    deferredRejected++;
+    httpd_resp_set_hdr(req, "Retry-After", "1");
+    return sendError(req, 503, "Server busy", "Too many slow requests in flight - retry shortly");
+  }
+  
+  // No response yet: the socket stays open until sendDeferred() writes it
+  return ESP_OK;
+}
+
+void WebServerManager::workTask(void* param) {
+  static_cast<WebServerManager*>(param)->workLoop();
+}
+
+void WebServerManager::workLoop() {
+  DeferredResponse* response;
+  
+  while (true) {
+    if (xQueueReceive(workQueue, &response, portMAX_DELAY) != pdTRUE) continue;
+    
+    runDeferred(*response);
+    
+    // Hand the finished response back to the server task, which owns the sockets
+    if (httpd_queue_work(server, sendDeferredWork, response) != ESP_OK) {
+      Serial.println("HTTP: could not queue deferred response");
+      releaseDeferred(*response);
+    }
+  }
+}
+
+void WebServerManager::runDeferred(DeferredResponse& response) {
+  // JSON bodies are written into the slot's fixed buffer
+  JsonWriter json(response.text, sizeof(response.text));
+  
+  switch (response.kind) {
+    case DEFER_ANALYZE: {
+      AnalysisResult result = analysisQueue.runAnalysis(TRIGGER_HTTP_SYNC, response.arrivedAt);
+      response.code = result.success ? 200 : 500;
+      
+      // The verdict, error and code always have to go out; if the slot can't
+      // hold the diagnostic text too, retry with it cut short, then without
+      const int detailLimits[] = { -1, HttpConfig::DEFERRED_DETAIL_CHARS, 0 };
+      for (int limit : detailLimits) {
+        json = JsonWriter(response.text, sizeof(response.text));
+        json.beginObject();
+        writeAnalysisFields(json, result, limit);
+        json.endObject();
+        if (json.ok()) break;
+      }
+      break;
+    }
+    
+    case DEFER_CAPTURE: {
+      camera_fb_t* fb = camera->captureImage();
+      if (!fb) {
+        json.beginObject().field("error", "Capture failed").endObject();
+        break;
+      }
+      
+      // Fresh captures aren't cached as thumbnails; ?maxAge previews of
+      // this frame will be. The work task can't write to the socket, so
+      // the thumbnail is collected and sent like a full frame.
+      if (response.scale > 1) {
+        ThumbnailBuffer thumbnail = {nullptr, 0, 0};
+        size_t sent = 0;
+        if (thumbnails.render(fb->buf, fb->len, 0, response.scale, ThumbnailCache::appendToBuffer, &thumbnail, sent)) {
+          response.data = thumbnail.data;
+          response.length = thumbnail.length;
+          response.code = 200;
+          response.contentType = "image/jpeg";
+          response.headers = "Cache-Control: no-cache, no-store, must-revalidate\r\n"
+                             "Content-Disposition: inline; filename=esp32cam.jpg\r\n"
+                             "X-Frame-Age: 0\r\n";
+        } else {
+          free(thumbnail.data);
+          json.beginObject().field("error", "Thumbnail encoding failed").endObject();
+        }
+        camera->releaseFrameBuffer(fb);
+        break;
+      }
+      
+      // Copy out so the camera buffer goes back before the (slower) send
+      response.data = (uint8_t*)ps_malloc(fb->len);
+      if (response.data) {
+        memcpy(response.data, fb->buf, fb->len);
+        response.length = fb->len;
+        response.code = 200;
+        response.contentType = "image/jpeg";
+        response.headers = "Cache-Control: no-cache, no-store, must-revalidate\r\n"
+                           "Content-Disposition: inline; filename=esp32cam.jpg\r\n"
+                           "X-Frame-Age: 0\r\n";
+      } else {
+        json.beginObject().field("error", "Out of memory").endObject();
+      }
+      camera->releaseFrameBuffer(fb);
+      break;
+    }
+    
+    case DEFER_TEST: {
+      ConnectionTestResult testResult = backendClient.testConnection();
+      
+      json.beginObject();
+      json.field("testURL", testResult.testURL);
+      json.field("responseCode", testResult.responseCode);
+      json.field("duration", testResult.duration);
+      json.field("success", testResult.success);
+      json.field("wifiSignal", testResult.wifiSignal);
+      json.field("freeHeap", testResult.freeHeap);
+      if (!testResult.success) {
+        json.field("error", testResult.error);
+      }
+      json.endObject();
+      
+      response.code = 200;
+      break;
+    }
+    
+    case DEFER_CAMERA_CONFIG: {
+      bool applied = camera->applySettings(response.settings);
+      analysisQueue.syncQualityController();
+      bool saved = applied && response.persist && camera->saveSettings();
+      
+      json.beginObject();
+      if (!applied) {
+        json.field("error", "Sensor rejected some settings");
+      }
+      json.field("saved", saved);
+      writeCameraSettings(json, camera->getSettings());
+      json.endObject();
+      
+      response.code = applied ? 200 : 500;
+      break;
+    }
+  }
+  
+  response.textLength = json.length();
+  if (!response.data && !json.ok()) {
+    // Didn't fit the slot buffer - send something well-formed instead
+    response.code = 500;
+    response.textLength = snprintf(response.text, sizeof(response.text), "{\"error\":\"Response too large\"}");
+  }
+}
+
+void WebServerManager::sendDeferredWork(void* arg) {
+  DeferredResponse* response = static_cast<DeferredResponse*>(arg);
+  response->owner->sendDeferred(*response);
+}
+
+// Runs on the server task, as does onSocketClose, so the fd can't be
+// closed (and reused by another client) between the check and the send.
+// Captures run to 90 KB, so a slow client must not hold the server task:
+// what doesn't fit the socket now is resumed by flushDeferred()
+void WebServerManager::sendDeferred(DeferredResponse& response) {
+  if (response.cancelled) {
+    deferredCancelled++;
+    releaseDeferred(response);
+    return;
+  }
+  
+  const char* body = response.data ? (const char*)response.data : response.text;
+  size_t length = response.data ? response.length : response.textLength;
+  
+  if (!response.sending) {
+    response.headLength = snprintf(response.head, sizeof(response.head),
+                                   "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %u\r\n%s\r\n",
+                                   statusLine(response.code), response.contentType, (unsigned)length, response.headers);
+    response.sent = 0;
+    response.lastProgress = millis();
+    response.sending = true;
+  }
+  
+  size_t total = response.headLength + length;
+  while (response.sent < total) {
+    const char* from = response.sent < response.headLength ? response.head + response.sent
+                                                           : body + (response.sent - response.headLength);
+    size_t remaining = response.sent < response.headLength ? response.headLength - response.sent
+                                                           : total - response.sent;
+    int written = httpd_socket_send(server, response.fd, from, min((size_t)SystemConfig::CHUNK_SIZE, remaining),
+                                    MSG_DONTWAIT);
+    if (written == HTTPD_SOCK_ERR_TIMEOUT &&
+        millis() - response.lastProgress < (unsigned long)HttpConfig::STALL_TIMEOUT_MS) {
+      return;
+    }
+    if (written <= 0) {
+      size_t bodySent = response.sent > response.headLength ? response.sent - response.headLength : 0;
+      Serial.printf("HTTP: deferred response cut short (%u of %u bytes)\n", (unsigned)bodySent, (unsigned)length);
+      httpd_sess_trigger_close(server, response.fd);
+      releaseDeferred(response);
+      return;
+    }
+    response.sent += written;
+    response.lastProgress = millis();
+  }
+  
+  deferredServed++;
+  releaseDeferred(response);
+}
+
+void WebServerManager::flushDeferredWork(void* arg) {
+  WebServerManager* self = static_cast<WebServerManager*>(arg);
+  self->deferredFlushQueued = false;
+  for (int i = 0; i < HttpConfig::MAX_DEFERRED; i++) {
+    if (self->deferred[i].active && self->deferred[i].sending) {
+      self->sendDeferred(self->deferred[i]);
+    }
+  }
+}
+
+// The server task only learns a socket has room by trying again, so a
+// partly written response is retried every SEND_RETRY_MS; one queued
+// flush at a time
+void WebServerManager::pollDeferred() {
+  if (!isRunning() || deferredFlushQueued ||
+      millis() - lastDeferredPoll < (unsigned long)HttpConfig::SEND_RETRY_MS) return;
+  lastDeferredPoll = millis();
+  
+  bool pending = false;
+  for (int i = 0; i < HttpConfig::MAX_DEFERRED && !pending; i++) {
+    pending = deferred[i].active && deferred[i].sending;
+  }
+  if (pending) {
+    deferredFlushQueued = true;
+    if (httpd_queue_work(server, flushDeferredWork, this) != ESP_OK) {
+      deferredFlushQueued = false;
+    }
+  }
+}
+
+void WebServerManager::releaseDeferred(DeferredResponse& response) {
+  xSemaphoreTake(deferredLock, portMAX_DELAY);
+  free(response.data);
+  response.data = nullptr;
+  response.sending = false;
+  response.active = false;
+  xSemaphoreGive(deferredLock);
+}
+
+void WebServerManager::onSocketClose(httpd_handle_t handle, int fd) {
+  WebServerManager* self = static_cast<WebServerManager*>(httpd_get_global_user_ctx(handle));
+  
+  // Anything still being worked on for this socket is thrown away when done
+  xSemaphoreTake(self->deferredLock, portMAX_DELAY);
+  for (int i = 0; i < HttpConfig::MAX_DEFERRED; i++) {
+    if (self->deferred[i].active && self->deferred[i].fd == fd) {
+      self->deferred[i].cancelled = true;
+    }
+  }
+  xSemaphoreGive(self->deferredLock);
+  
+  self->events.removeListener(fd);
+  
+  // Setting close_fn makes closing the socket our job
+  close(fd);
+}
+
+// ----------------------------------------------------------------------------
+// Server-Sent Events
+// ----------------------------------------------------------------------------
+
+// Sampling here rather than hooking every producer keeps the modules
+// unaware of HTTP; a change is on the wire within SAMPLE_INTERVAL_MS
+void WebServerManager::pollEvents() {
+  if (!isRunning() || millis() - lastEventPoll < (unsigned long)EventsConfig::SAMPLE_INTERVAL_MS) return;
+  lastEventPoll = millis();
+  
+  char buffer[EventsConfig::MAX_EVENT_SIZE];
+  
+  // UART: a new command or response, or the Arduino appearing or vanishing
+  if (uartController && uartController->isInitialized()) {
+    unsigned long commandTime = uartController->getLastCommandTime();
+    unsigned long responseTime = uartController->getLastResponseTime();
+    bool connected = uartController->isDeviceConnected();
+    if (!eventsPrimed || commandTime != seenUartCommand || responseTime != seenUartResponse ||
+        connected != seenUartConnected) {
+      seenUartCommand = commandTime;
+      seenUartResponse = responseTime;
+      seenUartConnected = connected;
+      
+      JsonWriter json(buffer, sizeof(buffer));
+      writeUARTStatus(json);
+      publishEvent(EVENT_UART, json);
+    }
+  }
+  
+  // Detection: any verdict, from the worker or GET /api/analyze
+  AnalysisResult result;
+  if (analysisQueue.getLatestResult(seenResult, result)) {
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("sequence", seenResult);
+    json.field("success", result.success);
+    if (result.success) {
+      json.field("isHoneyBadger", result.isHoneyBadger);
+      json.field("confidence", result.confidence, 2);
+      json.field("cached", result.cached);
+      if (result.spoolSequence != 0) {
+        json.field("spoolSequence", result.spoolSequence);
+        json.field("captureUnix", result.captureUnix);
+        json.field("captureUptimeMs", result.captureUptimeMs);
+      }
+    } else {
+      json.field("error", result.error);
+      json.field("spooled", result.spooled);
+    }
+    json.field("processingTime", result.processingTime);
+    json.endObject();
+    publishEvent(EVENT_DETECTION, json);
+  }
+  
+  // WiFi: link up/down, or the signal moving by RSSI_DELTA
+  bool wifiConnected = wifi->isConnected();
+  int rssi = wifiConnected ? wifi->getSignalStrength() : 0;
+  if (!eventsPrimed || wifiConnected != seenWifiConnected || abs(rssi - seenRssi) >= EventsConfig::RSSI_DELTA) {
+    seenWifiConnected = wifiConnected;
+    seenRssi = rssi;
+    
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("connected", wifiConnected);
+    json.field("rssi", rssi);
+    json.field("ip", WiFi.localIP());
+    json.endObject();
+    publishEvent(EVENT_WIFI, json);
+  }
+  
+  // Heap: crossing the low-memory threshold, or drifting by HEAP_DELTA
+  // while below it - a healthy heap swings that much on every TLS upload
+  uint32_t freeHeap = ESP.getFreeHeap();
+  bool low = freeHeap < (uint32_t)SystemConfig::LOW_MEMORY_THRESHOLD;
+  uint32_t drift = freeHeap > seenHeap ? freeHeap - seenHeap : seenHeap - freeHeap;
+  if (!eventsPrimed || low != seenHeapLow || (low && drift >= (uint32_t)EventsConfig::HEAP_DELTA)) {
+    seenHeap = freeHeap;
+    seenHeapLow = low;
+    
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("freeHeap", freeHeap);
+    json.field("minFreeHeap", ESP.getMinFreeHeap());
+    json.field("low", low);
+    json.field("threshold", SystemConfig::LOW_MEMORY_THRESHOLD);
+    json.field("uptime", millis());
+    json.endObject();
+    publishEvent(EVENT_HEAP, json);
+  }
+  
+  eventsPrimed = true;
+  
+  // Listeners also need the occasional flush for keep-alives and backlogs;
+  // one queued flush at a time is enough
+  if (events.hasListeners() && !eventFlushQueued) {
+    eventFlushQueued = true;
+    if (httpd_queue_work(server, flushEventsWork, this) != ESP_OK) {
+      eventFlushQueued = false;
+    }
+  }
+}
+
+void WebServerManager::publishEvent(EventType type, JsonWriter& json) {
+  if (json.ok()) {
+    events.publish(type, json.data(), json.length());
+  }
+}
+
+void WebServerManager::flushEventsWork(void* arg) {
+  WebServerManager* self = static_cast<WebServerManager*>(arg);
+  self->eventFlushQueued = false;
+  self->events.flush(self->server);
+}
+
+void WebServerManager::writeStatusJSON(JsonWriter& json) {
+  char backend[80];
+  snprintf(backend, sizeof(backend), "https://%s:%d", NetworkConfig::BACKEND_HOST, NetworkConfig::BACKEND_PORT);
+  
+  json.beginObject();
+  json.field("camera", camera->isInitialized());
+  json.field("wifi", wifi->isConnected());
+  json.field("wifiStatus", (int)WiFi.status());
+  json.field("wifiSignal", wifi->getSignalStrength());
+  json.field("ip", WiFi.localIP());
+  json.field("freeHeap", ESP.getFreeHeap());
+  json.field("freePSRAM", ESP.getFreePsram());
+  json.field("uptime", millis());
+  json.field("backend", backend);
+  
+  // Add analysis worker status
+  json.beginObject("analysisWorker");
+  json.field("running", analysisQueue.isRunning());
+  json.field("pending", analysisQueue.getPendingCount());
+  json.field("flights", analysisQueue.getFlights());
+  json.field("shared", analysisQueue.getSharedResults());
+  json.field("attachedJobs", analysisQueue.getAttachedJobs());
+  json.field("minInterval", SystemConfig::ANALYSIS_MIN_INTERVAL_MS);
+  json.endObject();
+  
+  // Add adaptive quality controller decisions
+  QualityController& qc = analysisQueue.getQualityController();
+  char frameSize[16];
+  snprintf(frameSize, sizeof(frameSize), "%ux%u",
+           resolution[camera->getFrameSize()].width, resolution[camera->getFrameSize()].height);
+  json.beginObject("adaptiveQuality");
+  json.field("enabled", qc.isEnabled());
+  json.field("profile", qc.getProfile().name);
+  json.field("level", qc.getLevel());
+  json.field("levels", qc.getLevelCount());
+  json.field("frameSize", frameSize);
+  json.field("jpegQuality", camera->getJpegQuality());
+  json.field("targetLatency", AdaptiveConfig::TARGET_LATENCY_MS);
+  json.field("avgLatency", qc.getAverageLatency(), 0);
+  json.field("avgBytes", qc.getAverageBytes(), 0);
+  json.field("throughputKBps", qc.getThroughput(), 2);
+  json.field("rssi", qc.getLastRSSI());
+  json.field("changes", qc.getChangeCount());
+  json.field("lastDecision", qc.getLastDecision());
+  json.endObject();
+  
+  // Add backend circuit breaker state
+  CircuitBreaker& breaker = backendClient.getBreaker();
+  json.beginObject("circuitBreaker");
+  json.field("state", CircuitBreaker::stateName(breaker.getState()));
+  json.field("consecutiveFailures", breaker.getConsecutiveFailures());
+  json.field("backoff", breaker.getBackoff());
+  json.field("retryIn", breaker.getRetryIn(millis()));
+  json.field("trips", breaker.getTotalTrips());
+  json.field("fastFails", breaker.getFastFails());
+  json.field("probes", breaker.getProbes());
+  json.field("probeFailures", breaker.getProbeFailures());
+  json.endObject();
+  
+  // Add HTTP server deferred-response counters
+  json.beginObject("http");
+  json.field("maxSockets", HttpConfig::MAX_OPEN_SOCKETS);
+  json.field("deferredServed", deferredServed);
+  json.field("deferredCancelled", deferredCancelled);
+  json.field("deferredRejected", deferredRejected);
+  json.endObject();
+  
+  // Add Server-Sent Events listeners
+  json.beginObject("events");
+  json.field("listeners", events.getListenerCount());
+  json.field("maxListeners", EventsConfig::MAX_CLIENTS);
+  json.field("published", events.getPublished());
+  json.field("coalesced", events.getCoalesced());
+  json.field("served", events.getListenersServed());
+  json.field("rejected", events.getListenersRejected());
+  json.field("dropped", events.getListenersDropped());
+  json.endObject();
+  
+  // Add live stream fan-out
+  json.beginObject("stream");
+  json.field("running", streamServer.isRunning());
+  json.field("port", StreamConfig::PORT);
+  json.field("viewers", streamServer.getViewerCount());
+  json.field("maxViewers", StreamConfig::MAX_VIEWERS);
+  json.field("framesCaptured", streamServer.getFramesCaptured());
+  json.field("framesSent", streamServer.getFramesSent());
+  json.field("framesDropped", streamServer.getFramesDropped());
+  json.field("viewersServed", streamServer.getViewersServed());
+  json.field("viewersRejected", streamServer.getViewersRejected());
+  json.endObject();
+  
+  // Add capture mode and sensor frame rate
+  json.beginObject("capture");
+  json.field("mode", camera->isContinuous() ? "continuous" : "on_demand");
+  json.field("fps", camera->getFps(), 1);
+  json.field("frames", camera->getFramesCaptured());
+  json.field("dropped", camera->getFramesDropped());
+  json.field("staleRejected", camera->getStaleFrames());
+  json.field("flashLeadMs", camera->getFlashLeadMs());
+  json.endObject();
+  
+  // Add watch / capture sensor modes and switch latency
+  const ModeSwitchStats& switching = camera->getSwitchStats();
+  framesize_t watchSize = camera->getWatchProfile().frameSize;
+  char watchFrame[16];
+  snprintf(watchFrame, sizeof(watchFrame), "%ux%u", resolution[watchSize].width, resolution[watchSize].height);
+  json.beginObject("sensorMode");
+  json.field("enabled", ModeConfig::ENABLED);
+  json.field("mode", CameraModule::modeName(camera->getMode()));
+  json.field("watchFrameSize", watchFrame);
+  json.field("switches", switching.switches);
+  json.field("timeouts", switching.timeouts);
+  json.field("discarded", switching.discarded);
+  json.field("lastSwitchMs", switching.lastUs / 1000.0f, 1);
+  json.field("avgSwitchMs", switching.averageUs / 1000.0f, 1);
+  json.field("maxSwitchMs", switching.maxUs / 1000.0f, 1);
+  json.endObject();
+  
+  // Add motion gate in front of the backend
+  MotionMonitor& motion = analysisQueue.getMotionMonitor();
+  const MotionResult& lastMotion = motion.getLastResult();
+  uint32_t gated = motion.getUploadsPassed() + motion.getUploadsAvoided();
+  json.beginObject("motion");
+  json.field("running", motion.isRunning());
+  json.field("gate", MotionConfig::GATE_UPLOADS);
+  json.field("fps", motion.getFps(), 1);
+  json.field("cpuPercent", motion.getCpuPercent(), 1);
+  json.field("frames", motion.getFramesProcessed());
+  json.field("motionFrames", motion.getMotionFrames());
+  json.field("lightingChanges", motion.getLightingChanges());
+  json.field("decodeFailures", motion.getDecodeFailures());
+  if (motion.hasSeenMotion()) {
+    json.field("lastMotionAge", motion.getLastMotionAge());
+  }
+  json.field("changedBlocks", lastMotion.changedBlocks);
+  json.field("totalBlocks", lastMotion.totalBlocks);
+  json.field("triggers", motion.getTriggers());
+  json.field("uploadsPassed", motion.getUploadsPassed());
+  json.field("uploadsAvoided", motion.getUploadsAvoided());
+  json.field("avoidedRate", gated ? (float)motion.getUploadsAvoided() / gated : 0.0f, 3);
+  json.endObject();
+  
+  // Add last-frame cache used by /capture?maxAge
+  LastFrameCache& lastFrame = camera->getLastFrame();
+  json.beginObject("lastFrame");
+  json.field("cached", lastFrame.hasFrame());
+  json.field("age", lastFrame.getAge());
+  json.field("bytes", lastFrame.getLength());
+  json.field("stores", lastFrame.getStores());
+  json.field("hits", lastFrame.getHits());
+  json.field("misses", lastFrame.getMisses());
+  json.endObject();
+  
+  // Add recent-frame ring behind /history
+  FrameHistory& history = camera->getHistory();
+  json.beginObject("history");
+  json.field("capacity", history.getCapacity());
+  json.field("recorded", history.getRecorded());
+  json.field("skippedBusy", history.getSkippedBusy());
+  json.field("skippedOversize", history.getSkippedOversize());
+  json.endObject();
+  
+  // Add /capture?scale thumbnail cache
+  json.beginObject("thumbnails");
+  json.field("renders", thumbnails.getRenders());
+  json.field("hits", thumbnails.getHits());
+  json.field("failures", thumbnails.getFailures());
+  json.endObject();
+  
+  // Add perceptual-hash result cache effectiveness
+  ResultCache& cache = analysisQueue.getResultCache();
+  json.beginObject("resultCache");
+  json.field("enabled", cache.isEnabled());
+  json.field("entries", cache.getSize(millis()));
+  json.field("lookups", cache.getLookups());
+  json.field("hits", cache.getHits());
+  json.field("hitRate", cache.getHitRate(), 3);
+  json.field("savedBytes", (unsigned long long)cache.getSavedBytes());
+  json.field("hashFailures", cache.getHashFailures());
+  json.endObject();
+  
+  // Add store-and-forward spool state
+  FrameSpool& spool = analysisQueue.getSpool();
+  json.beginObject("spool");
+  json.field("ready", spool.isReady());
+  json.field("pending", spool.getPendingFrames());
+  json.field("bytes", spool.getTotalBytes());
+  json.field("maxBytes", SpoolConfig::MAX_BYTES);
+  json.field("segments", spool.getSegmentCount());
+  json.field("spooled", spool.getSpooledFrames());
+  json.field("drained", spool.getDrainedFrames());
+  json.field("evicted", spool.getEvictedFrames());
+  json.field("rejected", spool.getRejectedFrames());
+  AnalysisResult drained;
+  uint32_t drainedDetections = 0;
+  bool haveDetection = analysisQueue.getLastDrainedDetection(drained, drainedDetections);
+  json.field("detections", drainedDetections);
+  if (haveDetection) {
+    json.beginObject("lastDetection");
+    json.field("spoolSequence", drained.spoolSequence);
+    json.field("captureUnix", drained.captureUnix);
+    json.field("captureUptimeMs", drained.captureUptimeMs);
+    json.field("confidence", drained.confidence, 2);
+    json.endObject();
+  }
+  json.endObject();
+  
+  // Add backend keep-alive connection stats
+  BackendConnection& conn = backendClient.getConnection();
+  json.beginObject("backendConnection");
+  json.field("open", conn.isOpen());
+  json.field("handshakes", conn.getHandshakeCount());
+  json.field("reused", conn.getReuseCount());
+  json.field("reconnects", conn.getReconnectCount());
+  json.endObject();
+  
+  // Add per-protocol wire cost for comparing multipart+JSON with compact
+  json.beginObject("protocol");
+  json.field("mode", BackendClient::protocolName(backendClient.getProtocol()));
+  for (int p = 0; p < PROTOCOL_COUNT; p++) {
+    const ProtocolStats& stat = backendClient.getProtocolStats((UploadProtocol)p);
+    unsigned long n = stat.requests > 0 ? stat.requests : 1;
+    json.beginObject(BackendClient::protocolName((UploadProtocol)p));
+    json.field("requests", stat.requests);
+    json.field("avgUploadBytes", (unsigned long)(stat.uploadBytes / n));
+    json.field("avgResponseBytes", (unsigned long)(stat.responseBytes / n));
+    json.field("avgLatency", stat.totalLatency / n);
+    json.endObject();
+  }
+  json.endObject();
   
   // Add UART status
+  json.beginObject("uart");
   if (uartController && uartController->isInitialized()) {
-    json += ",\"uart\":{";
-    json += "\"initialized\":true,";
-    json += "\"lastCommand\":" + String(uartController->getLastCommand()) + ",";
-    json += "\"timeSinceLastCommand\":" + String(millis() - uartController->getLastCommandTime());
-    json += "}";
+    json.field("initialized", true);
+    json.field("lastCommand", uartController->getLastCommand());
+    json.field("timeSinceLastCommand", millis() - uartController->getLastCommandTime());
   } else {
-    json += ",\"uart\":{\"initialized\":false}";
+    json.field("initialized", false);
   }
+  json.endObject();
   
-  json += "}";
-  return json;
+  json.endObject();
 }
 
-String WebServerManager::processHTMLTemplate(const String& html) {
-  String processed = html;
-  
-  // Replace template variables
-  processed.replace("{{ESP32_IP}}", wifi->getIP());
-  processed.replace("{{BACKEND_INFO}}", String(NetworkConfig::BACKEND_HOST) + ":" + String(NetworkConfig::BACKEND_PORT));
-  processed.replace("{{MEMORY_INFO}}", String(ESP.getFreeHeap()));
-  processed.replace("{{WIFI_SIGNAL}}", String(wifi->getSignalStrength()));
-  processed.replace("{{UPTIME}}", String(millis() / 1000));
+void WebServerManager::writeAnalysisFields(JsonWriter& json, const AnalysisResult& result, int detailLimit) {
+  if (result.success) {
+    // A motion-gated verdict is for the frame the backend last saw
+    char captureTime[12];
+    snprintf(captureTime, sizeof(captureTime), "%lu", millis() - result.verdictAgeMs);
+    
+    json.field("isHoneyBadger", result.isHoneyBadger);
+    json.field("confidence", result.confidence, 2);
+    json.field("processingTime", result.processingTime);
+    json.field("httpDuration", result.httpDuration);
+    if (result.cached) {
+      json.field("cached", true);
+    }
+    if (result.motionGated) {
+      json.field("motionGated", true);
+      json.field("verdictAgeMs", result.verdictAgeMs);
+    }
+    json.field("captureTime", captureTime);
+  } else {
+    json.field("error", result.error);
+    json.field("code", result.httpCode);
+    if (result.spooled) {
+      json.field("spooled", true);
+    }
+  }
+  if (result.shared) {
+    json.field("shared", true);
+  }
   
-  // NEW: Replace UART pin info
-  processed.replace("{{UART_TX}}", String(SystemPins::UART_TX));
-  processed.replace("{{UART_RX}}", String(SystemPins::UART_RX));
+  if (detailLimit < 0) {
+    json.field("debug", result.debug);
+    if (!result.success && result.serverResponse.length() > 0 && result.serverResponse.length() < 200) {
+      json.field("serverResponse", result.serverResponse);
+    }
+  } else {
+    if (detailLimit > 0) {
+      json.field("debug", result.debug.substring(0, detailLimit));
+    }
+    json.field("detailTruncated", true);
+  }
+}
+
+void WebServerManager::writeUARTStatus(JsonWriter& json) {
+  json.beginObject();
+  json.field("initialized", uartController->isInitialized());
+  json.field("deviceConnected", uartController->isDeviceConnected());  // NEW
+  json.field("lastCommand", uartController->getLastCommand());
+  json.field("lastCommandTime", uartController->getLastCommandTime());
+  json.field("lastResponseTime", uartController->getLastResponseTime());  // NEW
+  json.field("timeSinceLastCommand", millis() - uartController->getLastCommandTime());
+  json.field("timeSinceLastResponse", millis() - uartController->getLastResponseTime());  // NEW
+  json.field("txPin", SystemPins::UART_TX);
+  json.field("rxPin", SystemPins::UART_RX);
+  json.field("baudRate", UARTConfig::BAUD_RATE);
+  json.endObject();
+}
+
+void WebServerManager::writeCameraSettings(JsonWriter& json, const CameraSettings& settings) {
+  char size[16];
+  snprintf(size, sizeof(size), "%ux%u", resolution[settings.frameSize].width, resolution[settings.frameSize].height);
   
-  return processed;
+  json.field("framesize", (int)settings.frameSize);
+  json.field("resolution", size);
+  json.field("quality", settings.quality);
+  json.field("min_quality", CameraLimits::minQuality(settings.frameSize));
+  json.field("max_framesize", (int)CameraConfig::MAX_FRAME_SIZE);
+  json.field("xclk", settings.xclkMhz);
+  json.field("gainceiling", settings.gainCeiling);
+  json.field("aec", settings.aec);
+  json.field("aec2", settings.aec2);
+  json.field("ae_level", settings.aeLevel);
+  json.field("aec_value", settings.aecValue);
+  json.field("agc", settings.agc);
+  json.field("agc_gain", settings.agcGain);
+  json.field("awb", settings.awb);
+  json.field("awb_gain", settings.awbGain);
+  json.field("wb_mode", settings.wbMode);
+  json.field("adaptive", settings.adaptive);
 }
 
-void WebServerManager::sendImageResponse(camera_fb_t* fb) {
-  // Send headers
-  server->sendHeader("Content-Type", "image/jpeg");
-  server->sendHeader("Content-Length", String(fb->len));
-  server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-  server->sendHeader("Content-Disposition", "inline; filename=esp32cam.jpg");
+bool WebServerManager::getQueryValue(httpd_req_t* req, const char* key, char* value, size_t size) {
+  char query[128];
+  return httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+         httpd_query_key_value(query, key, value, size) == ESP_OK;
+}
+
+// application/x-www-form-urlencoded body, or the query string without one
+bool WebServerManager::readForm(httpd_req_t* req, char* form, size_t size) {
+  form[0] = '\0';
+  if (req->content_len == 0) {
+    httpd_req_get_url_query_str(req, form, size);
+    return true;
+  }
+  if (req->content_len >= size) return false;
   
-  // Send image data in chunks
-  WiFiClient client = server->client();
-  size_t sent = 0;
+  size_t received = 0;
+  while (received < req->content_len) {
+    int n = httpd_req_recv(req, form + received, req->content_len - received);
+    if (n == HTTPD_SOCK_ERR_TIMEOUT) continue;
+    if (n <= 0) return false;
+    received += n;
+  }
+  form[received] = '\0';
+  return true;
+}
+
+// True if key is present; a value that isn't an integer in [min, max] sets invalid
+bool WebServerManager::formInt(const char* form, const char* key, int min, int max, int& value, bool& invalid) {
+  char text[12];
+  if (httpd_query_key_value(form, key, text, sizeof(text)) != ESP_OK) return false;
   
-  while (sent < fb->len) {
-    size_t toSend = min((size_t)SystemConfig::CHUNK_SIZE, fb->len - sent);
-    client.write(fb->buf + sent, toSend);
-    sent += toSend;
+  char* end = nullptr;
+  long parsed = strtol(text, &end, 10);
+  if (end == text || *end != '\0' || parsed < min || parsed > max) {
+    invalid = true;
+    return false;
+  }
+  value = parsed;
+  return true;
+}
+
+bool WebServerManager::sendImageChunk(void* context, const uint8_t* data, size_t length) {
+  return httpd_resp_send_chunk(static_cast<httpd_req_t*>(context), (const char*)data, length) == ESP_OK;
+}
+
+bool WebServerManager::sendChunk(void* context, const char* data, size_t length) {
+  return httpd_resp_send_chunk(static_cast<httpd_req_t*>(context), data, length) == ESP_OK;
+}
+
+JsonWriter WebServerManager::beginJson(httpd_req_t* req, int code, char* buffer, size_t size) {
+  httpd_resp_set_status(req, statusLine(code));
+  httpd_resp_set_type(req, "application/json");
+  return JsonWriter(buffer, size, sendChunk, req);
+}
+
+esp_err_t WebServerManager::endJson(httpd_req_t* req, JsonWriter& json) {
+  // Fitted in one buffer: a plain response with Content-Length
+  if (json.flushedBytes() == 0 && json.ok()) {
+    return httpd_resp_send(req, json.data(), json.length());
   }
   
-  Serial.printf("Image sent: %u bytes\n", fb->len);
+  // Otherwise it already went out chunked; finish the chunk stream
+  if (!json.flush()) return ESP_FAIL;
+  return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+esp_err_t WebServerManager::sendError(httpd_req_t* req, int code, const char* error, const char* debug) {
+  char buffer[HttpConfig::JSON_BUFFER];
+  JsonWriter json = beginJson(req, code, buffer, sizeof(buffer));
+  json.beginObject();
+  json.field("error", error);
+  if (debug) {
+    json.field("debug", debug);
+  }
+  json.endObject();
+  return endJson(req, json);
+}
+
+esp_err_t WebServerManager::sendResponse(httpd_req_t* req, int code, const char* contentType, const char* body) {
+  httpd_resp_set_status(req, statusLine(code));
+  httpd_resp_set_type(req, contentType);
+  return httpd_resp_send(req, body, strlen(body));
+}
+
+const char* WebServerManager::statusLine(int code) {
+  switch (code) {
+    case 200: return "200 OK";
+    case 202: return "202 Accepted";
+    case 302: return "302 Found";
+    case 304: return "304 Not Modified";
+    case 400: return "400 Bad Request";
+    case 404: return "404 Not Found";
+    case 503: return "503 Service Unavailable";
+    default:  return "500 Internal Server Error";
+  }
 }
\ No newline at end of file
@@ -5,42 +5,193 @@
 #define WEB_SERVER_H
 
 #include <Arduino.h>
-#include <WebServer.h>
+#include <esp_http_server.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "camera_module.h"
 #include "wifi_module.h"
 #include "backend_client.h"
 #include "uart_controller.h"  // NEW: UART controller
+#include "analysis_queue.h"
+#include "stream_server.h"
+#include "event_channel.h"
+#include "metrics.h"
+#include "thumbnail_cache.h"
+#include "json_writer.h"
+
+class WebServerManager;
+
+// Passed to every handler as user_ctx; also carries the route's latency series
+struct RouteContext {
+  WebServerManager* owner;
+  char labels[64];           // route="...",method="..."
+  Histogram latency;
+};
+
+enum DeferredKind {
+  DEFER_ANALYZE,      // GET /api/analyze
+  DEFER_CAPTURE,      // GET /capture
+  DEFER_TEST,         // GET /test
+  DEFER_CAMERA_CONFIG // POST /api/camera/config
+};
+
+// A response produced off the HTTP task. The handler returns straight
+// away with the socket still open, the work task does the slow part and
+// fills in the response, and the server task writes it out.
+struct DeferredResponse {
+  WebServerManager* owner;
+  DeferredKind kind;
+  int scale;                 // DEFER_CAPTURE: thumbnail divisor, 1 = full frame
+  CameraSettings settings;   // DEFER_CAMERA_CONFIG: validated settings to apply...
+  bool persist;              // ...and whether to save them to NVS
+  int fd;
+  unsigned long arrivedAt;   // Request time, for sharing an analysis already in flight
+  bool active;               // Slot in use
+  bool cancelled;            // Socket closed before the response was ready
+  int code;
+  const char* contentType;
+  const char* headers;       // Extra "Name: value\r\n" lines
+  char text[HttpConfig::DEFERRED_BODY_SIZE];   // JSON body
+  size_t textLength;
+  uint8_t* data;             // Binary body instead of text (PSRAM, freed after sending)
+  size_t length;
+  
+  // Written without blocking; a full socket leaves the rest for flushDeferred()
+  bool sending;
+  char head[256];
+  size_t headLength;
+  size_t sent;               // Bytes of head + body on the wire
+  unsigned long lastProgress;
+};
 
 class WebServerManager {
 private:
-  WebServer* server;
+  httpd_handle_t server;
   CameraModule* camera;
   WiFiModule* wifi;
   UARTController* uartController;  // NEW: UART controller pointer
   BackendClient backendClient;
+  AnalysisQueue analysisQueue;
+  StreamServer streamServer;
+  EventChannel events;
+  ThumbnailCache thumbnails;
+  RouteContext routes[HttpConfig::MAX_URI_HANDLERS];
+  int routeCount;
+  
+  // Sampled when /metrics is scraped
+  Gauge heapFree;
+  Gauge heapMinFree;
+  Gauge heapMaxAlloc;
+  Gauge psramFree;
+  Gauge psramMinFree;
+  Gauge wifiRssi;
+  Gauge uptime;
+  
+  // Deferred responses
+  DeferredResponse deferred[HttpConfig::MAX_DEFERRED];
+  SemaphoreHandle_t deferredLock;
+  QueueHandle_t workQueue;
+  TaskHandle_t workHandle;
+  uint32_t deferredServed;
+  uint32_t deferredCancelled;
+  uint32_t deferredRejected;
+  unsigned long lastDeferredPoll;
+  volatile bool deferredFlushQueued;
+  
+  // State last pushed to /events listeners
+  unsigned long lastEventPoll;
+  bool eventsPrimed;
+  volatile bool eventFlushQueued;
+  unsigned long seenUartCommand;
+  unsigned long seenUartResponse;
+  bool seenUartConnected;
+  bool seenWifiConnected;
+  int seenRssi;
+  uint32_t seenHeap;
+  bool seenHeapLow;
+  uint32_t seenResult;
   
   // Route handlers
-  void handleRoot();
-  void handleCapture();
-  void handleAnalyzeAPI();
-  void handleStatus();
-  void handleTestConnection();
-  void handleNotFound();
+  esp_err_t handleRoot(httpd_req_t* req);
+  esp_err_t handleCapture(httpd_req_t* req);
+  esp_err_t handleStream(httpd_req_t* req);
+  esp_err_t handleAnalyzeAPI(httpd_req_t* req);
+  esp_err_t handleAnalyzeSubmit(httpd_req_t* req);
+  esp_err_t handleAnalyzeResult(httpd_req_t* req);
+  esp_err_t handleStatus(httpd_req_t* req);
+  esp_err_t handleDashboardInfo(httpd_req_t* req);
+  esp_err_t handleTestConnection(httpd_req_t* req);
+  esp_err_t handleEvents(httpd_req_t* req);
+  esp_err_t handleMetrics(httpd_req_t* req);
+  esp_err_t handleHistory(httpd_req_t* req);
+  esp_err_t handleCameraConfig(httpd_req_t* req);
+  esp_err_t handleCameraConfigUpdate(httpd_req_t* req);
+  static esp_err_t handleNotFound(httpd_req_t* req, httpd_err_code_t error);
   
   // NEW: UART control handlers
-  void handleUARTStatus();
-  void handleUARTTest();
+  esp_err_t handleUARTStatus(httpd_req_t* req);
+  esp_err_t handleUARTTest(httpd_req_t* req);
+  
+  // esp_http_server takes plain function pointers; user_ctx carries this.
+  // Timing covers the server task only - deferred work is not included.
+  template <esp_err_t (WebServerManager::*Handler)(httpd_req_t*)>
+  static esp_err_t route(httpd_req_t* req) {
+    RouteContext* context = static_cast<RouteContext*>(req->user_ctx);
+    unsigned long start = micros();
+    esp_err_t err = (context->owner->*Handler)(req);
+    context->latency.observe(micros() - start);
+    return err;
+  }
+  void addRoute(const char* uri, httpd_method_t method, esp_err_t (*handler)(httpd_req_t*));
+  
+  // Deferred responses
+  esp_err_t defer(httpd_req_t* req, DeferredKind kind, int scale = 1,
+                  const CameraSettings* settings = nullptr, bool persist = false);
+  void runDeferred(DeferredResponse& response);
+  void sendDeferred(DeferredResponse& response);
+  void releaseDeferred(DeferredResponse& response);
+  static void workTask(void* param);
+  void workLoop();
+  static void sendDeferredWork(void* arg);
+  static void flushDeferredWork(void* arg);
+  static void onSocketClose(httpd_handle_t handle, int fd);
+  static void keepGlobalContext(void* ctx) {}
+  
+  // Server-Sent Events
+  void publishEvent(EventType type, JsonWriter& json);
+  static void flushEventsWork(void* arg);
   
   // Utility functions
-  String getStatusJSON();
-  String processHTMLTemplate(const String& html);
-  void sendImageResponse(camera_fb_t* fb);
+  void writeStatusJSON(JsonWriter& json);
+  // detailLimit < 0 writes debug and serverResponse in full; otherwise debug
+  // is cut to that many characters and serverResponse is left out
+  void writeAnalysisFields(JsonWriter& json, const AnalysisResult& result, int detailLimit = -1);
+  void writeUARTStatus(JsonWriter& json);
+  static void writeCameraSettings(JsonWriter& json, const CameraSettings& settings);
+  esp_err_t sendThumbnail(httpd_req_t* req, const uint8_t* frame, size_t length, uint32_t sequence, int scale);
+  static bool sendChunk(void* context, const char* data, size_t length);
+  static bool sendImageChunk(void* context, const uint8_t* data, size_t length);
+  static JsonWriter beginJson(httpd_req_t* req, int code, char* buffer, size_t size);
+  static esp_err_t endJson(httpd_req_t* req, JsonWriter& json);
+  static esp_err_t sendError(httpd_req_t* req, int code, const char* error, const char* debug = nullptr);
+  static esp_err_t sendResponse(httpd_req_t* req, int code, const char* contentType, const char* body);
+  static bool getQueryValue(httpd_req_t* req, const char* key, char* value, size_t size);
+  static bool readForm(httpd_req_t* req, char* form, size_t size);
+  static bool formInt(const char* form, const char* key, int min, int max, int& value, bool& invalid);
+  static const char* statusLine(int code);
   
 public:
-  WebServerManager(WebServer* srv, CameraModule* cam, WiFiModule* wf, UARTController* uart);
+  WebServerManager(CameraModule* cam, WiFiModule* wf, UARTController* uart);
+  
+  bool begin();
+  bool isRunning() const { return server != nullptr; }
+  
+  // Called from loop(): pushes UART, detection, WiFi and heap changes to /events
+  void pollEvents();
   
-  void setupRoutes();
-  void handleClient();
+  // Called from loop(): resumes deferred responses that filled their socket
+  void pollDeferred();
 };
 
 #endif
\ No newline at end of file
@@ -7,6 +7,11 @@
 bool WiFiModule::initialize() {
   Serial.println("Connecting to mobile hotspot...");
   
+  reconnectsSucceeded = metrics.counter("honeybadger_wifi_reconnects_total", "WiFi reconnection attempts",
+                                        "result=\"success\"");
+  reconnectsFailed = metrics.counter("honeybadger_wifi_reconnects_total", "WiFi reconnection attempts",
+                                     "result=\"failure\"");
+  
   WiFi.disconnect(true);
   WiFi.mode(WIFI_STA);
   WiFi.begin(NetworkConfig::SSID, NetworkConfig::PASSWORD);
@@ -54,9 +59,11 @@ bool WiFiModule::reconnect() {
   connected = (WiFi.status() == WL_CONNECTED);
   
   if (connected) {
+    reconnectsSucceeded.inc();
     Serial.println("WiFi reconnected successfully!");
     Serial.println("IP address: " + getIP());
   } else {
+    reconnectsFailed.inc();
     Serial.println("WiFi reconnection failed.");
   }
   
@@ -6,10 +6,13 @@
 
 #include <WiFi.h>
 #include "config.h"
+#include "metrics.h"
 
 class WiFiModule {
 private:
   bool connected = false;
+  Counter reconnectsSucceeded;
+  Counter reconnectsFailed;
   
 public:
   // Initialization and connection
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Precompress the dashboard into a flash blob.
+
+Reads HTML_MAIN_PAGE from src/html_templates.h, gzips it and writes
+src/dashboard_page.h with the compressed bytes and an ETag derived from
+them. The firmware serves that blob as-is, so editing the template means
+re-running this:
+
+  python3 tools/build_dashboard.py            # regenerate
+  python3 tools/build_dashboard.py --check    # exit 1 if the header is stale
+
+It also works as a PlatformIO pre-build script
+(extra_scripts = pre:tools/build_dashboard.py), in which case the header is
+refreshed on every build and only rewritten when it changes.
+"""
+
+import argparse
+import gzip
+import os
+import re
+import sys
+import zlib
+
+TEMPLATE = os.path.join("src", "html_templates.h")
+OUTPUT = os.path.join("src", "dashboard_page.h")
+
+
+def extract_page(source):
+    match = re.search(r'HTML_MAIN_PAGE\[\] PROGMEM = R"\((.*?)\)";', source, re.S)
+    if not match:
+        raise ValueError("HTML_MAIN_PAGE raw string not found in " + TEMPLATE)
+    return match.group(1).encode("utf-8")
+
+
+def render_header(page):
+    # mtime=0 keeps the output (and so the ETag) stable across rebuilds
+    compressed = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = "%08x" % zlib.crc32(compressed)
+
+    lines = [
+        "// ============================================================================",
+        "// dashboard_page.h - Gzip-compressed dashboard (generated - do not edit)",
+        "// ============================================================================",
+        "// Generated by tools/build_dashboard.py from HTML_MAIN_PAGE in",
+        "// html_templates.h. Edit the template and re-run the script.",
+        "#ifndef DASHBOARD_PAGE_H",
+        "#define DASHBOARD_PAGE_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        'const char DASHBOARD_ETAG[] = "\\"%s\\"";' % etag,
+        "const size_t DASHBOARD_RAW_LENGTH = %d;" % len(page),
+        "const size_t DASHBOARD_GZ_LENGTH = %d;" % len(compressed),
+        "",
+        "const uint8_t DASHBOARD_GZ[] PROGMEM = {",
+    ]
+    for offset in range(0, len(compressed), 16):
+        row = compressed[offset:offset + 16]
+        lines.append("  " + ", ".join("0x%02x" % b for b in row) + ",")
+    lines += ["};", "", "#endif"]
+    return "\n".join(lines), len(page), len(compressed)
+
+
+def build(project_dir, check=False):
+    with open(os.path.join(project_dir, TEMPLATE), encoding="utf-8") as f:
+        header, raw, packed = render_header(extract_page(f.read()))
+
+    path = os.path.join(project_dir, OUTPUT)
+    current = None
+    if os.path.exists(path):
+        with open(path, encoding="utf-8") as f:
+            current = f.read()
+
+    if current == header:
+        return True
+    if check:
+        print("%s is stale - run tools/build_dashboard.py" % OUTPUT)
+        return False
+
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("Dashboard: %d bytes -> %d bytes gzipped (%.0f%%)" % (raw, packed, 100.0 * packed / raw))
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--check", action="store_true", help="only verify the header is current")
+    args = parser.parse_args()
+    project_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    return 0 if build(project_dir, args.check) else 1
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run as a PlatformIO extra script
+    build(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main())
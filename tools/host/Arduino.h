@@ -0,0 +1,121 @@
+// ============================================================================
+// Arduino.h - Minimal host stand-in for the arduino-esp32 core
+// ============================================================================
+// Just enough of String, Print, Stream, Serial and the timing calls for the
+// firmware modules that tools/ builds on the host. String is backed by
+// std::string, so allocation counts differ from WString; peak sizes don't.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using std::max;
+using std::min;
+
+inline unsigned long millis() {
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long micros() {
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline void* ps_malloc(size_t size) { return malloc(size); }
+
+class String {
+private:
+  std::string text;
+
+public:
+  String(const char* value = "") : text(value ? value : "") {}
+  String(const std::string& value) : text(value) {}
+  explicit String(char c) : text(1, c) {}
+  explicit String(int value) : text(std::to_string(value)) {}
+  explicit String(unsigned int value) : text(std::to_string(value)) {}
+  explicit String(long value) : text(std::to_string(value)) {}
+  explicit String(unsigned long value) : text(std::to_string(value)) {}
+  String(double value, int decimals) {
+    char digits[32];
+    snprintf(digits, sizeof(digits), "%.*f", decimals, value);
+    text = digits;
+  }
+
+  size_t length() const { return text.length(); }
+  const char* c_str() const { return text.c_str(); }
+  char operator[](size_t index) const { return index < text.length() ? text[index] : 0; }
+  bool operator==(const String& other) const { return text == other.text; }
+  bool operator==(const char* other) const { return text == other; }
+  bool reserve(size_t size) { text.reserve(size); return true; }
+  int indexOf(char c) const { size_t at = text.find(c); return at == std::string::npos ? -1 : (int)at; }
+  int lastIndexOf(char c) const { size_t at = text.rfind(c); return at == std::string::npos ? -1 : (int)at; }
+  String substring(size_t from, size_t to = std::string::npos) const {
+    return from >= text.length() ? String() : String(text.substr(from, to == std::string::npos ? to : to - from));
+  }
+  bool startsWith(const char* prefix) const { return text.compare(0, strlen(prefix), prefix) == 0; }
+  bool endsWith(const char* suffix) const {
+    size_t n = strlen(suffix);
+    return text.length() >= n && text.compare(text.length() - n, n, suffix) == 0;
+  }
+
+  String& operator+=(const String& other) { text += other.text; return *this; }
+  String& operator+=(const char* other) { text += other; return *this; }
+  String& operator+=(char c) { text += c; return *this; }
+  friend String operator+(const String& a, const String& b) { return String(a.text + b.text); }
+  friend String operator+(const String& a, const char* b) { return String(a.text + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.text); }
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (n < size && write(buffer[n])) n++;
+    return n;
+  }
+  size_t print(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+  size_t print(const String& text) { return print(text.c_str()); }
+  size_t println(const char* text = "") { return print(text) + print("\n"); }
+  size_t println(const String& text) { return println(text.c_str()); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    return n > 0 ? write((const uint8_t*)line, min((size_t)n, sizeof(line) - 1)) : 0;
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    int c;
+    while (n < length && (c = read()) >= 0) buffer[n++] = (char)c;
+    return n;
+  }
+};
+
+class HostSerial : public Print {
+public:
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  size_t write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+};
+
+inline HostSerial Serial;
+
+#endif
@@ -0,0 +1,127 @@
+// ============================================================================
+// FS.h - Host stand-in for the arduino-esp32 fs::FS / fs::File API
+// ============================================================================
+// fs::FS maps absolute paths onto a directory on the host, so FrameSpool
+// and friends can run against real files. Only the calls the firmware
+// makes are provided. File is a shared handle like the core's: copies refer
+// to the same open file.
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include "Arduino.h"
+#include <dirent.h>
+#include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File {
+private:
+  struct Handle {
+    std::string hostPath;
+    std::string name;
+    FILE* file = nullptr;
+    DIR* dir = nullptr;
+    ~Handle() {
+      if (file) fclose(file);
+      if (dir) closedir(dir);
+    }
+  };
+  std::shared_ptr<Handle> handle;
+
+public:
+  File() {}
+
+  static File open(const std::string& hostPath, const char* mode) {
+    File result;
+    auto h = std::make_shared<Handle>();
+    h->hostPath = hostPath;
+    size_t slash = hostPath.rfind('/');
+    h->name = slash == std::string::npos ? hostPath : hostPath.substr(slash + 1);
+
+    struct stat info;
+    bool exists = stat(hostPath.c_str(), &info) == 0;
+    if (exists && S_ISDIR(info.st_mode)) {
+      if (strcmp(mode, FILE_READ) != 0 || !(h->dir = opendir(hostPath.c_str()))) return result;
+    } else {
+      // "rb"/"wb"/"ab", plus '+' on append so the firmware can seek and read back
+      std::string hostMode = std::string(mode) + "b";
+      if (!strcmp(mode, FILE_APPEND)) hostMode = "a+b";
+      if (!(h->file = fopen(hostPath.c_str(), hostMode.c_str()))) return result;
+    }
+    result.handle = h;
+    return result;
+  }
+
+  explicit operator bool() const { return handle && (handle->file || handle->dir); }
+
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t* buffer, size_t size) {
+    return handle && handle->file ? fwrite(buffer, 1, size, handle->file) : 0;
+  }
+  size_t read(uint8_t* buffer, size_t size) {
+    return handle && handle->file ? fread(buffer, 1, size, handle->file) : 0;
+  }
+  int read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  bool seek(uint32_t position, SeekMode mode = SeekSet) {
+    return handle && handle->file && fseek(handle->file, position, mode) == 0;
+  }
+  size_t position() const { return handle && handle->file ? ftell(handle->file) : 0; }
+  size_t size() const {
+    struct stat info;
+    if (handle && handle->file) fflush(handle->file);
+    return handle && stat(handle->hostPath.c_str(), &info) == 0 ? info.st_size : 0;
+  }
+  void flush() { if (handle && handle->file) fflush(handle->file); }
+  void close() { handle.reset(); }
+
+  const char* name() const { return handle ? handle->name.c_str() : ""; }
+  bool isDirectory() const { return handle && handle->dir; }
+
+  File openNextFile() {
+    if (!handle || !handle->dir) return File();
+    while (dirent* entry = readdir(handle->dir)) {
+      if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")) continue;
+      return open(handle->hostPath + "/" + entry->d_name, FILE_READ);
+    }
+    return File();
+  }
+};
+
+class FS {
+private:
+  std::string root;
+
+  std::string hostPath(const char* path) const { return root + (path[0] == '/' ? "" : "/") + path; }
+
+public:
+  explicit FS(const std::string& directory) : root(directory) {}
+
+  File open(const char* path, const char* mode = FILE_READ) { return File::open(hostPath(path), mode); }
+  File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+
+  bool exists(const char* path) {
+    struct stat info;
+    return stat(hostPath(path).c_str(), &info) == 0;
+  }
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool mkdir(const char* path) { return ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+  bool remove(const char* path) { return ::unlink(hostPath(path).c_str()) == 0; }
+  bool rename(const char* from, const char* to) { return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0; }
+};
+
+}  // namespace fs
+
+using fs::File;
+
+#endif
@@ -0,0 +1,21 @@
+// ============================================================================
+// esp_camera.h - Host stand-in for esp32-camera (frame buffer type only)
+// ============================================================================
+#ifndef HOST_ESP_CAMERA_H
+#define HOST_ESP_CAMERA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include "sensor.h"
+
+typedef struct {
+  uint8_t* buf;
+  size_t len;
+  size_t width;
+  size_t height;
+  pixformat_t format;
+  struct timeval timestamp;
+} camera_fb_t;
+
+#endif
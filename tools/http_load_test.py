@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Concurrency load test for the ESP32-CAM HTTP server.
+
+Opens several keep-alive clients at once and mixes slow routes (which the
+firmware answers as deferred responses) with fast ones, then prints
+per-route latency. With the event-driven server, /status should stay fast
+while /api/analyze and /capture are in flight.
+
+  python3 tools/http_load_test.py 192.168.1.50
+  python3 tools/http_load_test.py 192.168.1.50 --clients 6 --duration 30 \\
+      --slow /api/analyze --fast /status --fast /uart/status
+
+Each client owns one connection and picks a route per request: slow routes
+with probability --slow-share, otherwise a fast one. A dropped connection
+is reopened and counted as an error.
+"""
+
+import argparse
+import http.client
+import random
+import statistics
+import sys
+import threading
+import time
+
+
+class RouteStats:
+    def __init__(self):
+        self.latencies = []
+        self.codes = {}
+        self.errors = 0
+        self.bytes = 0
+
+    def record(self, latency, code, size):
+        self.latencies.append(latency)
+        self.codes[code] = self.codes.get(code, 0) + 1
+        self.bytes += size
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, int(round(fraction * (len(ordered) - 1))))
+    return ordered[index]
+
+
+def client_loop(args, deadline, stats, lock, seed):
+    rng = random.Random(seed)
+    conn = None
+    while time.monotonic() < deadline:
+        if rng.random() < args.slow_share and args.slow:
+            path = rng.choice(args.slow)
+        else:
+            path = rng.choice(args.fast)
+        if conn is None:
+            conn = http.client.HTTPConnection(args.host, args.port, timeout=args.timeout)
+        start = time.monotonic()
+        try:
+            conn.request("GET", path)
+            response = conn.getresponse()
+            body = response.read()
+            latency = time.monotonic() - start
+            with lock:
+                stats[path].record(latency, response.status, len(body))
+            if response.getheader("Connection", "").lower() == "close":
+                conn.close()
+                conn = None
+        except (OSError, http.client.HTTPException):
+            with lock:
+                stats[path].errors += 1
+            conn.close()
+            conn = None
+            time.sleep(0.2)
+    if conn is not None:
+        conn.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host", help="device IP or hostname")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--clients", type=int, default=4, help="concurrent keep-alive connections")
+    parser.add_argument("--duration", type=float, default=20.0, help="seconds to run")
+    parser.add_argument("--timeout", type=float, default=30.0, help="per-request timeout")
+    parser.add_argument("--slow", action="append", help="slow route (repeatable)")
+    parser.add_argument("--fast", action="append", help="fast route (repeatable)")
+    parser.add_argument("--slow-share", type=float, default=0.25,
+                        help="fraction of requests that go to slow routes")
+    args = parser.parse_args()
+    args.slow = args.slow or ["/api/analyze", "/capture"]
+    args.fast = args.fast or ["/status", "/uart/status"]
+
+    stats = {path: RouteStats() for path in args.slow + args.fast}
+    lock = threading.Lock()
+    deadline = time.monotonic() + args.duration
+    threads = [threading.Thread(target=client_loop, args=(args, deadline, stats, lock, i))
+               for i in range(args.clients)]
+    started = time.monotonic()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.monotonic() - started
+
+    print(f"{args.clients} clients, {elapsed:.1f}s against {args.host}:{args.port}")
+    print(f"{'route':<16}{'ok':>6}{'err':>6}{'p50 ms':>9}{'p95 ms':>9}{'max ms':>9}  codes")
+    total = 0
+    for path, route in stats.items():
+        total += len(route.latencies)
+        if route.latencies:
+            ms = [latency * 1000 for latency in route.latencies]
+            timing = f"{statistics.median(ms):>9.0f}{percentile(ms, 0.95):>9.0f}{max(ms):>9.0f}"
+        else:
+            timing = f"{'-':>9}{'-':>9}{'-':>9}"
+        codes = " ".join(f"{code}x{count}" for code, count in sorted(route.codes.items()))
+        print(f"{path:<16}{len(route.latencies):>6}{route.errors:>6}{timing}  {codes}")
+    print(f"{total / elapsed:.1f} requests/s")
+    return 0 if total else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
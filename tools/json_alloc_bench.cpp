@@ -0,0 +1,211 @@
+// ============================================================================
+// json_alloc_bench.cpp - Host benchmark: heap allocations per JSON response
+// ============================================================================
+// Builds a /status-sized document two ways and counts every malloc/realloc:
+//   - the old pattern: String += "\"key\":" + String(value) + ","
+//   - JsonWriter into a 512-byte stack buffer flushed to a sink
+// The String here mirrors the ESP32 core's WString (11-byte SSO, concat
+// grows to the exact new length, "literal" + String goes through a
+// StringSumHelper copy), so the counts track what the firmware did.
+//
+//   g++ -O2 -Isrc tools/json_alloc_bench.cpp src/json_writer.cpp -o json_alloc_bench
+//   ./json_alloc_bench
+#include "json_writer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+// Allocation counting (glibc)
+// ---------------------------------------------------------------------------
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void __libc_free(void*);
+
+static bool counting = false;
+static unsigned long allocations = 0;
+static unsigned long long allocatedBytes = 0;
+
+extern "C" void* malloc(size_t size) {
+  if (counting) { allocations++; allocatedBytes += size; }
+  return __libc_malloc(size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) {
+  if (counting) { allocations++; allocatedBytes += size; }
+  return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr) {
+  __libc_free(ptr);
+}
+
+// ---------------------------------------------------------------------------
+// WString model
+// ---------------------------------------------------------------------------
+class String {
+protected:
+  static const size_t SSO = 11;
+  char sso[SSO + 1];
+  char* heap;
+  size_t len;
+  size_t cap;
+
+  char* buf() { return heap ? heap : sso; }
+  bool reserve(size_t size) {
+    if (size <= cap) return true;
+    if (!heap && size <= SSO) return true;
+    char* grown = (char*)realloc(heap, size + 1);
+    if (!grown) return false;
+    if (!heap) memcpy(grown, sso, len + 1);
+    heap = grown;
+    cap = size;
+    return true;
+  }
+
+public:
+  String(const char* text = "") : heap(nullptr), len(0), cap(SSO) { sso[0] = 0; concat(text, strlen(text)); }
+  String(const String& other) : heap(nullptr), len(0), cap(SSO) { sso[0] = 0; concat(other.c_str(), other.len); }
+  explicit String(unsigned long value) : heap(nullptr), len(0), cap(SSO) {
+    char digits[24];
+    sso[0] = 0;
+    concat(digits, snprintf(digits, sizeof(digits), "%lu", value));
+  }
+  explicit String(int value) : heap(nullptr), len(0), cap(SSO) {
+    char digits[24];
+    sso[0] = 0;
+    concat(digits, snprintf(digits, sizeof(digits), "%d", value));
+  }
+  String(double value, int decimals) : heap(nullptr), len(0), cap(SSO) {
+    char digits[40];
+    sso[0] = 0;
+    concat(digits, snprintf(digits, sizeof(digits), "%.*f", decimals, value));
+  }
+  ~String() { free(heap); }
+
+  void concat(const char* text, size_t n) {
+    if (!reserve(len + n)) return;
+    memcpy(buf() + len, text, n);
+    len += n;
+    buf()[len] = 0;
+  }
+  String& operator+=(const String& rhs) { concat(rhs.c_str(), rhs.len); return *this; }
+  String& operator+=(const char* rhs) { concat(rhs, strlen(rhs)); return *this; }
+  const char* c_str() const { return heap ? heap : sso; }
+  size_t length() const { return len; }
+};
+
+class StringSumHelper : public String {
+public:
+  StringSumHelper(const char* text) : String(text) {}
+  StringSumHelper(const String& s) : String(s) {}
+};
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs) {
+  StringSumHelper& sum = const_cast<StringSumHelper&>(lhs);
+  sum += rhs;
+  return sum;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const char* rhs) {
+  StringSumHelper& sum = const_cast<StringSumHelper&>(lhs);
+  sum += rhs;
+  return sum;
+}
+
+// ---------------------------------------------------------------------------
+// The two ways of building a status document
+// ---------------------------------------------------------------------------
+static const int SECTIONS = 10;
+static const int FIELDS_PER_SECTION = 8;
+static const char* SECTION_NAMES[SECTIONS] = {
+  "analysisWorker", "adaptiveQuality", "circuitBreaker", "http", "stream",
+  "lastFrame", "resultCache", "spool", "backendConnection", "uart"
+};
+static const char* FIELD_NAMES[FIELDS_PER_SECTION] = {
+  "running", "pending", "framesCaptured", "framesSent", "hits", "misses", "avgLatency", "state"
+};
+
+static size_t buildWithString(unsigned long seed) {
+  String json = "{";
+  json += "\"camera\":" + String(seed & 1 ? "true" : "false") + ",";
+  json += "\"freeHeap\":" + String(180000UL + seed % 1000) + ",";
+  json += "\"uptime\":" + String(seed * 1000) + ",";
+  json += "\"ip\":\"" + String("192.168.1.50") + "\"";
+  for (int s = 0; s < SECTIONS; s++) {
+    json += ",\"" + String(SECTION_NAMES[s]) + "\":{";
+    for (int f = 0; f < FIELDS_PER_SECTION; f++) {
+      if (f == 6) {
+        json += "\"" + String(FIELD_NAMES[f]) + "\":" + String(seed * 0.37 + f, 2);
+      } else if (f == 7) {
+        json += "\"" + String(FIELD_NAMES[f]) + "\":\"" + String("half-open") + "\"";
+      } else {
+        json += "\"" + String(FIELD_NAMES[f]) + "\":" + String(seed * (f + 1)) + ",";
+      }
+      if (f == 6) json += ",";
+    }
+    json += "}";
+  }
+  json += "}";
+  return json.length();
+}
+
+static size_t sinkBytes = 0;
+
+static bool discardSink(void*, const char*, size_t length) {
+  sinkBytes += length;
+  return true;
+}
+
+static size_t buildWithWriter(unsigned long seed) {
+  char buffer[512];
+  sinkBytes = 0;
+  JsonWriter json(buffer, sizeof(buffer), discardSink, nullptr);
+  json.beginObject();
+  json.field("camera", (seed & 1) != 0);
+  json.field("freeHeap", 180000UL + seed % 1000);
+  json.field("uptime", seed * 1000);
+  json.field("ip", "192.168.1.50");
+  for (int s = 0; s < SECTIONS; s++) {
+    json.beginObject(SECTION_NAMES[s]);
+    for (int f = 0; f < FIELDS_PER_SECTION; f++) {
+      if (f == 6) {
+        json.field(FIELD_NAMES[f], seed * 0.37 + f, 2);
+      } else if (f == 7) {
+        json.field(FIELD_NAMES[f], "half-open");
+      } else {
+        json.field(FIELD_NAMES[f], seed * (f + 1));
+      }
+    }
+    json.endObject();
+  }
+  json.endObject();
+  json.flush();
+  return sinkBytes;
+}
+
+static void run(const char* name, size_t (*build)(unsigned long), int iterations) {
+  allocations = 0;
+  allocatedBytes = 0;
+  size_t bytes = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  counting = true;
+  for (int i = 0; i < iterations; i++) {
+    bytes += build(i + 1);
+  }
+  counting = false;
+  auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+  printf("%-16s %6zu B/doc %8.1f allocs/doc %10.0f B allocated/doc %8.2f us/doc\n", name,
+         bytes / iterations, (double)allocations / iterations, (double)allocatedBytes / iterations,
+         elapsed / iterations);
+}
+
+int main() {
+  const int iterations = 20000;
+  run("String concat", buildWithString, iterations);
+  run("JsonWriter", buildWithWriter, iterations);
+  return 0;
+}
\ No newline at end of file
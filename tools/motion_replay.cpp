@@ -0,0 +1,100 @@
+// ============================================================================
+// motion_replay.cpp - Host replay of the motion detector over recorded frames
+// ============================================================================
+// Feeds a sequence of binary PGM (P5) frames through the same
+// MotionDetector the firmware runs and prints a verdict per frame, then the
+// share of backend uploads the gate would have avoided had every frame
+// asked for an analysis. The firmware decodes at 1/8 scale, so frames
+// pulled from /history should be shrunk the same way first:
+//
+//   ffmpeg -i f_%03d.jpg -vf scale=iw/8:ih/8,format=gray f_%03d.pgm
+//
+//   g++ -O2 -Isrc tools/motion_replay.cpp src/motion_detector.cpp -o motion_replay
+//   ./motion_replay [--fps 5] [--hold 10000] f_*.pgm
+#include "motion_detector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static bool readPgm(const char* path, std::vector<uint8_t>& pixels, int& width, int& height) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+
+  int maxValue = 0;
+  bool ok = fscanf(f, "P5 %d %d %d", &width, &height, &maxValue) == 3 && fgetc(f) != EOF &&
+            width > 0 && height > 0 && width < 65536 && height < 65536 && maxValue == 255;
+  if (ok) {
+    pixels.resize((size_t)width * height);
+    ok = fread(pixels.data(), 1, pixels.size(), f) == pixels.size();
+  }
+  fclose(f);
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  int fps = 5;          // MotionConfig::SAMPLE_FPS
+  int holdMs = 10000;   // MotionConfig::HOLD_MS
+  std::vector<const char*> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+      fps = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--hold") == 0 && i + 1 < argc) {
+      holdMs = atoi(argv[++i]);
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (files.empty() || fps <= 0) {
+    fprintf(stderr, "usage: %s [--fps N] [--hold MS] frame.pgm...\n", argv[0]);
+    return 1;
+  }
+
+  MotionDetector detector;
+  std::vector<uint8_t> gray;
+  int motionFrames = 0, lightingChanges = 0, gatedOpen = 0, processed = 0;
+  long lastMotionMs = -1;
+  double busySeconds = 0;
+
+  for (size_t n = 0; n < files.size(); n++) {
+    int width = 0, height = 0;
+    if (!readPgm(files[n], gray, width, height)) {
+      fprintf(stderr, "%s: not an 8-bit binary PGM\n", files[n]);
+      continue;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MotionResult result = detector.process(gray.data(), width, height);
+    busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    processed++;
+
+    // Frame timestamps follow the firmware's sampling rate
+    long nowMs = (long)(n * 1000 / fps);
+    if (result.motion) {
+      motionFrames++;
+      lastMotionMs = nowMs;
+    }
+    if (result.lightingChange) {
+      lightingChanges++;
+    }
+    bool open = lastMotionMs >= 0 && nowMs - lastMotionMs <= holdMs;
+    if (open) {
+      gatedOpen++;
+    }
+
+    printf("%6ld ms  %-8s %3u/%-3u blocks  gate %-6s %s\n", nowMs,
+           result.motion ? "MOTION" : (result.lightingChange ? "LIGHTING" : "-"),
+           result.changedBlocks, result.totalBlocks, open ? "open" : "closed", files[n]);
+  }
+
+  if (processed == 0) return 1;
+
+  printf("\n%d frames, %d with motion, %d lighting changes\n", processed, motionFrames, lightingChanges);
+  printf("Detector: %.1f us/frame (%.0f fps on this host)\n", busySeconds * 1e6 / processed,
+         busySeconds > 0 ? processed / busySeconds : 0.0);
+  printf("Uploads avoided: %d of %d (%.1f%%)\n", processed - gatedOpen, processed,
+         100.0 * (processed - gatedOpen) / processed);
+  return 0;
+}
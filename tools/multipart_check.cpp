@@ -0,0 +1,239 @@
+// ============================================================================
+// multipart_check.cpp - Host check: MultipartStream vs the old malloc'd body
+// ============================================================================
+// Builds the upload body for one JPEG both ways and checks that:
+//   - MultipartStream yields exactly the bytes createMultipartPayload() used
+//     to malloc, when drained in HTTPClient-sized (1460 byte) reads
+//   - its peak heap stays flat while the old path peaks at the full body
+// With --upload host:port it also POSTs both bodies to the stand-in backend
+// (tools/standin_backend.py serve) and compares the CRC32 the server saw.
+//
+//   g++ -O2 -Itools/host -Isrc tools/multipart_check.cpp src/multipart_stream.cpp -o multipart_check
+//   ./multipart_check capture.jpg [--upload 127.0.0.1:8080]
+#include "multipart_stream.h"
+#include <malloc.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Live heap tracking (glibc)
+// ---------------------------------------------------------------------------
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void __libc_free(void*);
+
+static size_t liveBytes = 0;
+static size_t peakBytes = 0;
+
+static void track(void* ptr, bool added) {
+  if (!ptr) return;
+  size_t size = malloc_usable_size(ptr);
+  if (added) {
+    liveBytes += size;
+    if (liveBytes > peakBytes) peakBytes = liveBytes;
+  } else {
+    liveBytes -= min(size, liveBytes);
+  }
+}
+
+extern "C" void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  track(ptr, true);
+  return ptr;
+}
+
+extern "C" void* realloc(void* ptr, size_t size) {
+  track(ptr, false);
+  void* grown = __libc_realloc(ptr, size);
+  track(grown ? grown : ptr, true);
+  return grown;
+}
+
+extern "C" void free(void* ptr) {
+  track(ptr, false);
+  __libc_free(ptr);
+}
+
+static void resetPeak() { peakBytes = liveBytes; }
+static size_t peakAbove(size_t baseline) { return peakBytes - baseline; }
+
+// ---------------------------------------------------------------------------
+// The pre-MultipartStream upload body, as BackendClient built it
+// ---------------------------------------------------------------------------
+static uint8_t* createMultipartPayload(camera_fb_t* fb, const String& boundary, size_t& totalLength) {
+  String bodyStart = "--" + boundary + "\r\n";
+  bodyStart += "Content-Disposition: form-data; name=\"image\"; filename=\"capture.jpg\"\r\n";
+  bodyStart += "Content-Type: image/jpeg\r\n\r\n";
+  String bodyEnd = "\r\n--" + boundary + "--\r\n";
+
+  totalLength = bodyStart.length() + fb->len + bodyEnd.length();
+  uint8_t* payload = (uint8_t*)malloc(totalLength);
+  if (!payload) return nullptr;
+
+  memcpy(payload, bodyStart.c_str(), bodyStart.length());
+  memcpy(payload + bodyStart.length(), fb->buf, fb->len);
+  memcpy(payload + bodyStart.length() + fb->len, bodyEnd.c_str(), bodyEnd.length());
+  return payload;
+}
+
+static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+  crc = ~crc;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+  }
+  return ~crc;
+}
+
+// ---------------------------------------------------------------------------
+// Stand-in upload
+// ---------------------------------------------------------------------------
+class Upload {
+private:
+  int sock;
+
+public:
+  Upload(const char* hostPort, const String& boundary, size_t contentLength) : sock(-1) {
+    std::string host(hostPort);
+    size_t colon = host.rfind(':');
+    std::string port = colon == std::string::npos ? "8080" : host.substr(colon + 1);
+    host = host.substr(0, colon);
+
+    addrinfo hints = {};
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addr = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addr) != 0) return;
+    sock = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if (sock >= 0 && connect(sock, addr->ai_addr, addr->ai_addrlen) != 0) {
+      close(sock);
+      sock = -1;
+    }
+    freeaddrinfo(addr);
+    if (sock < 0) return;
+
+    char head[512];
+    int n = snprintf(head, sizeof(head),
+                     "POST /api/Camera/analyze HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n"
+                     "Content-Type: multipart/form-data; boundary=%s\r\nContent-Length: %zu\r\n\r\n",
+                     host.c_str(), boundary.c_str(), contentLength);
+    send(head, n);
+  }
+
+  ~Upload() { if (sock >= 0) close(sock); }
+
+  bool ok() const { return sock >= 0; }
+
+  void send(const void* data, size_t length) {
+    if (sock >= 0 && ::send(sock, data, length, MSG_NOSIGNAL) != (ssize_t)length) {
+      close(sock);
+      sock = -1;
+    }
+  }
+
+  // CRC32 of the body as the stand-in received it, from X-Body-CRC32
+  bool serverCrc(uint32_t& crc) {
+    if (sock < 0) return false;
+    std::string response;
+    char chunk[512];
+    ssize_t n;
+    while ((n = recv(sock, chunk, sizeof(chunk), 0)) > 0) response.append(chunk, n);
+
+    size_t at = response.find("X-Body-CRC32: ");
+    if (response.compare(0, 12, "HTTP/1.1 200") != 0 || at == std::string::npos) return false;
+    crc = (uint32_t)strtoul(response.c_str() + at + 14, nullptr, 16);
+    return true;
+  }
+};
+
+int main(int argc, char** argv) {
+  const char* path = nullptr;
+  const char* upload = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--upload") && i + 1 < argc) upload = argv[++i];
+    else path = argv[i];
+  }
+  if (!path) {
+    fprintf(stderr, "usage: %s capture.jpg [--upload host:port]\n", argv[0]);
+    return 2;
+  }
+
+  FILE* f = fopen(path, "rb");
+  if (!f) { perror(path); return 2; }
+  std::vector<uint8_t> jpeg;
+  uint8_t block[4096];
+  size_t n;
+  while ((n = fread(block, 1, sizeof(block), f)) > 0) jpeg.insert(jpeg.end(), block, block + n);
+  fclose(f);
+
+  camera_fb_t fb = {};
+  fb.buf = jpeg.data();
+  fb.len = jpeg.size();
+  fb.format = PIXFORMAT_JPEG;
+  String boundary = "----ESP32CAMBoundary" + String(millis());
+
+  // Legacy: one malloc the size of the whole body
+  size_t baseline = liveBytes;
+  resetPeak();
+  size_t legacyLength = 0;
+  uint8_t* legacy = createMultipartPayload(&fb, boundary, legacyLength);
+  size_t legacyPeak = peakAbove(baseline);
+  if (!legacy) { fprintf(stderr, "legacy payload allocation failed\n"); return 1; }
+  uint32_t legacyCrc = crc32(legacy, legacyLength);
+
+  // Streamed: drained the way HTTPClient::sendRequest(Stream*) does it
+  std::vector<uint8_t> streamed;
+  streamed.reserve(legacyLength);
+  baseline = liveBytes;
+  resetPeak();
+  size_t streamLength;
+  {
+    MultipartStream body(&fb, boundary);
+    streamLength = body.totalLength();
+    char chunk[1460];
+    size_t got;
+    while ((got = body.readBytes(chunk, sizeof(chunk))) > 0) {
+      streamed.insert(streamed.end(), chunk, chunk + got);
+    }
+  }
+  size_t streamPeak = peakAbove(baseline);
+
+  bool same = streamLength == legacyLength && streamed.size() == legacyLength &&
+              memcmp(streamed.data(), legacy, legacyLength) == 0;
+
+  printf("%zu byte JPEG, %zu byte body\n\n", fb.len, legacyLength);
+  printf("%-10s %12s %10s\n", "path", "peak heap", "crc32");
+  printf("%-10s %12zu   %08x\n", "legacy", legacyPeak, legacyCrc);
+  printf("%-10s %12zu %10s\n", "stream", streamPeak, same ? "identical" : "MISMATCH");
+
+  int rc = same ? 0 : 1;
+  if (!same) {
+    size_t at = 0;
+    while (at < min(streamed.size(), legacyLength) && streamed[at] == legacy[at]) at++;
+    printf("\nfirst difference at byte %zu (stream %zu bytes, legacy %zu)\n", at, streamed.size(), legacyLength);
+  }
+
+  if (upload) {
+    printf("\n");
+    uint32_t serverCrc = 0;
+
+    Upload legacyPost(upload, boundary, legacyLength);
+    legacyPost.send(legacy, legacyLength);
+    bool legacyOk = legacyPost.serverCrc(serverCrc) && serverCrc == legacyCrc;
+    printf("%-10s upload %s\n", "legacy", legacyOk ? "ok" : "FAILED");
+
+    MultipartStream body(&fb, boundary);
+    Upload streamPost(upload, boundary, body.totalLength());
+    char chunk[1460];
+    size_t got;
+    while ((got = body.readBytes(chunk, sizeof(chunk))) > 0) streamPost.send(chunk, got);
+    bool streamOk = streamPost.serverCrc(serverCrc) && serverCrc == legacyCrc;
+    printf("%-10s upload %s\n", "stream", streamOk ? "ok" : "FAILED");
+
+    if (!legacyOk || !streamOk) rc = 1;
+  }
+
+  free(legacy);
+  return rc;
+}
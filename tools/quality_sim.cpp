@@ -0,0 +1,134 @@
+// ============================================================================
+// quality_sim.cpp - Host driver: QualityController over a simulated link
+// ============================================================================
+// Runs the firmware's QualityController against a link model with phases of
+// different throughput, signal strength and drop rate, one analysis every
+// --interval seconds, and prints per phase how close httpDuration stayed to
+// AdaptiveConfig::TARGET_LATENCY_MS, which profiles were used and how often
+// the controller changed its mind.
+//
+// Upload time is modelled as RTT + payload / throughput with +-20% jitter.
+// Payload is pixels * 2 / quality bytes, which lands QVGA q20 at ~7.7 KB.
+// An upload over SystemConfig::HTTP_TIMEOUT, or a random drop, is reported
+// as a link failure, as analyzeImage does.
+//
+//   g++ -O2 -Itools/host -Isrc tools/quality_sim.cpp src/quality_controller.cpp -o quality_sim
+//   ./quality_sim [--interval 5] [--seed 1] [--trace] [KBps:rssi:drop%:samples ...]
+#include "quality_controller.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+struct Phase {
+  float throughputKBps;
+  int rssi;
+  int dropPercent;
+  int samples;
+};
+
+static uint32_t rngState = 1;
+
+static float uniform() {
+  rngState = rngState * 1664525u + 1013904223u;
+  return (rngState >> 8) / 16777216.0f;
+}
+
+static size_t payloadBytes(const QualityProfile& profile) {
+  uint32_t pixels = (uint32_t)resolution[profile.frameSize].width * resolution[profile.frameSize].height;
+  return pixels * 2 / profile.jpegQuality;
+}
+
+int main(int argc, char** argv) {
+  int intervalSec = 5;
+  bool trace = false;
+  std::vector<Phase> phases;
+
+  for (int i = 1; i < argc; i++) {
+    Phase phase;
+    if (!strcmp(argv[i], "--interval") && i + 1 < argc) {
+      intervalSec = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoul(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "--trace")) {
+      trace = true;
+    } else if (sscanf(argv[i], "%f:%d:%d:%d", &phase.throughputKBps, &phase.rssi,
+                      &phase.dropPercent, &phase.samples) == 4 && phase.throughputKBps > 0) {
+      phases.push_back(phase);
+    } else {
+      fprintf(stderr, "usage: %s [--interval s] [--seed n] [--trace] [KBps:rssi:drop%%:samples ...]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (phases.empty()) {
+    phases = {
+      {40.0f, -55, 0, 60},    // Good WiFi
+      {6.0f, -70, 0, 60},     // Congested
+      {2.5f, -80, 10, 60},    // Weak and lossy
+      {40.0f, -58, 0, 60},    // Recovered
+    };
+  }
+
+  QualityController controller;
+  controller.setEnabled(true);
+  controller.reset();
+
+  const float rttMs = 300;
+  const float high = AdaptiveConfig::TARGET_LATENCY_MS * (100 + AdaptiveConfig::HYSTERESIS_PERCENT) / 100.0f;
+  const float low = AdaptiveConfig::TARGET_LATENCY_MS * (100 - AdaptiveConfig::HYSTERESIS_PERCENT) / 100.0f;
+  unsigned long now = 0;
+  unsigned long totalChanges = 0;
+
+  printf("target %d ms (band %.0f-%.0f), one analysis every %d s, start %s\n\n",
+         AdaptiveConfig::TARGET_LATENCY_MS, low, high, intervalSec, controller.getProfile().name);
+  printf("%-22s %8s %8s %8s %8s %8s  %s\n", "phase", "avg ms", "in band", "failed", "changes", "avg KB", "profiles used");
+
+  for (const Phase& phase : phases) {
+    std::vector<int> levelSamples(controller.getLevelCount(), 0);
+    float latencySum = 0;
+    float kbSum = 0;
+    int inBand = 0;
+    int failed = 0;
+    unsigned long changesBefore = controller.getChangeCount();
+
+    for (int n = 0; n < phase.samples; n++) {
+      now += intervalSec * 1000UL;
+      const QualityProfile& profile = controller.getProfile();
+      levelSamples[controller.getLevel()]++;
+
+      size_t bytes = payloadBytes(profile);
+      float jitter = 0.8f + 0.4f * uniform();
+      unsigned long latency = (unsigned long)((rttMs + bytes / phase.throughputKBps) * jitter);
+      bool dropped = uniform() * 100 < phase.dropPercent;
+      bool linkFailed = dropped || latency > (unsigned long)SystemConfig::HTTP_TIMEOUT;
+      if (linkFailed) {
+        latency = SystemConfig::HTTP_TIMEOUT;
+        failed++;
+      } else if (latency >= low && latency <= high) {
+        inBand++;
+      }
+      latencySum += latency;
+      kbSum += bytes / 1024.0f;
+
+      bool changed = controller.update(latency, bytes, phase.rssi, linkFailed, now);
+      if (trace) {
+        printf("  t=%5lus %-10s %6zu B %6lu ms%s -> %s%s\n", now / 1000, profile.name, bytes, latency,
+               linkFailed ? " FAIL" : "", controller.getLastDecision(), changed ? " *" : "");
+      }
+    }
+
+    char label[32];
+    snprintf(label, sizeof(label), "%.1fKB/s %ddBm %d%%", phase.throughputKBps, phase.rssi, phase.dropPercent);
+    unsigned long changes = controller.getChangeCount() - changesBefore;
+    totalChanges += changes;
+    printf("%-22s %8.0f %7d%% %8d %8lu %8.1f  ", label, latencySum / phase.samples,
+           inBand * 100 / phase.samples, failed, changes, kbSum / phase.samples);
+    for (int level = 0; level < controller.getLevelCount(); level++) {
+      if (levelSamples[level]) printf("L%d:%d ", level, levelSamples[level]);
+    }
+    printf("\n");
+  }
+
+  printf("\n%lu profile changes, ending at %s\n", totalChanges, controller.getProfile().name);
+  return 0;
+}
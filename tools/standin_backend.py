@@ -0,0 +1,307 @@
+#!/usr/bin/env python3
+"""Local stand-in for the honey badger detection backend.
+
+Speaks both upload protocols the ESP32-CAM firmware can use:
+
+  POST /api/Camera/analyze          multipart/form-data "image" -> JSON verdict
+  POST /api/Camera/analyze-compact  binary header + JPEG -> 12-byte verdict
+
+The verdict is a deterministic fake derived from the image bytes, so the
+same frame always gets the same answer. Every request logs the bytes that
+crossed the wire in each direction.
+
+  serve:    python3 tools/standin_backend.py serve --port 8443 --cert c.pem --key k.pem
+  compare:  python3 tools/standin_backend.py compare capture.jpg --url http://127.0.0.1:8080
+  keepalive: python3 tools/standin_backend.py keepalive capture.jpg --url https://127.0.0.1:8443
+
+`compare` posts the same JPEG through both protocols over one keep-alive
+connection each and prints request/response sizes and latency.
+`keepalive` posts it over a fresh TLS connection per request (what the
+firmware did before BackendConnection) and then over one reused connection,
+and prints handshake and per-request latency for each. Session tickets are
+disabled on the client, as WiFiClientSecure can't resume sessions either, so
+every cold request pays a full handshake.
+Point NetworkConfig::BACKEND_HOST/BACKEND_PORT at `serve` (with a cert; the
+firmware talks TLS) to exercise a real device against it.
+"""
+
+import argparse
+import http.client
+import http.server
+import json
+import ssl
+import statistics
+import struct
+import sys
+import time
+import urllib.parse
+import zlib
+
+MULTIPART_PATH = "/api/Camera/analyze"
+COMPACT_PATH = "/api/Camera/analyze-compact"
+
+# Must match CompactFrameHeader / CompactVerdict in src/compact_protocol.h
+FRAME_HEADER = struct.Struct("<IBBHHHIIII")
+VERDICT = struct.Struct("<IBBBBHH")
+FRAME_MAGIC = 0x31464248    # "HBF1"
+VERDICT_MAGIC = 0x31564248  # "HBV1"
+VERSION = 1
+
+
+def fake_verdict(jpeg):
+    confidence = (zlib.crc32(jpeg) % 10000) / 10000.0
+    return confidence >= 0.5, confidence
+
+
+def parse_multipart_image(body, content_type):
+    boundary = None
+    for part in content_type.split(";"):
+        part = part.strip()
+        if part.startswith("boundary="):
+            boundary = part[len("boundary="):].strip('"')
+    if not boundary:
+        return None
+    delimiter = b"--" + boundary.encode()
+    for section in body.split(delimiter):
+        head, sep, data = section.partition(b"\r\n\r\n")
+        if sep and b'name="image"' in head:
+            return data[:-2] if data.endswith(b"\r\n") else data
+    return None
+
+
+def read_chunked(rfile):
+    body = b""
+    while True:
+        size = int(rfile.readline().split(b";")[0].strip(), 16)
+        if size == 0:
+            rfile.readline()
+            return body
+        body += rfile.read(size)
+        rfile.readline()
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def read_body(self):
+        if self.headers.get("Transfer-Encoding", "").lower() == "chunked":
+            return read_chunked(self.rfile)
+        return self.rfile.read(int(self.headers.get("Content-Length", 0)))
+
+    def reply(self, code, content_type, payload, body=None):
+        self.send_response(code)
+        self.send_header("Content-Type", content_type)
+        if body is not None:
+            # Lets host tools confirm the server saw the exact bytes they sent
+            self.send_header("X-Body-CRC32", "%08x" % zlib.crc32(body))
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+    def do_GET(self):
+        # testConnection / circuit breaker probe
+        self.reply(200, "text/plain", b"ok")
+
+    def do_POST(self):
+        start = time.monotonic()
+        path = urllib.parse.urlparse(self.path).path
+        body = self.read_body()
+
+        if path == MULTIPART_PATH:
+            jpeg = parse_multipart_image(body, self.headers.get("Content-Type", ""))
+            if jpeg is None:
+                self.reply(400, "text/plain", b"missing image part")
+                return
+            badger, confidence = fake_verdict(jpeg)
+            payload = json.dumps({
+                "isHoneyBadger": badger,
+                "confidence": round(confidence, 4),
+                "processingTimeMs": int((time.monotonic() - start) * 1000),
+                "model": "standin",
+            }).encode()
+            self.reply(200, "application/json", payload, body)
+            detail = "%d byte JPEG" % len(jpeg)
+
+        elif path == COMPACT_PATH:
+            if len(body) < FRAME_HEADER.size:
+                self.reply(400, "text/plain", b"short body")
+                return
+            magic, version, fmt, width, height, _, seq, capture_ms, unix_time, length = \
+                FRAME_HEADER.unpack_from(body)
+            jpeg = body[FRAME_HEADER.size:]
+            if magic != FRAME_MAGIC or version != VERSION or length != len(jpeg):
+                self.reply(400, "text/plain", b"bad frame header")
+                return
+            badger, confidence = fake_verdict(jpeg)
+            server_ms = int((time.monotonic() - start) * 1000)
+            payload = VERDICT.pack(VERDICT_MAGIC, VERSION, 0, 1 if badger else 0, 0,
+                                   int(confidence * 10000), min(server_ms, 0xFFFF))
+            self.reply(200, "application/octet-stream", payload, body)
+            detail = "#%d %dx%d captured at %d ms" % (seq, width, height, capture_ms)
+
+        else:
+            self.reply(404, "text/plain", b"not found")
+            return
+
+        print("%-9s up %7d B  down %4d B  %s" % (
+            "compact" if path == COMPACT_PATH else "multipart", len(body), len(payload), detail))
+
+
+def serve(args):
+    server = http.server.ThreadingHTTPServer((args.host, args.port), Handler)
+    scheme = "http"
+    if args.cert:
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(args.cert, args.key)
+        server.socket = context.wrap_socket(server.socket, server_side=True)
+        scheme = "https"
+    print("Stand-in backend on %s://%s:%d" % (scheme, args.host, args.port))
+    server.serve_forever()
+
+
+def build_multipart(jpeg):
+    boundary = "----ESP32CAMBoundary%d" % int(time.time() * 1000)
+    body = ("--%s\r\n" % boundary).encode()
+    body += b'Content-Disposition: form-data; name="image"; filename="capture.jpg"\r\n'
+    body += b"Content-Type: image/jpeg\r\n\r\n" + jpeg
+    body += ("\r\n--%s--\r\n" % boundary).encode()
+    return "multipart/form-data; boundary=" + boundary, body
+
+
+def build_compact(jpeg, seq):
+    header = FRAME_HEADER.pack(FRAME_MAGIC, VERSION, 4, 320, 240, 0, seq,
+                               int(time.monotonic() * 1000) & 0xFFFFFFFF, int(time.time()), len(jpeg))
+    return "application/octet-stream", header + jpeg
+
+
+def request_once(conn, path, content_type, body):
+    # Headers as the firmware sends them, so header bytes are comparable
+    headers = [("Host", conn.host), ("User-Agent", "ESP32-CAM-HoneyBadger/2.0"),
+               ("Connection", "keep-alive"), ("Content-Type", content_type),
+               ("Content-Length", str(len(body)))]
+    start = time.perf_counter()
+    conn.putrequest("POST", path, skip_host=True, skip_accept_encoding=True)
+    for name, value in headers:
+        conn.putheader(name, value)
+    conn.endheaders(body)
+    response = conn.getresponse()
+    payload = response.read()
+    elapsed = (time.perf_counter() - start) * 1000
+
+    request_bytes = len("POST %s HTTP/1.1\r\n" % path) + sum(len("%s: %s\r\n" % h) for h in headers) + 2 + len(body)
+    response_bytes = len("HTTP/1.1 %d %s\r\n" % (response.status, response.reason)) + \
+        len(str(response.headers)) + len(payload)
+    return response.status, request_bytes, len(body), response_bytes, len(payload), elapsed
+
+
+def compare(args):
+    with open(args.image, "rb") as f:
+        jpeg = f.read()
+    url = urllib.parse.urlparse(args.url)
+    connection_class = http.client.HTTPSConnection if url.scheme == "https" else http.client.HTTPConnection
+
+    print("%d byte JPEG, %d requests per protocol\n" % (len(jpeg), args.count))
+    print("%-10s %10s %10s %10s %10s %10s %10s" % (
+        "protocol", "req total", "req body", "resp total", "resp body", "avg ms", "p95 ms"))
+
+    for name in ("multipart", "compact"):
+        kwargs = {"context": ssl._create_unverified_context()} if url.scheme == "https" else {}
+        conn = connection_class(url.hostname, url.port, **kwargs)
+        latencies = []
+        for seq in range(1, args.count + 1):
+            if name == "multipart":
+                content_type, body = build_multipart(jpeg)
+                path = MULTIPART_PATH
+            else:
+                content_type, body = build_compact(jpeg, seq)
+                path = COMPACT_PATH
+            status, req_total, req_body, resp_total, resp_body, ms = request_once(conn, path, content_type, body)
+            if status != 200:
+                sys.exit("%s request failed with HTTP %d" % (name, status))
+            latencies.append(ms)
+        conn.close()
+
+        print("%-10s %10d %10d %10d %10d %10.2f %10.2f" % (
+            name, req_total, req_body, resp_total, resp_body, statistics.mean(latencies),
+            percentile95(latencies)))
+
+
+def percentile95(values):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * 0.95))]
+
+
+def keepalive(args):
+    with open(args.image, "rb") as f:
+        jpeg = f.read()
+    url = urllib.parse.urlparse(args.url)
+    if url.scheme == "https":
+        context = ssl._create_unverified_context()
+        context.options |= ssl.OP_NO_TICKET
+        connect = lambda: http.client.HTTPSConnection(url.hostname, url.port, context=context)
+    else:
+        connect = lambda: http.client.HTTPConnection(url.hostname, url.port)
+
+    print("%d byte JPEG, %d requests per mode over %s\n" % (len(jpeg), args.count, url.scheme))
+    print("%-8s %12s %10s %10s %10s" % ("mode", "handshakes", "conn ms", "avg ms", "p95 ms"))
+
+    for mode in ("cold", "reused"):
+        conn = None
+        handshakes = []
+        latencies = []
+        for _ in range(args.count):
+            start = time.perf_counter()
+            if conn is None:
+                conn = connect()
+                conn.connect()
+                handshakes.append((time.perf_counter() - start) * 1000)
+            content_type, body = build_multipart(jpeg)
+            status = request_once(conn, MULTIPART_PATH, content_type, body)[0]
+            if status != 200:
+                sys.exit("%s request failed with HTTP %d" % (mode, status))
+            latencies.append((time.perf_counter() - start) * 1000)
+            if mode == "cold":
+                conn.close()
+                conn = None
+        if conn is not None:
+            conn.close()
+
+        print("%-8s %12d %10.2f %10.2f %10.2f" % (
+            mode, len(handshakes), statistics.mean(handshakes), statistics.mean(latencies),
+            percentile95(latencies)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    s = sub.add_parser("serve", help="run the stand-in backend")
+    s.add_argument("--host", default="0.0.0.0")
+    s.add_argument("--port", type=int, default=8080)
+    s.add_argument("--cert", help="PEM certificate; enables TLS")
+    s.add_argument("--key", help="PEM private key for --cert")
+
+    c = sub.add_parser("compare", help="byte count / latency of multipart+JSON vs compact")
+    c.add_argument("image", help="JPEG to upload")
+    c.add_argument("--url", default="http://127.0.0.1:8080")
+    c.add_argument("-n", "--count", type=int, default=20)
+
+    k = sub.add_parser("keepalive", help="latency of a fresh TLS connection per request vs one reused")
+    k.add_argument("image", help="JPEG to upload")
+    k.add_argument("--url", default="https://127.0.0.1:8443")
+    k.add_argument("-n", "--count", type=int, default=20)
+
+    args = parser.parse_args()
+    if args.command == "serve":
+        serve(args)
+    elif args.command == "keepalive":
+        keepalive(args)
+    else:
+        compare(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,115 @@
+// ============================================================================
+// verdict_parser_test.cpp - Host test: VerdictParser over chunked bodies
+// ============================================================================
+// Feeds backend response bodies through the same VerdictParser the firmware
+// uses, split into every chunk size from 1 to 7 bytes (HTTPClient hands
+// writeToStream whatever the TCP stack had), and checks the parsed fields.
+// Bodies cover reordered keys, pretty printing, decoy fields nested in
+// debug objects, over-long tokens and escapes, and a body large enough
+// that it would never have fit the old getString() path.
+//
+//   g++ -O2 -Itools/host -Isrc tools/verdict_parser_test.cpp src/verdict_parser.cpp -o verdict_parser_test
+//   ./verdict_parser_test
+#include "verdict_parser.h"
+#include <cmath>
+#include <string>
+
+struct Case {
+  const char* name;
+  std::string body;
+  bool complete;       // Parser reached the end of the top-level value
+  bool failed;         // Parser gave up on malformed input
+  bool hasVerdict;
+  bool isHoneyBadger;
+  bool hasConfidence;
+  float confidence;
+};
+
+static std::string largeBody() {
+  std::string body = "{\n  \"model\": \"badger-v3\",\n  \"detections\": [\n";
+  for (int i = 0; i < 400; i++) {
+    body += "    {\"label\": \"candidate_" + std::to_string(i) + "_with_a_label_longer_than_the_token_buffer\", ";
+    body += "\"isHoneyBadger\": false, \"confidence\": 0." + std::to_string(i % 10) + ", ";
+    body += "\"box\": [" + std::to_string(i) + ", 12, 64, 48]}";
+    body += i < 399 ? ",\n" : "\n";
+  }
+  body += "  ],\n  \"debug\": {\"note\": \"escaped \\\"quotes\\\" and \\\\ and \\u00e9\", \"isHoneyBadger\": false},\n";
+  body += "  \"confidence\": 0.8731,\n  \"isHoneyBadger\": true\n}\n";
+  return body;
+}
+
+static bool feed(const Case& test, size_t chunk, AnalysisResult& result, VerdictParser& parser, std::string& why) {
+  result = AnalysisResult();
+  parser.reset();
+
+  const uint8_t* bytes = (const uint8_t*)test.body.data();
+  for (size_t at = 0; at < test.body.size(); at += chunk) {
+    size_t n = min(chunk, test.body.size() - at);
+    if (n == 1) parser.write(bytes[at]);
+    else parser.write(bytes + at, n);
+  }
+
+  char detail[160];
+  if (parser.getBytesParsed() != test.body.size()) {
+    snprintf(detail, sizeof(detail), "parsed %zu of %zu bytes", parser.getBytesParsed(), test.body.size());
+  } else if (parser.isComplete() != test.complete || parser.hasError() != test.failed) {
+    snprintf(detail, sizeof(detail), "complete=%d error=%d, expected %d/%d",
+             parser.isComplete(), parser.hasError(), test.complete, test.failed);
+  } else if (parser.hasVerdict() != test.hasVerdict ||
+             (test.hasVerdict && result.isHoneyBadger != test.isHoneyBadger)) {
+    snprintf(detail, sizeof(detail), "verdict %d/%d, expected %d/%d",
+             parser.hasVerdict(), result.isHoneyBadger, test.hasVerdict, test.isHoneyBadger);
+  } else if (parser.hasConfidence() != test.hasConfidence ||
+             (test.hasConfidence && fabsf(result.confidence - test.confidence) > 1e-6f)) {
+    snprintf(detail, sizeof(detail), "confidence %d/%.6f, expected %d/%.6f",
+             parser.hasConfidence(), result.confidence, test.hasConfidence, test.confidence);
+  } else {
+    return true;
+  }
+  why = detail;
+  return false;
+}
+
+int main() {
+  const Case cases[] = {
+    {"compact", "{\"isHoneyBadger\":true,\"confidence\":0.93,\"processingTimeMs\":41}",
+     true, false, true, true, true, 0.93f},
+    {"reordered", "{\"model\":\"standin\",\"confidence\":0.12,\"processingTimeMs\":7,\"isHoneyBadger\":false}",
+     true, false, true, false, true, 0.12f},
+    {"pretty", "{\r\n\t\"confidence\" :\t9.5e-1 ,\r\n\t\"isHoneyBadger\" : true\r\n}\r\n",
+     true, false, true, true, true, 0.95f},
+    {"nested decoy", "{\"debug\":{\"isHoneyBadger\":true,\"confidence\":1.0},\"isHoneyBadger\":false,\"confidence\":0.2}",
+     true, false, true, false, true, 0.2f},
+    {"nested only", "{\"result\":{\"scores\":[1,2,[3]],\"isHoneyBadger\":true,\"confidence\":0.61}}",
+     true, false, true, true, true, 0.61f},
+    {"no verdict", "{\"error\":\"model not loaded\",\"code\":503}",
+     true, false, false, false, false, 0.0f},
+    {"string verdict", "{\"isHoneyBadger\":\"true\",\"confidence\":\"high\"}",
+     true, false, false, false, false, 0.0f},
+    {"truncated", "{\"isHoneyBadger\":true,\"confid",
+     false, false, true, true, false, 0.0f},
+    {"malformed", "{\"isHoneyBadger\" true}",
+     false, true, false, false, false, 0.0f},
+    {"large", largeBody(), true, false, true, true, true, 0.8731f},
+  };
+
+  AnalysisResult result;
+  VerdictParser parser(result);
+  int failures = 0;
+  int runs = 0;
+
+  for (const Case& test : cases) {
+    for (size_t chunk = 1; chunk <= 7; chunk++) {
+      std::string why;
+      runs++;
+      if (!feed(test, chunk, result, parser, why)) {
+        printf("FAIL %-15s chunk %zu: %s\n", test.name, chunk, why.c_str());
+        failures++;
+      }
+    }
+    printf("%-15s %7zu bytes\n", test.name, test.body.size());
+  }
+
+  printf("\n%d/%d runs passed\n", runs - failures, runs);
+  return failures ? 1 : 0;
+}